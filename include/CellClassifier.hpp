@@ -0,0 +1,28 @@
+#pragma once
+
+namespace MarchingCubes
+{
+    /**
+     * @brief Computes the marching cubes case index of a row of consecutive cells
+     * from the already sampled lattice, and lists the cells that the surface passes through.
+     *
+     * The four lattice rows hold the corner values along x for the four (y, z) combinations
+     * of a cell row, ordered the same way as the corner bits of the case index:
+     * rows[0] = (y, z), rows[1] = (y, z + 1), rows[2] = (y + 1, z), rows[3] = (y + 1, z + 1).
+     * Each row must contain numCells + 1 values.
+     *
+     * Uses AVX2 or SSE2 when supported by the CPU, and falls back to scalar code otherwise.
+     * @param[in] rows Lattice rows containing the cell corner values
+     * @param[in] numCells Number of cells in the row
+     * @param[out] outputCases Array where the numCells case indices will be placed
+     * @param[out] outputActiveCells Array where the indices of the cells with a case other than 0 or 255 will be placed
+     * @return Number of active cells
+     */
+    int ClassifyCellRow(const float* const rows[4], int numCells, unsigned char* outputCases, int* outputActiveCells);
+
+    /**
+     * @brief Gets the name of the instruction set used by ClassifyCellRow on this CPU
+     * @return Instruction set name
+     */
+    const char* GetCellClassifierName();
+}
@@ -0,0 +1,178 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace MarchingCubes
+{
+    /**
+     * Scratch buffers for TraceCellSurface, reused between cells
+     */
+    struct CellSurfaceTracerBuffers
+    {
+        /**
+         * Points of the face polygon being traced
+         */
+        std::vector<glm::ivec3> polygon;
+
+        /**
+         * Segments of the surface on the cell faces, as (from, to) vertex indices
+         */
+        std::vector<std::pair<uint32_t, uint32_t>> segments;
+
+        /**
+         * Vertex indices of the loop being triangulated
+         */
+        std::vector<uint32_t> loop;
+    };
+
+    /**
+     * @brief Triangulates the surface crossing a cube cell whose faces may be split into 4 quads,
+     * and whose edges may have a midpoint.
+     *
+     * The surface is traced across every face polygon with the same rule as the regular cell
+     * tables: every run of positive points along the polygon is cut off by one segment, which
+     * separates the positive corners on ambiguous faces. The segments chain into closed loops,
+     * which are triangulated as fans. Cells sharing a face polygon trace the same segments on it,
+     * so the result is crack-free as long as neighboring cells agree on the split faces and midpoints.
+     * @param[in] cellMin Minimum corner of the cell
+     * @param[in] halfSize Half of the cell size, in the same units as cellMin
+     * @param[in] splitFaces Faces split into 4 quads, as bits (axis * 2, plus 1 for the positive side)
+     * @param[in] isMidpointUsed Callable taking the local point (0 to 2 along each axis) of an edge midpoint,
+     *                           and returning whether the edge is split there
+     * @param[in] getValue Callable taking a point and returning the sample there
+     * @param[in] getEdgeVertex Callable taking the two points of an edge and returning the index of
+     *                          the vertex where the surface crosses it
+     * @param[in] buffers Scratch buffers
+     * @param[out] outputIndices Vector where the triangle vertex indices will be placed
+     */
+    template <typename MidpointFunc, typename ValueFunc, typename EdgeVertexFunc>
+    void TraceCellSurface(const glm::ivec3& cellMin, int halfSize, int splitFaces, const MidpointFunc& isMidpointUsed, const ValueFunc& getValue, EdgeVertexFunc& getEdgeVertex, CellSurfaceTracerBuffers& buffers, std::vector<uint32_t>& outputIndices)
+    {
+        // Points of the polygons, as (u, v) in half cells inside the face
+        static const int quadPoints[4][2] = { {0, 0}, {1, 0}, {1, 1}, {0, 1} };
+        static const int ringPoints[8][2] = { {0, 0}, {1, 0}, {2, 0}, {2, 1}, {2, 2}, {1, 2}, {0, 2}, {0, 1} };
+
+        std::vector<glm::ivec3>& polygon = buffers.polygon;
+        std::vector<std::pair<uint32_t, uint32_t>>& segments = buffers.segments;
+        std::vector<uint32_t>& loop = buffers.loop;
+
+        // The face polygons are wound counterclockwise seen from outside the cell,
+        // and every run of positive points is cut off by a segment going from its
+        // end to its start
+        segments.clear();
+        for (int face = 0; face < 6; ++face)
+        {
+            const int axis = face / 2;
+            const int axisU = (axis + 1) % 3;
+            const int axisV = (axis + 2) % 3;
+            const bool isPositive = (face & 1) != 0;
+            const bool isSplit = (splitFaces & (1 << face)) != 0;
+
+            for (int quad = 0; quad < (isSplit ? 4 : 1); ++quad)
+            {
+                polygon.clear();
+                for (int i = 0; i < (isSplit ? 4 : 8); ++i)
+                {
+                    glm::ivec3 localPoint;
+                    localPoint[axis] = isPositive ? 2 : 0;
+                    if (isSplit)
+                    {
+                        localPoint[axisU] = (quad & 1) + quadPoints[i][0];
+                        localPoint[axisV] = (quad >> 1) + quadPoints[i][1];
+                    }
+                    else
+                    {
+                        localPoint[axisU] = ringPoints[i][0];
+                        localPoint[axisV] = ringPoints[i][1];
+                        if (((i & 1) != 0) && !isMidpointUsed(localPoint))
+                        {
+                            continue;
+                        }
+                    }
+                    polygon.push_back(cellMin + localPoint * halfSize);
+                }
+
+                if (!isPositive)
+                {
+                    std::reverse(polygon.begin(), polygon.end());
+                }
+
+                // Find the first point following a negative one, so the runs do not wrap around
+                const size_t numPoints = polygon.size();
+                size_t start = numPoints;
+                for (size_t i = 0; i < numPoints; ++i)
+                {
+                    if ((getValue(polygon[i]) > 0.0f) && (getValue(polygon[(i + numPoints - 1) % numPoints]) <= 0.0f))
+                    {
+                        start = i;
+                        break;
+                    }
+                }
+                if (start == numPoints)
+                {
+                    continue;
+                }
+
+                uint32_t runStart = 0;
+                for (size_t i = 0; i < numPoints; ++i)
+                {
+                    const glm::ivec3& point = polygon[(start + i + numPoints - 1) % numPoints];
+                    const glm::ivec3& nextPoint = polygon[(start + i) % numPoints];
+                    const bool isInside = getValue(point) > 0.0f;
+                    const bool isNextInside = getValue(nextPoint) > 0.0f;
+                    if (!isInside && isNextInside)
+                    {
+                        runStart = getEdgeVertex(point, nextPoint);
+                    }
+                    else if (isInside && !isNextInside)
+                    {
+                        segments.push_back(std::make_pair(getEdgeVertex(point, nextPoint), runStart));
+                    }
+                }
+            }
+        }
+
+        // Every intersection starts exactly one segment and ends exactly
+        // one, so the segments form closed loops
+        while (!segments.empty())
+        {
+            loop.clear();
+            loop.push_back(segments.back().first);
+            uint32_t next = segments.back().second;
+            segments.pop_back();
+
+            while (next != loop.front())
+            {
+                loop.push_back(next);
+
+                size_t i = 0;
+                while ((i < segments.size()) && (segments[i].first != next))
+                {
+                    ++i;
+                }
+
+                // Only possible with NaN samples
+                if (i == segments.size())
+                {
+                    break;
+                }
+
+                next = segments[i].second;
+                segments[i] = segments.back();
+                segments.pop_back();
+            }
+
+            for (size_t i = 1; i + 1 < loop.size(); ++i)
+            {
+                outputIndices.push_back(loop[0]);
+                outputIndices.push_back(loop[i]);
+                outputIndices.push_back(loop[i + 1]);
+            }
+        }
+    }
+}
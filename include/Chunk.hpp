@@ -1,8 +1,9 @@
 #pragma once
 
 #include "Engine/Geometry/BoundingVolumes/AABB.hpp"
-#include "Engine/Graphics/Vertex.hpp"
+#include "Engine/Graphics/TerrainVertex.hpp"
 
+#include <glad/glad.h>
 #include <glm/glm.hpp>
 
 #include <vector>
@@ -13,7 +14,29 @@ struct Chunk
 
     AABB bounds;
 
-    std::vector<Vertex> meshVertices;
+    std::vector<TerrainVertex> meshVertices;
+
+    /**
+     * Origin of the quantized vertex positions
+     */
+    glm::vec3 meshOrigin;
+
+    std::vector<GLuint> meshIndices;
 
     bool isDone;
+
+    /**
+     * Level of detail. The chunk is meshed with the voxel size multiplied by 2^lod.
+     */
+    int lod;
+
+    /**
+     * Faces bordering a chunk with a finer level of detail, as MarchingCubes::TransitionFace flags
+     */
+    int transitionFaces;
+
+    /**
+     * Chunk being meshed with a new level of detail, which takes this chunk's place once done
+     */
+    Chunk* replacement;
 };
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <cstddef>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace MarchingCubes
+{
+    /**
+     * Thread-safe cache of values over grids of columns in the xz-plane.
+     *
+     * The lattices of chunks stacked on top of each other have the same columns, so the parts of
+     * a density that only depend on x and z can be evaluated once for all of them. The least
+     * recently used grids are evicted first.
+     */
+    class ColumnCache
+    {
+    public:
+        /**
+         * Function evaluating n columns at (xs[i], zs[i]), and placing the values in out
+         */
+        typedef std::function<void(const float* xs, const float* zs, float* out, size_t n)> EvaluateColumnsFunc;
+
+        /**
+         * @brief Constructor
+         * @param[in] maxNumGrids Number of grids kept before evicting the least recently used one
+         */
+        explicit ColumnCache(size_t maxNumGrids = 256);
+
+        ColumnCache(const ColumnCache&) = delete;
+        void operator=(const ColumnCache&) = delete;
+
+        /**
+         * @brief Gets the values at the columns origin + (x, z) * cellSize, evaluating them if the grid is not cached
+         * @param[in] origin Position of the first column
+         * @param[in] cellSize Distance between two columns
+         * @param[in] numColumns Number of columns along x and z
+         * @param[in] evaluateColumns Function evaluating the columns of a grid that is not cached
+         * @param[out] outputValues Vector where the numColumns.x * numColumns.y values will be placed, x varying fastest
+         */
+        void GetValues(const glm::vec2& origin, float cellSize, const glm::ivec2& numColumns, const EvaluateColumnsFunc& evaluateColumns, std::vector<float>& outputValues);
+
+        /**
+         * @brief Evicts all grids
+         */
+        void Clear();
+
+    private:
+        /**
+         * Grid of columns and its values
+         */
+        struct Grid
+        {
+            glm::vec2 origin;
+            float cellSize;
+            glm::ivec2 numColumns;
+            std::shared_ptr<const std::vector<float>> values;
+        };
+
+        /**
+         * @brief Finds a grid and moves it to the front of the list. The mutex must be locked.
+         * @return Values of the grid, or null if it is not cached
+         */
+        std::shared_ptr<const std::vector<float>> FindGrid(const glm::vec2& origin, float cellSize, const glm::ivec2& numColumns);
+
+        /**
+         * Cached grids, most recently used first
+         */
+        std::list<Grid> m_grids;
+
+        /**
+         * Number of grids kept before evicting the least recently used one
+         */
+        size_t m_maxNumGrids;
+
+        /**
+         * Mutex guarding the grids
+         */
+        std::mutex m_mutex;
+    };
+}
@@ -4,6 +4,7 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstddef>
 
 struct Cube
 {
@@ -31,6 +32,56 @@ struct Cube
         return radius - std::max(std::max(std::abs(x), std::abs(y)), std::abs(z));
     }
 
+    /**
+     * Returns the signed distance from the provided point to the surface.
+     * Allows the cube to be passed directly as a density function.
+     * @param[in] x X-value
+     * @param[in] y Y-value
+     * @param[in] z Z-value
+     * @return Signed distance from the provided point to the surface.
+     */
+    float operator()(float x, float y, float z)
+    {
+        return GetSignedDistnaceToSurface(x, y, z);
+    }
+
+    /**
+     * Returns the signed distances from the provided points to the surface.
+     * @param[in] xs X-values of the points
+     * @param[in] ys Y-values of the points
+     * @param[in] zs Z-values of the points
+     * @param[out] out Array where the n signed distances will be placed
+     * @param[in] n Number of points
+     */
+    void EvaluateBatch(const float* xs, const float* ys, const float* zs, float* out, size_t n)
+    {
+        for (size_t i = 0; i < n; ++i)
+        {
+            out[i] = GetSignedDistnaceToSurface(xs[i], ys[i], zs[i]);
+        }
+    }
+
+    /**
+     * Returns bounds of the signed distance over a box.
+     * The bounds are exact: the distance is a maximum of per-axis terms.
+     * @param[in] box Box
+     * @param[out] outputMin Minimum signed distance over the box
+     * @param[out] outputMax Maximum signed distance over the box
+     */
+    void GetDensityRange(const AABB& box, float& outputMin, float& outputMax)
+    {
+        float nearest = 0.0f;
+        float farthest = 0.0f;
+        for (size_t i = 0; i < 3; ++i)
+        {
+            const float nearestOffset = (box.min[i] > 0.0f) ? box.min[i] : ((box.max[i] < 0.0f) ? -box.max[i] : 0.0f);
+            nearest = std::max(nearest, nearestOffset);
+            farthest = std::max(farthest, std::max(std::abs(box.min[i]), std::abs(box.max[i])));
+        }
+        outputMin = radius - farthest;
+        outputMax = radius - nearest;
+    }
+
     /**
      * Gets the bounds of the cube
      * @param[out] bounds Bounds of the cube
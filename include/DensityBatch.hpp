@@ -0,0 +1,234 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace MarchingCubes
+{
+    /**
+     * Checks whether a density source provides the batch evaluation function
+     * void EvaluateBatch(const float* xs, const float* ys, const float* zs, float* out, size_t n)
+     */
+    template <typename DensitySource>
+    class HasEvaluateBatch
+    {
+    private:
+        template <typename T>
+        static auto Test(int) -> decltype(std::declval<T&>().EvaluateBatch(static_cast<const float*>(nullptr),
+                                                                          static_cast<const float*>(nullptr),
+                                                                          static_cast<const float*>(nullptr),
+                                                                          static_cast<float*>(nullptr),
+                                                                          static_cast<size_t>(0)), std::true_type());
+
+        template <typename T>
+        static std::false_type Test(...);
+
+    public:
+        static const bool value = decltype(Test<typename std::remove_reference<DensitySource>::type>(0))::value;
+    };
+
+    /**
+     * Checks whether a density source provides the sign-conservative batch evaluation function
+     * void EvaluateSignBatch(const float* xs, const float* ys, const float* zs, float* out, unsigned char* outputIsSignOnly, size_t n,
+     *                        float minIsovalue = 0.0f, float maxIsovalue = 0.0f)
+     * whose flagged densities are on the same side of every isovalue in [minIsovalue, maxIsovalue] as the exact ones
+     */
+    template <typename DensitySource>
+    class HasEvaluateSignBatch
+    {
+    private:
+        template <typename T>
+        static auto Test(int) -> decltype(std::declval<T&>().EvaluateSignBatch(static_cast<const float*>(nullptr),
+                                                                              static_cast<const float*>(nullptr),
+                                                                              static_cast<const float*>(nullptr),
+                                                                              static_cast<float*>(nullptr),
+                                                                              static_cast<unsigned char*>(nullptr),
+                                                                              static_cast<size_t>(0),
+                                                                              0.0f,
+                                                                              0.0f), std::true_type());
+
+        template <typename T>
+        static std::false_type Test(...);
+
+    public:
+        static const bool value = decltype(Test<typename std::remove_reference<DensitySource>::type>(0))::value;
+    };
+
+    /**
+     * Checks whether a density source has a part that is cheaper to evaluate over a whole lattice
+     * at once, like layers that only depend on x and z, or smooth layers interpolated from a coarser
+     * grid. Such sources provide the function
+     * void GetLatticePart(const glm::vec3& origin, float cellSize, const glm::ivec3& numSamples, std::vector<float>& outputValues)
+     * giving that part at the grid corners origin + (x, y, z) * cellSize, x varying fastest, and the overload
+     * void EvaluateBatch(const float* xs, const float* ys, const float* zs, const float* latticePart, float* out, size_t n)
+     * taking that part at each point instead of evaluating it. A source with only one of them is
+     * sampled as if it had neither. Its sign-conservative evaluation also takes that part if it
+     * provides HasLatticeSignBatch's overload.
+     */
+    template <typename DensitySource>
+    class HasLatticePart
+    {
+    private:
+        template <typename T>
+        static auto Test(int) -> decltype(std::declval<T&>().GetLatticePart(std::declval<const glm::vec3&>(),
+                                                                           0.0f,
+                                                                           std::declval<const glm::ivec3&>(),
+                                                                           std::declval<std::vector<float>&>()),
+                                          std::declval<T&>().EvaluateBatch(static_cast<const float*>(nullptr),
+                                                                          static_cast<const float*>(nullptr),
+                                                                          static_cast<const float*>(nullptr),
+                                                                          static_cast<const float*>(nullptr),
+                                                                          static_cast<float*>(nullptr),
+                                                                          static_cast<size_t>(0)), std::true_type());
+
+        template <typename T>
+        static std::false_type Test(...);
+
+    public:
+        static const bool value = decltype(Test<typename std::remove_reference<DensitySource>::type>(0))::value;
+    };
+
+    /**
+     * Checks whether a density source with a lattice part provides the sign-conservative batch evaluation function
+     * void EvaluateSignBatch(const float* xs, const float* ys, const float* zs, const float* latticePart, float* out, unsigned char* outputIsSignOnly, size_t n,
+     *                        float minIsovalue = 0.0f, float maxIsovalue = 0.0f)
+     * taking the part from GetLatticePart at each point, like its EvaluateBatch overload
+     */
+    template <typename DensitySource>
+    class HasLatticeSignBatch
+    {
+    private:
+        template <typename T>
+        static auto Test(int) -> decltype(std::declval<T&>().EvaluateSignBatch(static_cast<const float*>(nullptr),
+                                                                              static_cast<const float*>(nullptr),
+                                                                              static_cast<const float*>(nullptr),
+                                                                              static_cast<const float*>(nullptr),
+                                                                              static_cast<float*>(nullptr),
+                                                                              static_cast<unsigned char*>(nullptr),
+                                                                              static_cast<size_t>(0),
+                                                                              0.0f,
+                                                                              0.0f), std::true_type());
+
+        template <typename T>
+        static std::false_type Test(...);
+
+    public:
+        static const bool value = decltype(Test<typename std::remove_reference<DensitySource>::type>(0))::value;
+    };
+
+    /**
+     * Adapter that exposes a scalar density function taking (x, y, z)
+     * through the batch evaluation interface
+     */
+    template <typename DensityFunc>
+    struct ScalarDensityAdapter
+    {
+        /**
+         * Wrapped scalar density function
+         */
+        DensityFunc& func;
+
+        /**
+         * @brief Constructor
+         * @param[in] densityFunc Scalar density function to wrap
+         */
+        explicit ScalarDensityAdapter(DensityFunc& densityFunc)
+            : func(densityFunc)
+        {
+        }
+
+        /**
+         * @brief Evaluates the density function at n points
+         * @param[in] xs X-values of the points
+         * @param[in] ys Y-values of the points
+         * @param[in] zs Z-values of the points
+         * @param[out] out Array where the n densities will be placed
+         * @param[in] n Number of points
+         */
+        void EvaluateBatch(const float* xs, const float* ys, const float* zs, float* out, size_t n)
+        {
+            for (size_t i = 0; i < n; ++i)
+            {
+                out[i] = func(xs[i], ys[i], zs[i]);
+            }
+        }
+    };
+
+    /**
+     * @brief Evaluates the density source at n points, using its own EvaluateBatch
+     * function if it has one, or its scalar call operator otherwise.
+     * @param[in] densitySource Density source
+     * @param[in] xs X-values of the points
+     * @param[in] ys Y-values of the points
+     * @param[in] zs Z-values of the points
+     * @param[out] out Array where the n densities will be placed
+     * @param[in] n Number of points
+     */
+    template <typename DensitySource>
+    typename std::enable_if<HasEvaluateBatch<DensitySource>::value>::type
+    EvaluateDensityBatch(DensitySource& densitySource, const float* xs, const float* ys, const float* zs, float* out, size_t n)
+    {
+        densitySource.EvaluateBatch(xs, ys, zs, out, n);
+    }
+
+    /**
+     * @brief Evaluates the density source at n points, using its own EvaluateBatch
+     * function if it has one, or its scalar call operator otherwise.
+     * @param[in] densitySource Density source
+     * @param[in] xs X-values of the points
+     * @param[in] ys Y-values of the points
+     * @param[in] zs Z-values of the points
+     * @param[out] out Array where the n densities will be placed
+     * @param[in] n Number of points
+     */
+    template <typename DensitySource>
+    typename std::enable_if<!HasEvaluateBatch<DensitySource>::value>::type
+    EvaluateDensityBatch(DensitySource& densitySource, const float* xs, const float* ys, const float* zs, float* out, size_t n)
+    {
+        ScalarDensityAdapter<DensitySource>(densitySource).EvaluateBatch(xs, ys, zs, out, n);
+    }
+
+    /**
+     * @brief Evaluates the density source at n points, letting it only get the sign right far
+     * from the surface if it provides EvaluateSignBatch, and exactly otherwise.
+     * @param[in] densitySource Density source
+     * @param[in] xs X-values of the points
+     * @param[in] ys Y-values of the points
+     * @param[in] zs Z-values of the points
+     * @param[out] out Array where the n densities will be placed
+     * @param[out] outputIsSignOnly Array of n flags, set to 1 for the densities that only have the right sign, 0 otherwise
+     * @param[in] n Number of points
+     */
+    template <typename DensitySource>
+    typename std::enable_if<HasEvaluateSignBatch<DensitySource>::value>::type
+    EvaluateDensitySignBatch(DensitySource& densitySource, const float* xs, const float* ys, const float* zs, float* out, unsigned char* outputIsSignOnly, size_t n)
+    {
+        densitySource.EvaluateSignBatch(xs, ys, zs, out, outputIsSignOnly, n);
+    }
+
+    /**
+     * @brief Evaluates the density source at n points, letting it only get the sign right far
+     * from the surface if it provides EvaluateSignBatch, and exactly otherwise.
+     * @param[in] densitySource Density source
+     * @param[in] xs X-values of the points
+     * @param[in] ys Y-values of the points
+     * @param[in] zs Z-values of the points
+     * @param[out] out Array where the n densities will be placed
+     * @param[out] outputIsSignOnly Array of n flags, set to 1 for the densities that only have the right sign, 0 otherwise
+     * @param[in] n Number of points
+     */
+    template <typename DensitySource>
+    typename std::enable_if<!HasEvaluateSignBatch<DensitySource>::value>::type
+    EvaluateDensitySignBatch(DensitySource& densitySource, const float* xs, const float* ys, const float* zs, float* out, unsigned char* outputIsSignOnly, size_t n)
+    {
+        EvaluateDensityBatch(densitySource, xs, ys, zs, out, n);
+        for (size_t i = 0; i < n; ++i)
+        {
+            outputIsSignOnly[i] = 0;
+        }
+    }
+}
@@ -0,0 +1,117 @@
+#pragma once
+
+#include "Engine/Geometry/BoundingVolumes/AABB.hpp"
+
+#include <glm/glm.hpp>
+
+#include <cmath>
+#include <type_traits>
+#include <utility>
+
+namespace MarchingCubes
+{
+    /**
+     * Checks whether a density source provides the bound query function
+     * void GetDensityRange(const AABB& box, float& outputMin, float& outputMax),
+     * which gives bounds of the density over a whole box, from interval arithmetic
+     * or a Lipschitz constant.
+     */
+    template <typename DensitySource>
+    class HasDensityRange
+    {
+    private:
+        template <typename T>
+        static auto Test(int) -> decltype(std::declval<T&>().GetDensityRange(std::declval<const AABB&>(),
+                                                                            std::declval<float&>(),
+                                                                            std::declval<float&>()), std::true_type());
+
+        template <typename T>
+        static std::false_type Test(...);
+
+    public:
+        static const bool value = decltype(Test<typename std::remove_reference<DensitySource>::type>(0))::value;
+    };
+
+    /**
+     * @brief Checks whether the density source has the same sign over a whole box
+     *
+     * The box is provably empty if the density never gets above 0, and provably solid
+     * if it stays above 0, following the sign convention of the meshers.
+     * @param[in] densitySource Density source providing GetDensityRange
+     * @param[in] box Box to check
+     * @param[out] outputValue Value with the sign of the whole box, if it has one
+     * @return True if the density has the same sign over the whole box
+     */
+    template <typename DensitySource>
+    bool IsDensitySignConstant(DensitySource& densitySource, const AABB& box, float& outputValue)
+    {
+        float minValue, maxValue;
+        densitySource.GetDensityRange(box, minValue, maxValue);
+
+        if (minValue > 0.0f)
+        {
+            outputValue = minValue;
+            return true;
+        }
+        if (maxValue <= 0.0f)
+        {
+            outputValue = maxValue;
+            return true;
+        }
+        return false;
+    }
+
+    /**
+     * @brief Checks whether the density source has the same sign over a whole box, splitting it
+     * into numDivisions^3 sub-boxes
+     *
+     * The bounds over smaller boxes are tighter, so this proves more boxes empty or solid than a single
+     * query, at the cost of up to numDivisions^3 queries. It stops at the first sub-box without a
+     * constant sign, or with the opposite sign of the previous ones.
+     * @param[in] densitySource Density source providing GetDensityRange
+     * @param[in] box Box to check
+     * @param[in] numDivisions Number of sub-boxes along each axis, a value below 1 queries the whole box once
+     * @param[out] outputValue Value with the sign of the whole box, if it has one
+     * @return True if the density has the same sign over the whole box
+     */
+    template <typename DensitySource>
+    bool IsDensitySignConstant(DensitySource& densitySource, const AABB& box, int numDivisions, float& outputValue)
+    {
+        if (numDivisions <= 1)
+        {
+            return IsDensitySignConstant(densitySource, box, outputValue);
+        }
+
+        const glm::vec3 subBoxSize = (box.max - box.min) / static_cast<float>(numDivisions);
+
+        for (int i = 0; i < numDivisions * numDivisions * numDivisions; ++i)
+        {
+            const glm::ivec3 subBoxIndex(i % numDivisions, (i / numDivisions) % numDivisions, i / (numDivisions * numDivisions));
+
+            AABB subBox;
+            subBox.min = box.min + glm::vec3(subBoxIndex) * subBoxSize;
+            subBox.max = box.min + glm::vec3(subBoxIndex + 1) * subBoxSize;
+
+            float value;
+            if (!IsDensitySignConstant(densitySource, subBox, value))
+            {
+                return false;
+            }
+
+            // Keep the value closest to 0, like a single query over the whole box would
+            if (i == 0)
+            {
+                outputValue = value;
+            }
+            else if ((value > 0.0f) != (outputValue > 0.0f))
+            {
+                return false;
+            }
+            else if (std::fabs(value) < std::fabs(outputValue))
+            {
+                outputValue = value;
+            }
+        }
+        return true;
+    }
+}
@@ -0,0 +1,180 @@
+#pragma once
+
+#include "Engine/Geometry/BoundingVolumes/AABB.hpp"
+
+#include "DensityBatch.hpp"
+#include "MarchingCubes.hpp"
+#include "Triangle.hpp"
+
+#include <glm/glm.hpp>
+
+#include <cstdint>
+#include <vector>
+
+namespace MarchingCubes
+{
+    /**
+     * Dual Contouring isosurface extraction.
+     *
+     * Connects one vertex per cell crossed by the surface with quads, like SurfaceNets,
+     * but places every vertex by minimizing the quadratic error function (QEF) of the
+     * planes given by the Hermite data of its cell: the edge intersections and the normals
+     * of the function there. Vertices snap to the edges and corners where those planes meet,
+     * so sharp features are kept at coarser resolutions than with marching cubes.
+     *
+     * The normals are taken by forward differences of the function, sampled in one batch
+     * after the lattice.
+     */
+    class DualContouring
+    {
+    public:
+        /**
+         * @brief Gets the resulting mesh upon performing dual contouring
+         * @param[in] signedDistanceFunc Signed distance function
+         * @param[in] bounds Shape bounds
+         * @param[in] cellSize Cell size
+         * @param[out] outputTriangles Vector where the triangles will be placed
+         */
+        template <typename DensityFunc>
+        static void GetMesh(DensityFunc&& signedDistanceFunc, const AABB& bounds, float cellSize, std::vector<Triangle>& outputTriangles);
+
+        /**
+         * @brief Gets the resulting indexed mesh upon performing dual contouring
+         * @param[in] signedDistanceFunc Signed distance function
+         * @param[in] bounds Shape bounds
+         * @param[in] cellSize Cell size
+         * @param[out] outputVertices Vector where the vertex positions will be placed
+         * @param[out] outputIndices Vector where the triangle vertex indices will be placed
+         */
+        template <typename DensityFunc>
+        static void GetIndexedMesh(DensityFunc&& signedDistanceFunc, const AABB& bounds, float cellSize, std::vector<glm::vec3>& outputVertices, std::vector<uint32_t>& outputIndices);
+
+    private:
+        /**
+         * Intersection of the surface with a lattice edge. It is kept relative to the start of its edge, so that
+         * chunks sharing the edge compute the same Hermite data from the same numbers.
+         */
+        struct EdgeIntersection
+        {
+            /**
+             * Lattice point at the start of the edge, in cells from the lattice origin
+             */
+            glm::ivec3 point;
+
+            /**
+             * Axis of the edge
+             */
+            int axis;
+
+            /**
+             * Position along the edge, from 0 at its start to 1 at its end
+             */
+            float t;
+        };
+
+        /**
+         * @brief Finds the intersections of the surface with the lattice edges
+         * @param[in] lattice Sampled lattice of numCells + 1 cells, starting one cell before the bounds, x varying fastest
+         * @param[in] numCells Number of cells of the bounds along each axis
+         * @param[out] outputEdgeIntersections Index in outputIntersections of the intersection on every edge, or -1,
+         *                                     as 3 edges (x, y, z) per lattice point
+         * @param[out] outputIntersections Vector where the intersections will be placed
+         */
+        static void GetEdgeIntersections(const std::vector<float>& lattice, const glm::ivec3& numCells, std::vector<int>& outputEdgeIntersections, std::vector<EdgeIntersection>& outputIntersections);
+
+        /**
+         * @brief Places the cell vertices and connects them
+         * @param[in] lattice Sampled lattice of numCells + 1 cells, starting one cell before the bounds, x varying fastest
+         * @param[in] origin Position of the first grid corner of the lattice
+         * @param[in] cellSize Cell size
+         * @param[in] numCells Number of cells of the bounds along each axis
+         * @param[in] edgeIntersections Index of the intersection on every edge, from GetEdgeIntersections
+         * @param[in] intersections Intersections, from GetEdgeIntersections
+         * @param[in] normals Unit normals of the function at the intersections
+         * @param[out] outputVertices Vector where the vertex positions will be placed
+         * @param[out] outputIndices Vector where the triangle vertex indices will be placed
+         */
+        static void Polygonize(const std::vector<float>& lattice, const glm::vec3& origin, float cellSize, const glm::ivec3& numCells, const std::vector<int>& edgeIntersections, const std::vector<EdgeIntersection>& intersections, const std::vector<glm::vec3>& normals, std::vector<glm::vec3>& outputVertices, std::vector<uint32_t>& outputIndices);
+    };
+
+    /**
+     * @brief Gets the resulting mesh upon performing dual contouring
+     * @param[in] signedDistanceFunc Signed distance function
+     * @param[in] bounds Shape bounds
+     * @param[in] cellSize Cell size
+     * @param[out] outputTriangles Vector where the triangles will be placed
+     */
+    template <typename DensityFunc>
+    void DualContouring::GetMesh(DensityFunc&& signedDistanceFunc, const AABB& bounds, float cellSize, std::vector<Triangle>& outputTriangles)
+    {
+        std::vector<glm::vec3> vertices;
+        std::vector<uint32_t> indices;
+        GetIndexedMesh(signedDistanceFunc, bounds, cellSize, vertices, indices);
+
+        const size_t firstTriangle = outputTriangles.size();
+        outputTriangles.resize(firstTriangle + indices.size() / 3);
+        for (size_t i = 0; i < indices.size() / 3; ++i)
+        {
+            for (int j = 0; j < 3; ++j)
+            {
+                outputTriangles[firstTriangle + i].vertices[j] = vertices[indices[i * 3 + j]];
+            }
+        }
+    }
+
+    /**
+     * @brief Gets the resulting indexed mesh upon performing dual contouring
+     * @param[in] signedDistanceFunc Signed distance function
+     * @param[in] bounds Shape bounds
+     * @param[in] cellSize Cell size
+     * @param[out] outputVertices Vector where the vertex positions will be placed
+     * @param[out] outputIndices Vector where the triangle vertex indices will be placed
+     */
+    template <typename DensityFunc>
+    void DualContouring::GetIndexedMesh(DensityFunc&& signedDistanceFunc, const AABB& bounds, float cellSize, std::vector<glm::vec3>& outputVertices, std::vector<uint32_t>& outputIndices)
+    {
+        glm::ivec3 numCells = MarchingCubes::GetCellCount(bounds, cellSize);
+        if ((numCells.x <= 0) || (numCells.y <= 0) || (numCells.z <= 0))
+        {
+            return;
+        }
+
+        // The quads of the edges on the minimum faces use the cells just outside the bounds
+        const glm::vec3 origin = bounds.min - glm::vec3(cellSize);
+        std::vector<float> lattice;
+        MarchingCubes::SampleLattice(signedDistanceFunc, origin, cellSize, numCells + 1, lattice);
+
+        std::vector<int> edgeIntersections;
+        std::vector<EdgeIntersection> intersections;
+        GetEdgeIntersections(lattice, numCells, edgeIntersections, intersections);
+
+        // Sample every intersection and its 3 forward neighbors in one batch. The positions start
+        // from the exact edge start, like the lattice samples, so that they do not depend on the origin.
+        const float step = cellSize * 0.01f;
+        const size_t numSamples = intersections.size() * 4;
+        std::vector<float> xs(numSamples), ys(numSamples), zs(numSamples), values(numSamples);
+        for (size_t i = 0; i < intersections.size(); ++i)
+        {
+            glm::vec3 position = origin + glm::vec3(intersections[i].point) * cellSize;
+            position[intersections[i].axis] += intersections[i].t * cellSize;
+            for (int j = 0; j < 4; ++j)
+            {
+                xs[i * 4 + j] = position.x + ((j == 1) ? step : 0.0f);
+                ys[i * 4 + j] = position.y + ((j == 2) ? step : 0.0f);
+                zs[i * 4 + j] = position.z + ((j == 3) ? step : 0.0f);
+            }
+        }
+        EvaluateDensityBatch(signedDistanceFunc, xs.data(), ys.data(), zs.data(), values.data(), numSamples);
+
+        std::vector<glm::vec3> normals(intersections.size());
+        for (size_t i = 0; i < intersections.size(); ++i)
+        {
+            const float* sample = &values[i * 4];
+            const glm::vec3 normal = -glm::vec3(sample[1] - sample[0], sample[2] - sample[0], sample[3] - sample[0]);
+            const float length = glm::length(normal);
+            normals[i] = (length > 0.0f) ? (normal / length) : glm::vec3(0.0f);
+        }
+
+        Polygonize(lattice, origin, cellSize, numCells, edgeIntersections, intersections, normals, outputVertices, outputIndices);
+    }
+}
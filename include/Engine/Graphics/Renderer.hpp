@@ -1,5 +1,6 @@
 #pragma once
 
+#include "TerrainVertex.hpp"
 #include "Vertex.hpp"
 
 #include <glad/glad.h>
@@ -29,6 +30,11 @@ private:
      */
     GLuint m_ebo;
 
+    /**
+     * VAO reading the VBO as terrain vertices
+     */
+    GLuint m_terrainVao;
+
     /**
      * Maximum number of vertices
      */
@@ -74,6 +80,20 @@ public:
      */
     void DrawTriangles(const std::vector<Vertex>& vertices);
 
+    /**
+     * @brief Draw the provided indexed vertices as triangles
+     * @param[in] vertices Vertex list
+     * @param[in] indices Vertex index list, 3 per triangle
+     */
+    void DrawTriangles(const std::vector<Vertex>& vertices, const std::vector<GLuint>& indices);
+
+    /**
+     * @brief Draw the provided indexed terrain vertices as triangles
+     * @param[in] vertices Terrain vertex list
+     * @param[in] indices Vertex index list, 3 per triangle
+     */
+    void DrawTriangles(const std::vector<TerrainVertex>& vertices, const std::vector<GLuint>& indices);
+
     /**
      * @brief Draw the provided vertices as a triangle fan
      * @param[in] vertices Vertex list
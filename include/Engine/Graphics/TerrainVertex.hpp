@@ -0,0 +1,103 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+/**
+ * Compact vertex data for terrain meshes, 12 bytes instead of the 48 bytes of Vertex.
+ *
+ * Positions are quantized to 16 bits from an origin, with a power-of-two step. Meshes sharing
+ * the step and with origins on multiples of it round their common border vertices the same way.
+ * Normals are octahedral-encoded into 2 signed 16-bit values.
+ */
+struct TerrainVertex
+{
+    /**
+     * Position, in steps from the origin
+     */
+    uint16_t position[3];
+
+    /**
+     * Padding, so that the normal is 4-byte aligned
+     */
+    uint16_t padding;
+
+    /**
+     * Octahedral-encoded unit normal, with 32767 standing for 1
+     */
+    int16_t normal[2];
+
+    /**
+     * @brief Gets the smallest power-of-two quantization step covering a range of positions
+     * @param[in] range Largest distance of a position from the origin along any axis
+     * @return Quantization step
+     */
+    static float GetPositionStep(float range)
+    {
+        return std::exp2(std::ceil(std::log2(range / 65535.0f)));
+    }
+
+    /**
+     * @brief Sets the quantized position
+     * @param[in] value Position
+     * @param[in] origin Origin of the quantized positions
+     * @param[in] step Quantization step
+     */
+    void SetPosition(const glm::vec3& value, const glm::vec3& origin, float step)
+    {
+        const glm::vec3 steps = glm::clamp(glm::round((value - origin) / step), 0.0f, 65535.0f);
+        for (int i = 0; i < 3; ++i)
+        {
+            position[i] = static_cast<uint16_t>(steps[i]);
+        }
+        padding = 0;
+    }
+
+    /**
+     * @brief Gets the position, as decoded by the terrain vertex shader
+     * @param[in] origin Origin of the quantized positions
+     * @param[in] step Quantization step
+     * @return Position
+     */
+    glm::vec3 GetPosition(const glm::vec3& origin, float step) const
+    {
+        return origin + glm::vec3(position[0], position[1], position[2]) * step;
+    }
+
+    /**
+     * @brief Sets the encoded normal
+     * @param[in] value Unit normal. A zero vector is encoded as +z.
+     */
+    void SetNormal(const glm::vec3& value)
+    {
+        // Project onto the octahedron, and fold its lower half over the upper one
+        const float sum = std::abs(value.x) + std::abs(value.y) + std::abs(value.z);
+        glm::vec2 encoded = (sum > 0.0f) ? (glm::vec2(value.x, value.y) / sum) : glm::vec2(0.0f);
+        if (value.z < 0.0f)
+        {
+            encoded = (1.0f - glm::abs(glm::vec2(encoded.y, encoded.x))) * glm::vec2(encoded.x >= 0.0f ? 1.0f : -1.0f, encoded.y >= 0.0f ? 1.0f : -1.0f);
+        }
+
+        for (int i = 0; i < 2; ++i)
+        {
+            normal[i] = static_cast<int16_t>(std::round(glm::clamp(encoded[i], -1.0f, 1.0f) * 32767.0f));
+        }
+    }
+
+    /**
+     * @brief Gets the normal, as decoded by the terrain vertex shader
+     * @return Unit normal
+     */
+    glm::vec3 GetNormal() const
+    {
+        const glm::vec2 encoded = glm::vec2(normal[0], normal[1]) / 32767.0f;
+        glm::vec3 value(encoded.x, encoded.y, 1.0f - std::abs(encoded.x) - std::abs(encoded.y));
+        const float fold = std::max(-value.z, 0.0f);
+        value.x += (value.x >= 0.0f) ? -fold : fold;
+        value.y += (value.y >= 0.0f) ? -fold : fold;
+        return glm::normalize(value);
+    }
+};
@@ -24,6 +24,8 @@ public:
 
 		A = GLFW_KEY_A,
 		D = GLFW_KEY_D,
+		M = GLFW_KEY_M,
+		N = GLFW_KEY_N,
 		R = GLFW_KEY_R,
 		S = GLFW_KEY_S,
 		W = GLFW_KEY_W,
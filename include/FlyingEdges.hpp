@@ -0,0 +1,122 @@
+#pragma once
+
+#include "Engine/Geometry/BoundingVolumes/AABB.hpp"
+
+#include "MarchingCubes.hpp"
+#include "ParallelFor.hpp"
+#include "Triangle.hpp"
+
+#include <glm/glm.hpp>
+
+#include <cstdint>
+#include <vector>
+
+namespace MarchingCubes
+{
+    /**
+     * Flying Edges isosurface extraction.
+     *
+     * Produces the same triangulation as MarchingCubes (it uses the same case tables),
+     * but processes the volume as independent rows of cells in several passes:
+     * classification, which lists the cells crossed by the surface and counts the edges
+     * they intersect, prefix-sum allocation, and generation over the listed cells only.
+     * The passes run in parallel over z-slabs, and every edge intersection is computed
+     * exactly once, which makes it well suited for large single volumes.
+     *
+     * The density function is called from several threads at once.
+     */
+    class FlyingEdges
+    {
+    public:
+        /**
+         * @brief Gets the resulting mesh upon performing flying edges
+         * @param[in] signedDistanceFunc Signed distance function
+         * @param[in] bounds Shape bounds
+         * @param[in] cellSize Cell size
+         * @param[out] outputTriangles Vector where the triangles will be placed
+         * @param[in] numThreads Number of threads to use
+         */
+        template <typename DensityFunc>
+        static void GetMesh(DensityFunc&& signedDistanceFunc, const AABB& bounds, float cellSize, std::vector<Triangle>& outputTriangles, int numThreads = GetDefaultThreadCount());
+
+        /**
+         * @brief Gets the resulting indexed mesh upon performing flying edges
+         * @param[in] signedDistanceFunc Signed distance function
+         * @param[in] bounds Shape bounds
+         * @param[in] cellSize Cell size
+         * @param[out] outputVertices Vector where the vertex positions will be placed
+         * @param[out] outputIndices Vector where the triangle vertex indices will be placed
+         * @param[in] numThreads Number of threads to use
+         */
+        template <typename DensityFunc>
+        static void GetIndexedMesh(DensityFunc&& signedDistanceFunc, const AABB& bounds, float cellSize, std::vector<glm::vec3>& outputVertices, std::vector<uint32_t>& outputIndices, int numThreads = GetDefaultThreadCount());
+
+    private:
+        /**
+         * @brief Extracts the isosurface from an already sampled lattice
+         * @param[in] lattice Sampled lattice, x varying fastest
+         * @param[in] origin Position of the first grid corner
+         * @param[in] cellSize Cell size
+         * @param[in] numCells Number of cells along each axis
+         * @param[in] numThreads Number of threads to use
+         * @param[out] outputVertices Vector where the vertex positions will be placed
+         * @param[out] outputIndices Vector where the triangle vertex indices will be placed
+         */
+        static void Polygonize(const std::vector<float>& lattice, const glm::vec3& origin, float cellSize, const glm::ivec3& numCells, int numThreads, std::vector<glm::vec3>& outputVertices, std::vector<uint32_t>& outputIndices);
+    };
+
+    /**
+     * @brief Gets the resulting mesh upon performing flying edges
+     * @param[in] signedDistanceFunc Signed distance function
+     * @param[in] bounds Shape bounds
+     * @param[in] cellSize Cell size
+     * @param[out] outputTriangles Vector where the triangles will be placed
+     * @param[in] numThreads Number of threads to use
+     */
+    template <typename DensityFunc>
+    void FlyingEdges::GetMesh(DensityFunc&& signedDistanceFunc, const AABB& bounds, float cellSize, std::vector<Triangle>& outputTriangles, int numThreads)
+    {
+        std::vector<glm::vec3> vertices;
+        std::vector<uint32_t> indices;
+        GetIndexedMesh(signedDistanceFunc, bounds, cellSize, vertices, indices, numThreads);
+
+        const size_t firstTriangle = outputTriangles.size();
+        outputTriangles.resize(firstTriangle + indices.size() / 3);
+
+        Triangle* triangles = outputTriangles.data() + firstTriangle;
+        ParallelFor(0, static_cast<int>(indices.size() / 3), numThreads, [&](int begin, int end)
+        {
+            for (int i = begin; i < end; ++i)
+            {
+                for (int j = 0; j < 3; ++j)
+                {
+                    triangles[i].vertices[j] = vertices[indices[i * 3 + j]];
+                }
+            }
+        });
+    }
+
+    /**
+     * @brief Gets the resulting indexed mesh upon performing flying edges
+     * @param[in] signedDistanceFunc Signed distance function
+     * @param[in] bounds Shape bounds
+     * @param[in] cellSize Cell size
+     * @param[out] outputVertices Vector where the vertex positions will be placed
+     * @param[out] outputIndices Vector where the triangle vertex indices will be placed
+     * @param[in] numThreads Number of threads to use
+     */
+    template <typename DensityFunc>
+    void FlyingEdges::GetIndexedMesh(DensityFunc&& signedDistanceFunc, const AABB& bounds, float cellSize, std::vector<glm::vec3>& outputVertices, std::vector<uint32_t>& outputIndices, int numThreads)
+    {
+        glm::ivec3 numCells = MarchingCubes::GetCellCount(bounds, cellSize);
+        if ((numCells.x <= 0) || (numCells.y <= 0) || (numCells.z <= 0))
+        {
+            return;
+        }
+
+        std::vector<float> lattice;
+        MarchingCubes::SampleLattice(signedDistanceFunc, bounds.min, cellSize, numCells, lattice, numThreads);
+
+        Polygonize(lattice, bounds.min, cellSize, numCells, numThreads, outputVertices, outputIndices);
+    }
+}
@@ -0,0 +1,509 @@
+#pragma once
+
+#include "Engine/Geometry/BoundingVolumes/AABB.hpp"
+
+#include "DensityBatch.hpp"
+#include "DensityBounds.hpp"
+
+#include <glm/glm.hpp>
+
+#include <algorithm>
+#include <type_traits>
+#include <vector>
+
+namespace MarchingCubes
+{
+    /**
+     * @brief Evaluates the density source at n points, exactly if no flags are requested, or
+     * only getting the sign right far from the surface if the source supports it otherwise
+     * @param[in] densityFunc Density function or batch density source
+     * @param[in] xs X-values of the points
+     * @param[in] ys Y-values of the points
+     * @param[in] zs Z-values of the points
+     * @param[out] outputValues Array where the n densities will be placed
+     * @param[out] outputIsSignOnly Null, or array of n flags, set to 1 for the densities that only have the right sign
+     * @param[in] n Number of points
+     */
+    template <typename DensityFunc>
+    void EvaluateLatticeBatch(DensityFunc& densityFunc, const float* xs, const float* ys, const float* zs, float* outputValues, unsigned char* outputIsSignOnly, size_t n)
+    {
+        if (outputIsSignOnly != nullptr)
+        {
+            EvaluateDensitySignBatch(densityFunc, xs, ys, zs, outputValues, outputIsSignOnly, n);
+        }
+        else
+        {
+            EvaluateDensityBatch(densityFunc, xs, ys, zs, outputValues, n);
+        }
+    }
+
+    /**
+     * @brief Gets the part of the density source that is evaluated over the whole lattice at once, if it has one
+     * @param[in] densityFunc Density source providing GetLatticePart
+     * @param[in] origin Position of the first grid corner
+     * @param[in] cellSize Cell size
+     * @param[in] numSamples Number of grid corners along each axis
+     * @param[out] outputValues Vector where the values at the grid corners will be placed, x varying fastest
+     */
+    template <typename DensityFunc>
+    typename std::enable_if<HasLatticePart<DensityFunc>::value>::type
+    GetLatticePart(DensityFunc& densityFunc, const glm::vec3& origin, float cellSize, const glm::ivec3& numSamples, std::vector<float>& outputValues)
+    {
+        densityFunc.GetLatticePart(origin, cellSize, numSamples, outputValues);
+    }
+
+    /**
+     * @brief Gets the part of the density source that is evaluated over the whole lattice at once, if it has one
+     * @param[in] densityFunc Density function or batch density source
+     * @param[in] origin Position of the first grid corner
+     * @param[in] cellSize Cell size
+     * @param[in] numSamples Number of grid corners along each axis
+     * @param[out] outputValues Vector left empty, as the density has no such part
+     */
+    template <typename DensityFunc>
+    typename std::enable_if<!HasLatticePart<DensityFunc>::value>::type
+    GetLatticePart(DensityFunc& densityFunc, const glm::vec3& origin, float cellSize, const glm::ivec3& numSamples, std::vector<float>& outputValues)
+    {
+        outputValues.clear();
+    }
+
+    /**
+     * @brief Evaluates the density source at n points of a lattice, only getting the sign right far from the surface
+     * @param[in] densityFunc Density source providing GetLatticePart and the EvaluateSignBatch overload taking its part
+     * @param[in] xs X-values of the points
+     * @param[in] ys Y-values of the points
+     * @param[in] zs Z-values of the points
+     * @param[in] latticePart Part of the density from GetLatticePart at each point
+     * @param[out] outputValues Array where the n densities will be placed
+     * @param[out] outputIsSignOnly Array of n flags, set to 1 for the densities that only have the right sign
+     * @param[in] n Number of points
+     */
+    template <typename DensityFunc>
+    typename std::enable_if<HasLatticeSignBatch<DensityFunc>::value>::type
+    EvaluateLatticeSignBatch(DensityFunc& densityFunc, const float* xs, const float* ys, const float* zs, const float* latticePart, float* outputValues, unsigned char* outputIsSignOnly, size_t n)
+    {
+        densityFunc.EvaluateSignBatch(xs, ys, zs, latticePart, outputValues, outputIsSignOnly, n);
+    }
+
+    /**
+     * @brief Evaluates the density source at n points of a lattice exactly, as it cannot take its
+     * part from GetLatticePart when only getting the sign right
+     * @param[in] densityFunc Density source providing GetLatticePart
+     * @param[in] xs X-values of the points
+     * @param[in] ys Y-values of the points
+     * @param[in] zs Z-values of the points
+     * @param[in] latticePart Part of the density from GetLatticePart at each point
+     * @param[out] outputValues Array where the n densities will be placed
+     * @param[out] outputIsSignOnly Array of n flags, all set to 0
+     * @param[in] n Number of points
+     */
+    template <typename DensityFunc>
+    typename std::enable_if<!HasLatticeSignBatch<DensityFunc>::value>::type
+    EvaluateLatticeSignBatch(DensityFunc& densityFunc, const float* xs, const float* ys, const float* zs, const float* latticePart, float* outputValues, unsigned char* outputIsSignOnly, size_t n)
+    {
+        densityFunc.EvaluateBatch(xs, ys, zs, latticePart, outputValues, n);
+        std::fill(outputIsSignOnly, outputIsSignOnly + n, 0);
+    }
+
+    /**
+     * @brief Evaluates the density source at n points, exactly if no flags are requested, or
+     * only getting the sign right far from the surface if the source supports it otherwise
+     * @param[in] densityFunc Density source providing GetLatticePart
+     * @param[in] xs X-values of the points
+     * @param[in] ys Y-values of the points
+     * @param[in] zs Z-values of the points
+     * @param[in] latticePart Null, or part of the density from GetLatticePart at each point
+     * @param[out] outputValues Array where the n densities will be placed
+     * @param[out] outputIsSignOnly Null, or array of n flags, set to 1 for the densities that only have the right sign
+     * @param[in] n Number of points
+     */
+    template <typename DensityFunc>
+    typename std::enable_if<HasLatticePart<DensityFunc>::value>::type
+    EvaluateLatticeBatch(DensityFunc& densityFunc, const float* xs, const float* ys, const float* zs, const float* latticePart, float* outputValues, unsigned char* outputIsSignOnly, size_t n)
+    {
+        if (latticePart == nullptr)
+        {
+            EvaluateLatticeBatch(densityFunc, xs, ys, zs, outputValues, outputIsSignOnly, n);
+        }
+        else if (outputIsSignOnly != nullptr)
+        {
+            EvaluateLatticeSignBatch(densityFunc, xs, ys, zs, latticePart, outputValues, outputIsSignOnly, n);
+        }
+        else
+        {
+            densityFunc.EvaluateBatch(xs, ys, zs, latticePart, outputValues, n);
+        }
+    }
+
+    /**
+     * @brief Evaluates the density source at n points, exactly if no flags are requested, or
+     * only getting the sign right far from the surface if the source supports it otherwise
+     * @param[in] densityFunc Density function or batch density source
+     * @param[in] xs X-values of the points
+     * @param[in] ys Y-values of the points
+     * @param[in] zs Z-values of the points
+     * @param[in] latticePart Null, as the density has no such part
+     * @param[out] outputValues Array where the n densities will be placed
+     * @param[out] outputIsSignOnly Null, or array of n flags, set to 1 for the densities that only have the right sign
+     * @param[in] n Number of points
+     */
+    template <typename DensityFunc>
+    typename std::enable_if<!HasLatticePart<DensityFunc>::value>::type
+    EvaluateLatticeBatch(DensityFunc& densityFunc, const float* xs, const float* ys, const float* zs, const float* latticePart, float* outputValues, unsigned char* outputIsSignOnly, size_t n)
+    {
+        EvaluateLatticeBatch(densityFunc, xs, ys, zs, outputValues, outputIsSignOnly, n);
+    }
+
+    /**
+     * @brief Samples the provided function at the grid corners of the z-slabs [zBegin, zEnd)
+     * @param[in] densityFunc Density function or batch density source
+     * @param[in] origin Position of the first grid corner
+     * @param[in] cellSize Cell size
+     * @param[in] numSamples Number of grid corners along each axis
+     * @param[in] latticePart Null, or part of the density at the grid corners, from GetLatticePart
+     * @param[in] zBegin Index of the first z-slab to sample
+     * @param[in] zEnd One past the index of the last z-slab to sample
+     * @param[out] outputValues Lattice where the samples will be placed, x varying fastest
+     * @param[out] outputIsSignOnly Null for exact samples, or lattice of flags, set to 1 for the samples that only have the right sign
+     */
+    template <typename DensityFunc>
+    void SampleLatticeSlabs(DensityFunc& densityFunc, const glm::vec3& origin, float cellSize, const glm::ivec3& numSamples, const float* latticePart, int zBegin, int zEnd, float* outputValues, unsigned char* outputIsSignOnly = nullptr)
+    {
+        const size_t slabSize = static_cast<size_t>(numSamples.x) * numSamples.y;
+
+        // The function is evaluated one z-slab at a time through the batch
+        // interface. Only the z-coordinates change between slabs.
+        std::vector<float> xs(slabSize);
+        std::vector<float> ys(slabSize);
+        std::vector<float> zs(slabSize);
+
+        size_t sampleIndex = 0;
+        for (int y = 0; y < numSamples.y; ++y)
+        {
+            const float sampleY = origin.y + y * cellSize;
+            for (int x = 0; x < numSamples.x; ++x)
+            {
+                xs[sampleIndex] = origin.x + x * cellSize;
+                ys[sampleIndex] = sampleY;
+                ++sampleIndex;
+            }
+        }
+
+        for (int z = zBegin; z < zEnd; ++z)
+        {
+            std::fill(zs.begin(), zs.end(), origin.z + z * cellSize);
+            EvaluateLatticeBatch(densityFunc, xs.data(), ys.data(), zs.data(), (latticePart != nullptr) ? latticePart + slabSize * z : nullptr, outputValues + slabSize * z, (outputIsSignOnly != nullptr) ? outputIsSignOnly + slabSize * z : nullptr, slabSize);
+        }
+    }
+
+    /**
+     * @brief Samples the grid corners of a block of the lattice, skipping the parts where the density provably keeps its sign
+     *
+     * The block is split in octants until the bounds of the density source prove one of them empty
+     * or solid, or until it is small enough to be sampled in one batch. The grid corners of a skipped
+     * block get the bound closest to 0 instead of a sample. The bounds are taken over the block grown
+     * by 2 cells, so any corner whose actual value a mesher may need, at the end of an edge crossed
+     * by the surface or next to one for a central difference, is always sampled: the resulting
+     * meshes are the same as with every corner sampled.
+     * @param[in] densityFunc Density source providing GetDensityRange
+     * @param[in] origin Position of the first grid corner
+     * @param[in] cellSize Cell size
+     * @param[in] numSamples Number of grid corners along each axis
+     * @param[in] latticePart Null, or part of the density at the grid corners, from GetLatticePart
+     * @param[in] blockMin Index of the first grid corner of the block
+     * @param[in] blockMax One past the index of the last grid corner of the block
+     * @param[out] outputValues Lattice where the samples will be placed, x varying fastest
+     * @param[out] outputIsSignOnly Null for exact samples, or lattice of flags, set to 1 for the samples that only have the right sign
+     */
+    template <typename DensityFunc>
+    void SampleLatticeBlocks(DensityFunc& densityFunc, const glm::vec3& origin, float cellSize, const glm::ivec3& numSamples, const float* latticePart, const glm::ivec3& blockMin, const glm::ivec3& blockMax, float* outputValues, unsigned char* outputIsSignOnly = nullptr)
+    {
+        const int margin = 2;
+        const int maxLeafSize = 8;
+
+        const glm::ivec3 blockSize = blockMax - blockMin;
+        if ((blockSize.x <= 0) || (blockSize.y <= 0) || (blockSize.z <= 0))
+        {
+            return;
+        }
+
+        const size_t strideY = numSamples.x;
+        const size_t strideZ = strideY * numSamples.y;
+
+        AABB box;
+        box.min = origin + glm::vec3(blockMin - margin) * cellSize;
+        box.max = origin + glm::vec3(blockMax - 1 + margin) * cellSize;
+
+        float value;
+        if (IsDensitySignConstant(densityFunc, box, value))
+        {
+            for (int z = blockMin.z; z < blockMax.z; ++z)
+            {
+                for (int y = blockMin.y; y < blockMax.y; ++y)
+                {
+                    const size_t rowIndex = y * strideY + z * strideZ;
+                    std::fill(outputValues + rowIndex + blockMin.x, outputValues + rowIndex + blockMax.x, value);
+                    if (outputIsSignOnly != nullptr)
+                    {
+                        std::fill(outputIsSignOnly + rowIndex + blockMin.x, outputIsSignOnly + rowIndex + blockMax.x, 0);
+                    }
+                }
+            }
+            return;
+        }
+
+        if (std::max(blockSize.x, std::max(blockSize.y, blockSize.z)) > maxLeafSize)
+        {
+            // Octants, not splitting the axes that are already small enough
+            const glm::ivec3 blockMid(blockSize.x > maxLeafSize ? blockMin.x + blockSize.x / 2 : blockMax.x,
+                                      blockSize.y > maxLeafSize ? blockMin.y + blockSize.y / 2 : blockMax.y,
+                                      blockSize.z > maxLeafSize ? blockMin.z + blockSize.z / 2 : blockMax.z);
+            for (int i = 0; i < 8; ++i)
+            {
+                const glm::ivec3 childMin((i & 1) ? blockMid.x : blockMin.x, (i & 2) ? blockMid.y : blockMin.y, (i & 4) ? blockMid.z : blockMin.z);
+                const glm::ivec3 childMax((i & 1) ? blockMax.x : blockMid.x, (i & 2) ? blockMax.y : blockMid.y, (i & 4) ? blockMax.z : blockMid.z);
+                SampleLatticeBlocks(densityFunc, origin, cellSize, numSamples, latticePart, childMin, childMax, outputValues, outputIsSignOnly);
+            }
+            return;
+        }
+
+        // The positions are computed like in SampleLatticeSlabs, so the samples are the same
+        const size_t numBlockSamples = static_cast<size_t>(blockSize.x) * blockSize.y * blockSize.z;
+        std::vector<float> xs(numBlockSamples);
+        std::vector<float> ys(numBlockSamples);
+        std::vector<float> zs(numBlockSamples);
+        std::vector<float> values(numBlockSamples);
+        std::vector<unsigned char> isSignOnly((outputIsSignOnly != nullptr) ? numBlockSamples : 0);
+        std::vector<float> blockLatticePart((latticePart != nullptr) ? numBlockSamples : 0);
+
+        size_t sampleIndex = 0;
+        for (int z = blockMin.z; z < blockMax.z; ++z)
+        {
+            for (int y = blockMin.y; y < blockMax.y; ++y)
+            {
+                for (int x = blockMin.x; x < blockMax.x; ++x)
+                {
+                    xs[sampleIndex] = origin.x + x * cellSize;
+                    ys[sampleIndex] = origin.y + y * cellSize;
+                    zs[sampleIndex] = origin.z + z * cellSize;
+                    if (latticePart != nullptr)
+                    {
+                        blockLatticePart[sampleIndex] = latticePart[x + y * strideY + z * strideZ];
+                    }
+                    ++sampleIndex;
+                }
+            }
+        }
+        EvaluateLatticeBatch(densityFunc, xs.data(), ys.data(), zs.data(), (latticePart != nullptr) ? blockLatticePart.data() : nullptr, values.data(), (outputIsSignOnly != nullptr) ? isSignOnly.data() : nullptr, numBlockSamples);
+
+        sampleIndex = 0;
+        for (int z = blockMin.z; z < blockMax.z; ++z)
+        {
+            for (int y = blockMin.y; y < blockMax.y; ++y)
+            {
+                const size_t rowIndex = y * strideY + z * strideZ;
+                std::copy(values.begin() + sampleIndex, values.begin() + sampleIndex + blockSize.x, outputValues + rowIndex + blockMin.x);
+                if (outputIsSignOnly != nullptr)
+                {
+                    std::copy(isSignOnly.begin() + sampleIndex, isSignOnly.begin() + sampleIndex + blockSize.x, outputIsSignOnly + rowIndex + blockMin.x);
+                }
+                sampleIndex += blockSize.x;
+            }
+        }
+    }
+
+    /**
+     * @brief Samples the provided function at the grid corners of the z-slabs [zBegin, zEnd),
+     * skipping the blocks where it provably keeps its sign if it provides GetDensityRange
+     * @param[in] densityFunc Density function or batch density source
+     * @param[in] origin Position of the first grid corner
+     * @param[in] cellSize Cell size
+     * @param[in] numSamples Number of grid corners along each axis
+     * @param[in] latticePart Null, or part of the density at the grid corners, from GetLatticePart
+     * @param[in] zBegin Index of the first z-slab to sample
+     * @param[in] zEnd One past the index of the last z-slab to sample
+     * @param[out] outputValues Lattice where the samples will be placed, x varying fastest
+     * @param[out] outputIsSignOnly Null for exact samples, or lattice of flags, set to 1 for the samples that only have the right sign
+     */
+    template <typename DensityFunc>
+    typename std::enable_if<HasDensityRange<DensityFunc>::value>::type
+    SampleLatticePart(DensityFunc& densityFunc, const glm::vec3& origin, float cellSize, const glm::ivec3& numSamples, const float* latticePart, int zBegin, int zEnd, float* outputValues, unsigned char* outputIsSignOnly = nullptr)
+    {
+        SampleLatticeBlocks(densityFunc, origin, cellSize, numSamples, latticePart, glm::ivec3(0, 0, zBegin), glm::ivec3(numSamples.x, numSamples.y, zEnd), outputValues, outputIsSignOnly);
+    }
+
+    /**
+     * @brief Samples the provided function at the grid corners of the z-slabs [zBegin, zEnd),
+     * skipping the blocks where it provably keeps its sign if it provides GetDensityRange
+     * @param[in] densityFunc Density function or batch density source
+     * @param[in] origin Position of the first grid corner
+     * @param[in] cellSize Cell size
+     * @param[in] numSamples Number of grid corners along each axis
+     * @param[in] latticePart Null, or part of the density at the grid corners, from GetLatticePart
+     * @param[in] zBegin Index of the first z-slab to sample
+     * @param[in] zEnd One past the index of the last z-slab to sample
+     * @param[out] outputValues Lattice where the samples will be placed, x varying fastest
+     * @param[out] outputIsSignOnly Null for exact samples, or lattice of flags, set to 1 for the samples that only have the right sign
+     */
+    template <typename DensityFunc>
+    typename std::enable_if<!HasDensityRange<DensityFunc>::value>::type
+    SampleLatticePart(DensityFunc& densityFunc, const glm::vec3& origin, float cellSize, const glm::ivec3& numSamples, const float* latticePart, int zBegin, int zEnd, float* outputValues, unsigned char* outputIsSignOnly = nullptr)
+    {
+        SampleLatticeSlabs(densityFunc, origin, cellSize, numSamples, latticePart, zBegin, zEnd, outputValues, outputIsSignOnly);
+    }
+
+    /**
+     * @brief Flags the grid corners of the z-slabs [zBegin, zEnd) at the end of an edge crossed by the surface
+     * of an isovalue in [0, maxIsovalue]
+     * @param[in] values Lattice of samples, x varying fastest. Only their sides of the isovalues are read.
+     * @param[in] numSamples Number of grid corners along each axis
+     * @param[in] maxIsovalue Highest isovalue, 0 for the surface at 0 only
+     * @param[in] zBegin Index of the first z-slab to flag
+     * @param[in] zEnd One past the index of the last z-slab to flag
+     * @param[out] outputIsOnCrossedEdge Lattice of flags, set to 1 for the grid corners with a neighbour along an axis on the other side of an isovalue
+     */
+    inline void FindCrossedEdgeCorners(const float* values, const glm::ivec3& numSamples, float maxIsovalue, int zBegin, int zEnd, unsigned char* outputIsOnCrossedEdge)
+    {
+        // Some isovalue is between two values if the lower one is at most the highest isovalue,
+        // and the higher one is above 0. With a single isovalue, this is a change of sign.
+        auto isCrossed = [maxIsovalue](float value0, float value1)
+        {
+            return (std::min(value0, value1) <= maxIsovalue) && (std::max(value0, value1) > 0.0f);
+        };
+
+        const size_t strideY = numSamples.x;
+        const size_t strideZ = strideY * numSamples.y;
+        for (int z = zBegin; z < zEnd; ++z)
+        {
+            for (int y = 0; y < numSamples.y; ++y)
+            {
+                for (int x = 0; x < numSamples.x; ++x)
+                {
+                    const size_t index = x + y * strideY + z * strideZ;
+                    const float value = values[index];
+                    const bool isOnCrossedEdge = ((x > 0) && isCrossed(value, values[index - 1])) ||
+                                                 ((x + 1 < numSamples.x) && isCrossed(value, values[index + 1])) ||
+                                                 ((y > 0) && isCrossed(value, values[index - strideY])) ||
+                                                 ((y + 1 < numSamples.y) && isCrossed(value, values[index + strideY])) ||
+                                                 ((z > 0) && isCrossed(value, values[index - strideZ])) ||
+                                                 ((z + 1 < numSamples.z) && isCrossed(value, values[index + strideZ]));
+                    outputIsOnCrossedEdge[index] = isOnCrossedEdge ? 1 : 0;
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Flags the grid corners of the z-slabs [zBegin, zEnd) lying on some faces of a box in the lattice,
+     * which a mesher reads even if they are not at the end of a crossed edge
+     * @param[in] numSamples Number of grid corners along each axis
+     * @param[in] boxMin First grid corner of the box
+     * @param[in] boxMax Last grid corner of the box
+     * @param[in] faces Faces of the box, with bit 2 * axis set for the lower face along the axis, and bit 2 * axis + 1 for the upper one
+     * @param[in] zBegin Index of the first z-slab to flag
+     * @param[in] zEnd One past the index of the last z-slab to flag
+     * @param[in,out] isOnCrossedEdge Lattice of flags from FindCrossedEdgeCorners, where bit 1 is set for the grid corners on the faces
+     */
+    inline void FlagFaceCorners(const glm::ivec3& numSamples, const glm::ivec3& boxMin, const glm::ivec3& boxMax, int faces, int zBegin, int zEnd, unsigned char* isOnCrossedEdge)
+    {
+        const size_t strideY = numSamples.x;
+        const size_t strideZ = strideY * numSamples.y;
+        for (int face = 0; face < 6; ++face)
+        {
+            if ((faces & (1 << face)) == 0)
+            {
+                continue;
+            }
+
+            // Grid corners of the face
+            const int axis = face / 2;
+            glm::ivec3 faceMin = boxMin;
+            glm::ivec3 faceMax = boxMax;
+            faceMin[axis] = faceMax[axis] = ((face & 1) != 0) ? boxMax[axis] : boxMin[axis];
+
+            for (int z = std::max(zBegin, faceMin.z); z < std::min(zEnd, faceMax.z + 1); ++z)
+            {
+                for (int y = faceMin.y; y <= faceMax.y; ++y)
+                {
+                    for (int x = faceMin.x; x <= faceMax.x; ++x)
+                    {
+                        isOnCrossedEdge[x + y * strideY + z * strideZ] |= 2;
+                    }
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Samples again, exactly, the sign-only grid corners of the z-slabs [zBegin, zEnd) whose value a mesher may read
+     *
+     * Meshers read the values at the ends of the edges crossed by the surface, and central differences
+     * around them read their neighbours along each axis. Sign-only samples already have the right sign,
+     * so the crossed edges stay the same, and the resulting meshes are the same as with exact samples.
+     * The grid corners flagged by FlagFaceCorners are read as well, but not their neighbours.
+     * @param[in] densityFunc Density function or batch density source
+     * @param[in] origin Position of the first grid corner
+     * @param[in] cellSize Cell size
+     * @param[in] numSamples Number of grid corners along each axis
+     * @param[in] latticePart Null, or part of the density at the grid corners, from GetLatticePart
+     * @param[in] zBegin Index of the first z-slab to refine
+     * @param[in] zEnd One past the index of the last z-slab to refine
+     * @param[in] isOnCrossedEdge Lattice of flags from FindCrossedEdgeCorners, and FlagFaceCorners if some faces are read
+     * @param[in] isSignOnly Lattice of flags, set to 1 for the samples that only have the right sign
+     * @param[in,out] values Lattice of samples, x varying fastest
+     */
+    template <typename DensityFunc>
+    void RefineSignOnlySamples(DensityFunc& densityFunc, const glm::vec3& origin, float cellSize, const glm::ivec3& numSamples, const float* latticePart, int zBegin, int zEnd,
+                               const unsigned char* isOnCrossedEdge, const unsigned char* isSignOnly, float* values)
+    {
+        const size_t strideY = numSamples.x;
+        const size_t strideZ = strideY * numSamples.y;
+
+        // The positions are computed like in SampleLatticeSlabs, so the samples are the same
+        std::vector<size_t> indices;
+        std::vector<float> xs;
+        std::vector<float> ys;
+        std::vector<float> zs;
+        std::vector<float> refinedLatticePart;
+        for (int z = zBegin; z < zEnd; ++z)
+        {
+            for (int y = 0; y < numSamples.y; ++y)
+            {
+                for (int x = 0; x < numSamples.x; ++x)
+                {
+                    const size_t index = x + y * strideY + z * strideZ;
+                    if (!isSignOnly[index])
+                    {
+                        continue;
+                    }
+
+                    const bool isRead = (isOnCrossedEdge[index] != 0) ||
+                                        ((x > 0) && (isOnCrossedEdge[index - 1] & 1)) ||
+                                        ((x + 1 < numSamples.x) && (isOnCrossedEdge[index + 1] & 1)) ||
+                                        ((y > 0) && (isOnCrossedEdge[index - strideY] & 1)) ||
+                                        ((y + 1 < numSamples.y) && (isOnCrossedEdge[index + strideY] & 1)) ||
+                                        ((z > 0) && (isOnCrossedEdge[index - strideZ] & 1)) ||
+                                        ((z + 1 < numSamples.z) && (isOnCrossedEdge[index + strideZ] & 1));
+                    if (isRead)
+                    {
+                        indices.push_back(index);
+                        xs.push_back(origin.x + x * cellSize);
+                        ys.push_back(origin.y + y * cellSize);
+                        zs.push_back(origin.z + z * cellSize);
+                        if (latticePart != nullptr)
+                        {
+                            refinedLatticePart.push_back(latticePart[index]);
+                        }
+                    }
+                }
+            }
+        }
+
+        std::vector<float> exactValues(indices.size());
+        EvaluateLatticeBatch(densityFunc, xs.data(), ys.data(), zs.data(), (latticePart != nullptr) ? refinedLatticePart.data() : nullptr, exactValues.data(), nullptr, indices.size());
+        for (size_t i = 0; i < indices.size(); ++i)
+        {
+            values[indices[i]] = exactValues[i];
+        }
+    }
+}
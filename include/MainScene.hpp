@@ -10,12 +10,17 @@
 #include "Engine/SceneBase.hpp"
 
 #include "Chunk.hpp"
+#include "MesherBase.hpp"
+#include "MeshingAlgorithm.hpp"
 #include "Terrain.hpp"
+#include "TerrainVertexSink.hpp"
 
 #include <glad/glad.h>
 #include <glm/glm.hpp>
 
+#include <atomic>
 #include <functional>
+#include <memory>
 #include <mutex>
 #include <queue>
 #include <thread>
@@ -31,8 +36,9 @@ namespace MarchingCubes
     public:
         /**
          * @brief Constructor
+         * @param[in] meshingAlgorithm Algorithm used to mesh the chunks at startup
          */
-        MainScene();
+        MainScene(MeshingAlgorithm meshingAlgorithm = MeshingAlgorithm::MarchingCubes);
 
         /**
          * @brief Destructor
@@ -64,16 +70,37 @@ namespace MarchingCubes
         /**
          * @brief Routine to be done by each worker thread.
          * @param[in] threadIndex Thread index
-         * @param[in] signedDistanceFunc Signed distance function
-         * @param[in] voxelSize Voxel size
          */
-        void ThreadJob(int threadIndex, std::function<float(float, float, float)> signedDistanceFunc);
+        void ThreadJob(int threadIndex);
 
         /**
          * @brief Update chunks
          */
         void UpdateChunks();
 
+        /**
+         * @brief Gets the level of detail of a chunk
+         * @param[in] chunkIndex Chunk index
+         * @param[in] centerChunkIndex Index of the chunk the camera is in
+         * @return Level of detail
+         */
+        int GetChunkLod(const glm::ivec3& chunkIndex, const glm::ivec3& centerChunkIndex) const;
+
+        /**
+         * @brief Gets the faces of a chunk that border a chunk with a finer level of detail
+         * @param[in] chunkIndex Chunk index
+         * @param[in] centerChunkIndex Index of the chunk the camera is in
+         * @return Combination of MarchingCubes::TransitionFace flags
+         */
+        int GetChunkTransitionFaces(const glm::ivec3& chunkIndex, const glm::ivec3& centerChunkIndex) const;
+
+        /**
+         * @brief Checks whether the terrain provably has no surface in a chunk
+         * @param[in] chunk Chunk, with its bounds and level of detail set
+         * @return True if the chunk is all air or all solid, false if it may have a surface or is not at full detail
+         */
+        bool IsChunkEmptyOrSolid(const Chunk& chunk);
+
     private:
         /**
          * Terrain
@@ -126,11 +153,31 @@ namespace MarchingCubes
          */
         float m_voxelSize;
 
+        /**
+         * Quantization step of the chunk vertex positions, shared by all chunks so they match along their borders
+         */
+        float m_vertexPositionStep;
+
         /**
          * Number of chunks to render in all axes
          */
         glm::ivec3 m_chunkRenderDistance;
 
+        /**
+         * Coarsest level of detail. Each level doubles the voxel size.
+         */
+        int m_maxChunkLod;
+
+        /**
+         * Number of chunks around the camera sharing the same level of detail
+         */
+        int m_chunkLodDistance;
+
+        /**
+         * Number of boxes along each axis the terrain bounds are queried over to prove a chunk empty or solid
+         */
+        int m_numChunkCullingDivisions;
+
         /**
          * Is our application done?
          */
@@ -158,6 +205,42 @@ namespace MarchingCubes
 
         float m_time;
 
+        /**
+         * Number of chunks generated by the worker threads
+         * since the last throughput measurement
+         */
+        std::atomic<int32_t> m_numGeneratedChunks;
+
+        /**
+         * Time elapsed since the last throughput measurement
+         */
+        float m_chunkThroughputTimer;
+
+        /**
+         * Number of chunks generated per second
+         */
+        float m_chunkThroughput;
+
+        /**
+         * Algorithm used by the worker threads to mesh new chunks
+         */
+        std::atomic<MeshingAlgorithm> m_meshingAlgorithm;
+
+        /**
+         * Mesher of every meshing algorithm, writing straight into the chunk vertices
+         */
+        std::vector<std::unique_ptr<MesherBase<Terrain, TerrainVertexSink>>> m_meshers;
+
+        /**
+         * Are new chunk meshes simplified by the worker threads?
+         */
+        std::atomic<bool> m_isDecimationEnabled;
+
+        /**
+         * Largest distance the simplification may move the surface, relative to the voxel size of the chunk
+         */
+        float m_decimationError;
+
 
         // --- UI ---
         
@@ -2,9 +2,20 @@
 
 #include "Engine/Geometry/BoundingVolumes/AABB.hpp"
 
+#include "CellClassifier.hpp"
+#include "LatticeSampler.hpp"
+#include "ParallelFor.hpp"
+#include "RegularCellTables.hpp"
+#include "ShiftedDensity.hpp"
 #include "Triangle.hpp"
+#include "VertexSink.hpp"
 
+#include <algorithm>
+#include <cstdint>
 #include <functional>
+#include <limits>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 namespace MarchingCubes
@@ -15,358 +26,53 @@ namespace MarchingCubes
     class MarchingCubes
     {
     private:
+        friend class FlyingEdges;
+        friend class DualContouring;
+        friend class RawVolumeMesher;
+        friend class SurfaceNets;
+
         /**
          *  Cube vertex position offsets
          */
-        const glm::vec3 vertexPositionOffsets[8] =
-        {
-            {0.0f, 0.0f, 0.0f},
-            {1.0f, 0.0f, 0.0f},
-            {0.0f, 0.0f, 1.0f},
-            {1.0f, 0.0f, 1.0f},
-            {0.0f, 1.0f, 0.0f},
-            {1.0f, 1.0f, 0.0f},
-            {0.0f, 1.0f, 1.0f},
-            {1.0f, 1.0f, 1.0f}
-        };
+        static const glm::vec3 vertexPositionOffsets[8];
 
-        // The following data originates from Eric Lengyel's Transvoxel Algorithm.
-        // http://transvoxel.org/
-
-        // The RegularCellData structure holds information about the triangulation
-        // used for a single equivalence class in the modified Marching Cubes algorithm,
-        // described in Section 3.2.
-        struct RegularCellData
-        {
-            unsigned char	geometryCounts;		// High nibble is vertex count, low nibble is triangle count.
-            unsigned char	vertexIndex[15];	// Groups of 3 indexes giving the triangulation.
-            
-            long GetVertexCount(void) const
-            {
-                return (geometryCounts >> 4);
-            }
-            
-            long GetTriangleCount(void) const
-            {
-                return (geometryCounts & 0x0F);
-            }
-        };
+        /**
+         * Triangulation of every case, flattened at compile time from the regular cell tables
+         */
+        static constexpr RegularCaseTable regularCases = MakeRegularCaseTable(MakeIndexSequence<256>::Type());
 
-        // The regularCellClass table maps an 8-bit regular Marching Cubes case index to
-        // an equivalence class index. Even though there are 18 equivalence classes in our
-        // modified Marching Cubes algorithm, a couple of them use the same exact triangulations,
-        // just with different vertex locations. We combined those classes for this table so
-        // that the class index ranges from 0 to 15.
-        const unsigned char regularCellClass[256] =
+        /**
+         * Cell that the surface passes through
+         */
+        struct ActiveCell
         {
-            0x00, 0x01, 0x01, 0x03, 0x01, 0x03, 0x02, 0x04, 0x01, 0x02, 0x03, 0x04, 0x03, 0x04, 0x04, 0x03,
-            0x01, 0x03, 0x02, 0x04, 0x02, 0x04, 0x06, 0x0C, 0x02, 0x05, 0x05, 0x0B, 0x05, 0x0A, 0x07, 0x04,
-            0x01, 0x02, 0x03, 0x04, 0x02, 0x05, 0x05, 0x0A, 0x02, 0x06, 0x04, 0x0C, 0x05, 0x07, 0x0B, 0x04,
-            0x03, 0x04, 0x04, 0x03, 0x05, 0x0B, 0x07, 0x04, 0x05, 0x07, 0x0A, 0x04, 0x08, 0x0E, 0x0E, 0x03,
-            0x01, 0x02, 0x02, 0x05, 0x03, 0x04, 0x05, 0x0B, 0x02, 0x06, 0x05, 0x07, 0x04, 0x0C, 0x0A, 0x04,
-            0x03, 0x04, 0x05, 0x0A, 0x04, 0x03, 0x07, 0x04, 0x05, 0x07, 0x08, 0x0E, 0x0B, 0x04, 0x0E, 0x03,
-            0x02, 0x06, 0x05, 0x07, 0x05, 0x07, 0x08, 0x0E, 0x06, 0x09, 0x07, 0x0F, 0x07, 0x0F, 0x0E, 0x0D,
-            0x04, 0x0C, 0x0B, 0x04, 0x0A, 0x04, 0x0E, 0x03, 0x07, 0x0F, 0x0E, 0x0D, 0x0E, 0x0D, 0x02, 0x01,
-            0x01, 0x02, 0x02, 0x05, 0x02, 0x05, 0x06, 0x07, 0x03, 0x05, 0x04, 0x0A, 0x04, 0x0B, 0x0C, 0x04,
-            0x02, 0x05, 0x06, 0x07, 0x06, 0x07, 0x09, 0x0F, 0x05, 0x08, 0x07, 0x0E, 0x07, 0x0E, 0x0F, 0x0D,
-            0x03, 0x05, 0x04, 0x0B, 0x05, 0x08, 0x07, 0x0E, 0x04, 0x07, 0x03, 0x04, 0x0A, 0x0E, 0x04, 0x03,
-            0x04, 0x0A, 0x0C, 0x04, 0x07, 0x0E, 0x0F, 0x0D, 0x0B, 0x0E, 0x04, 0x03, 0x0E, 0x02, 0x0D, 0x01,
-            0x03, 0x05, 0x05, 0x08, 0x04, 0x0A, 0x07, 0x0E, 0x04, 0x07, 0x0B, 0x0E, 0x03, 0x04, 0x04, 0x03,
-            0x04, 0x0B, 0x07, 0x0E, 0x0C, 0x04, 0x0F, 0x0D, 0x0A, 0x0E, 0x0E, 0x02, 0x04, 0x03, 0x0D, 0x01,
-            0x04, 0x07, 0x0A, 0x0E, 0x0B, 0x0E, 0x0E, 0x02, 0x0C, 0x0F, 0x04, 0x0D, 0x04, 0x0D, 0x03, 0x01,
-            0x03, 0x04, 0x04, 0x03, 0x04, 0x03, 0x0D, 0x01, 0x04, 0x0D, 0x03, 0x01, 0x03, 0x01, 0x01, 0x00
-        };
-
+            /**
+             * Cell indices
+             */
+            int x;
+            int y;
+            int z;
 
-        // The regularCellData table holds the triangulation data for all 16 distinct classes to
-        // which a case can be mapped by the regularCellClass table.
-        const RegularCellData regularCellData[16] =
-        {
-            {0x00, {}},
-            {0x31, {0, 1, 2}},
-            {0x62, {0, 1, 2, 3, 4, 5}},
-            {0x42, {0, 1, 2, 0, 2, 3}},
-            {0x53, {0, 1, 4, 1, 3, 4, 1, 2, 3}},
-            {0x73, {0, 1, 2, 0, 2, 3, 4, 5, 6}},
-            {0x93, {0, 1, 2, 3, 4, 5, 6, 7, 8}},
-            {0x84, {0, 1, 4, 1, 3, 4, 1, 2, 3, 5, 6, 7}},
-            {0x84, {0, 1, 2, 0, 2, 3, 4, 5, 6, 4, 6, 7}},
-            {0xC4, {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11}},
-            {0x64, {0, 4, 5, 0, 1, 4, 1, 3, 4, 1, 2, 3}},
-            {0x64, {0, 5, 4, 0, 4, 1, 1, 4, 3, 1, 3, 2}},
-            {0x64, {0, 4, 5, 0, 3, 4, 0, 1, 3, 1, 2, 3}},
-            {0x64, {0, 1, 2, 0, 2, 3, 0, 3, 4, 0, 4, 5}},
-            {0x75, {0, 1, 2, 0, 2, 3, 0, 3, 4, 0, 4, 5, 0, 5, 6}},
-            {0x95, {0, 4, 5, 0, 3, 4, 0, 1, 3, 1, 2, 3, 6, 7, 8}}
+            /**
+             * Case index of the cell
+             */
+            int caseIndex;
         };
 
-
-        // The regularVertexData table gives the vertex locations for every one of the 256 possible
-        // cases in the modified Marching Cubes algorithm. Each 16-bit value also provides information
-        // about whether a vertex can be reused from a neighboring cell. See Section 3.3 for details.
-        // The low byte contains the indexes for the two endpoints of the edge on which the vertex lies,
-        // as numbered in Figure 3.7. The high byte contains the vertex reuse data shown in Figure 3.8.
-        const unsigned short regularVertexData[256][12] =
+    public:
+        /**
+         * Faces of the bounds that border a mesh with half the cell size
+         */
+        enum TransitionFace
         {
-            {},
-            {0x6201, 0x5102, 0x3304},
-            {0x6201, 0x2315, 0x4113},
-            {0x5102, 0x3304, 0x2315, 0x4113},
-            {0x5102, 0x4223, 0x1326},
-            {0x3304, 0x6201, 0x4223, 0x1326},
-            {0x6201, 0x2315, 0x4113, 0x5102, 0x4223, 0x1326},
-            {0x4223, 0x1326, 0x3304, 0x2315, 0x4113},
-            {0x4113, 0x8337, 0x4223},
-            {0x6201, 0x5102, 0x3304, 0x4223, 0x4113, 0x8337},
-            {0x6201, 0x2315, 0x8337, 0x4223},
-            {0x5102, 0x3304, 0x2315, 0x8337, 0x4223},
-            {0x5102, 0x4113, 0x8337, 0x1326},
-            {0x4113, 0x8337, 0x1326, 0x3304, 0x6201},
-            {0x6201, 0x2315, 0x8337, 0x1326, 0x5102},
-            {0x3304, 0x2315, 0x8337, 0x1326},
-            {0x3304, 0x1146, 0x2245},
-            {0x6201, 0x5102, 0x1146, 0x2245},
-            {0x6201, 0x2315, 0x4113, 0x3304, 0x1146, 0x2245},
-            {0x2315, 0x4113, 0x5102, 0x1146, 0x2245},
-            {0x5102, 0x4223, 0x1326, 0x3304, 0x1146, 0x2245},
-            {0x1146, 0x2245, 0x6201, 0x4223, 0x1326},
-            {0x3304, 0x1146, 0x2245, 0x6201, 0x2315, 0x4113, 0x5102, 0x4223, 0x1326},
-            {0x4223, 0x1326, 0x1146, 0x2245, 0x2315, 0x4113},
-            {0x4223, 0x4113, 0x8337, 0x3304, 0x1146, 0x2245},
-            {0x6201, 0x5102, 0x1146, 0x2245, 0x4223, 0x4113, 0x8337},
-            {0x4223, 0x6201, 0x2315, 0x8337, 0x3304, 0x1146, 0x2245},
-            {0x4223, 0x8337, 0x2315, 0x2245, 0x1146, 0x5102},
-            {0x5102, 0x4113, 0x8337, 0x1326, 0x3304, 0x1146, 0x2245},
-            {0x4113, 0x8337, 0x1326, 0x1146, 0x2245, 0x6201},
-            {0x6201, 0x2315, 0x8337, 0x1326, 0x5102, 0x3304, 0x1146, 0x2245},
-            {0x2245, 0x2315, 0x8337, 0x1326, 0x1146},
-            {0x2315, 0x2245, 0x8157},
-            {0x6201, 0x5102, 0x3304, 0x2315, 0x2245, 0x8157},
-            {0x4113, 0x6201, 0x2245, 0x8157},
-            {0x2245, 0x8157, 0x4113, 0x5102, 0x3304},
-            {0x5102, 0x4223, 0x1326, 0x2315, 0x2245, 0x8157},
-            {0x6201, 0x4223, 0x1326, 0x3304, 0x2315, 0x2245, 0x8157},
-            {0x6201, 0x2245, 0x8157, 0x4113, 0x5102, 0x4223, 0x1326},
-            {0x4223, 0x1326, 0x3304, 0x2245, 0x8157, 0x4113},
-            {0x4223, 0x4113, 0x8337, 0x2315, 0x2245, 0x8157},
-            {0x6201, 0x5102, 0x3304, 0x4223, 0x4113, 0x8337, 0x2315, 0x2245, 0x8157},
-            {0x8337, 0x4223, 0x6201, 0x2245, 0x8157},
-            {0x5102, 0x3304, 0x2245, 0x8157, 0x8337, 0x4223},
-            {0x5102, 0x4113, 0x8337, 0x1326, 0x2315, 0x2245, 0x8157},
-            {0x4113, 0x8337, 0x1326, 0x3304, 0x6201, 0x2315, 0x2245, 0x8157},
-            {0x5102, 0x1326, 0x8337, 0x8157, 0x2245, 0x6201},
-            {0x8157, 0x8337, 0x1326, 0x3304, 0x2245},
-            {0x2315, 0x3304, 0x1146, 0x8157},
-            {0x6201, 0x5102, 0x1146, 0x8157, 0x2315},
-            {0x3304, 0x1146, 0x8157, 0x4113, 0x6201},
-            {0x4113, 0x5102, 0x1146, 0x8157},
-            {0x2315, 0x3304, 0x1146, 0x8157, 0x5102, 0x4223, 0x1326},
-            {0x1326, 0x4223, 0x6201, 0x2315, 0x8157, 0x1146},
-            {0x3304, 0x1146, 0x8157, 0x4113, 0x6201, 0x5102, 0x4223, 0x1326},
-            {0x1326, 0x1146, 0x8157, 0x4113, 0x4223},
-            {0x2315, 0x3304, 0x1146, 0x8157, 0x4223, 0x4113, 0x8337},
-            {0x6201, 0x5102, 0x1146, 0x8157, 0x2315, 0x4223, 0x4113, 0x8337},
-            {0x3304, 0x1146, 0x8157, 0x8337, 0x4223, 0x6201},
-            {0x4223, 0x5102, 0x1146, 0x8157, 0x8337},
-            {0x2315, 0x3304, 0x1146, 0x8157, 0x5102, 0x4113, 0x8337, 0x1326},
-            {0x6201, 0x4113, 0x8337, 0x1326, 0x1146, 0x8157, 0x2315},
-            {0x6201, 0x3304, 0x1146, 0x8157, 0x8337, 0x1326, 0x5102},
-            {0x1326, 0x1146, 0x8157, 0x8337},
-            {0x1326, 0x8267, 0x1146},
-            {0x6201, 0x5102, 0x3304, 0x1326, 0x8267, 0x1146},
-            {0x6201, 0x2315, 0x4113, 0x1326, 0x8267, 0x1146},
-            {0x5102, 0x3304, 0x2315, 0x4113, 0x1326, 0x8267, 0x1146},
-            {0x5102, 0x4223, 0x8267, 0x1146},
-            {0x3304, 0x6201, 0x4223, 0x8267, 0x1146},
-            {0x5102, 0x4223, 0x8267, 0x1146, 0x6201, 0x2315, 0x4113},
-            {0x1146, 0x8267, 0x4223, 0x4113, 0x2315, 0x3304},
-            {0x4113, 0x8337, 0x4223, 0x1326, 0x8267, 0x1146},
-            {0x6201, 0x5102, 0x3304, 0x4223, 0x4113, 0x8337, 0x1326, 0x8267, 0x1146},
-            {0x6201, 0x2315, 0x8337, 0x4223, 0x1326, 0x8267, 0x1146},
-            {0x5102, 0x3304, 0x2315, 0x8337, 0x4223, 0x1326, 0x8267, 0x1146},
-            {0x8267, 0x1146, 0x5102, 0x4113, 0x8337},
-            {0x6201, 0x4113, 0x8337, 0x8267, 0x1146, 0x3304},
-            {0x6201, 0x2315, 0x8337, 0x8267, 0x1146, 0x5102},
-            {0x1146, 0x3304, 0x2315, 0x8337, 0x8267},
-            {0x3304, 0x1326, 0x8267, 0x2245},
-            {0x1326, 0x8267, 0x2245, 0x6201, 0x5102},
-            {0x3304, 0x1326, 0x8267, 0x2245, 0x6201, 0x2315, 0x4113},
-            {0x1326, 0x8267, 0x2245, 0x2315, 0x4113, 0x5102},
-            {0x5102, 0x4223, 0x8267, 0x2245, 0x3304},
-            {0x6201, 0x4223, 0x8267, 0x2245},
-            {0x5102, 0x4223, 0x8267, 0x2245, 0x3304, 0x6201, 0x2315, 0x4113},
-            {0x4113, 0x4223, 0x8267, 0x2245, 0x2315},
-            {0x3304, 0x1326, 0x8267, 0x2245, 0x4223, 0x4113, 0x8337},
-            {0x1326, 0x8267, 0x2245, 0x6201, 0x5102, 0x4223, 0x4113, 0x8337},
-            {0x3304, 0x1326, 0x8267, 0x2245, 0x4223, 0x6201, 0x2315, 0x8337},
-            {0x5102, 0x1326, 0x8267, 0x2245, 0x2315, 0x8337, 0x4223},
-            {0x3304, 0x2245, 0x8267, 0x8337, 0x4113, 0x5102},
-            {0x8337, 0x8267, 0x2245, 0x6201, 0x4113},
-            {0x5102, 0x6201, 0x2315, 0x8337, 0x8267, 0x2245, 0x3304},
-            {0x2315, 0x8337, 0x8267, 0x2245},
-            {0x2315, 0x2245, 0x8157, 0x1326, 0x8267, 0x1146},
-            {0x6201, 0x5102, 0x3304, 0x2315, 0x2245, 0x8157, 0x1326, 0x8267, 0x1146},
-            {0x6201, 0x2245, 0x8157, 0x4113, 0x1326, 0x8267, 0x1146},
-            {0x2245, 0x8157, 0x4113, 0x5102, 0x3304, 0x1326, 0x8267, 0x1146},
-            {0x4223, 0x8267, 0x1146, 0x5102, 0x2315, 0x2245, 0x8157},
-            {0x3304, 0x6201, 0x4223, 0x8267, 0x1146, 0x2315, 0x2245, 0x8157},
-            {0x4223, 0x8267, 0x1146, 0x5102, 0x6201, 0x2245, 0x8157, 0x4113},
-            {0x3304, 0x2245, 0x8157, 0x4113, 0x4223, 0x8267, 0x1146},
-            {0x4223, 0x4113, 0x8337, 0x2315, 0x2245, 0x8157, 0x1326, 0x8267, 0x1146},
-            {0x6201, 0x5102, 0x3304, 0x4223, 0x4113, 0x8337, 0x2315, 0x2245, 0x8157, 0x1326, 0x8267, 0x1146},
-            {0x8337, 0x4223, 0x6201, 0x2245, 0x8157, 0x1326, 0x8267, 0x1146},
-            {0x4223, 0x5102, 0x3304, 0x2245, 0x8157, 0x8337, 0x1326, 0x8267, 0x1146},
-            {0x8267, 0x1146, 0x5102, 0x4113, 0x8337, 0x2315, 0x2245, 0x8157},
-            {0x6201, 0x4113, 0x8337, 0x8267, 0x1146, 0x3304, 0x2315, 0x2245, 0x8157},
-            {0x8337, 0x8267, 0x1146, 0x5102, 0x6201, 0x2245, 0x8157},
-            {0x3304, 0x2245, 0x8157, 0x8337, 0x8267, 0x1146},
-            {0x8157, 0x2315, 0x3304, 0x1326, 0x8267},
-            {0x8267, 0x8157, 0x2315, 0x6201, 0x5102, 0x1326},
-            {0x8267, 0x1326, 0x3304, 0x6201, 0x4113, 0x8157},
-            {0x8267, 0x8157, 0x4113, 0x5102, 0x1326},
-            {0x5102, 0x4223, 0x8267, 0x8157, 0x2315, 0x3304},
-            {0x2315, 0x6201, 0x4223, 0x8267, 0x8157},
-            {0x3304, 0x5102, 0x4223, 0x8267, 0x8157, 0x4113, 0x6201},
-            {0x4113, 0x4223, 0x8267, 0x8157},
-            {0x8157, 0x2315, 0x3304, 0x1326, 0x8267, 0x4223, 0x4113, 0x8337},
-            {0x8157, 0x2315, 0x6201, 0x5102, 0x1326, 0x8267, 0x4223, 0x4113, 0x8337},
-            {0x8157, 0x8337, 0x4223, 0x6201, 0x3304, 0x1326, 0x8267},
-            {0x5102, 0x1326, 0x8267, 0x8157, 0x8337, 0x4223},
-            {0x8267, 0x8157, 0x2315, 0x3304, 0x5102, 0x4113, 0x8337},
-            {0x6201, 0x4113, 0x8337, 0x8267, 0x8157, 0x2315},
-            {0x6201, 0x3304, 0x5102, 0x8337, 0x8267, 0x8157},
-            {0x8337, 0x8267, 0x8157},
-            {0x8337, 0x8157, 0x8267},
-            {0x6201, 0x5102, 0x3304, 0x8337, 0x8157, 0x8267},
-            {0x6201, 0x2315, 0x4113, 0x8337, 0x8157, 0x8267},
-            {0x5102, 0x3304, 0x2315, 0x4113, 0x8337, 0x8157, 0x8267},
-            {0x5102, 0x4223, 0x1326, 0x8337, 0x8157, 0x8267},
-            {0x6201, 0x4223, 0x1326, 0x3304, 0x8337, 0x8157, 0x8267},
-            {0x6201, 0x2315, 0x4113, 0x5102, 0x4223, 0x1326, 0x8337, 0x8157, 0x8267},
-            {0x4223, 0x1326, 0x3304, 0x2315, 0x4113, 0x8337, 0x8157, 0x8267},
-            {0x4113, 0x8157, 0x8267, 0x4223},
-            {0x4223, 0x4113, 0x8157, 0x8267, 0x6201, 0x5102, 0x3304},
-            {0x8157, 0x8267, 0x4223, 0x6201, 0x2315},
-            {0x3304, 0x2315, 0x8157, 0x8267, 0x4223, 0x5102},
-            {0x1326, 0x5102, 0x4113, 0x8157, 0x8267},
-            {0x8157, 0x4113, 0x6201, 0x3304, 0x1326, 0x8267},
-            {0x1326, 0x5102, 0x6201, 0x2315, 0x8157, 0x8267},
-            {0x8267, 0x1326, 0x3304, 0x2315, 0x8157},
-            {0x3304, 0x1146, 0x2245, 0x8337, 0x8157, 0x8267},
-            {0x6201, 0x5102, 0x1146, 0x2245, 0x8337, 0x8157, 0x8267},
-            {0x6201, 0x2315, 0x4113, 0x3304, 0x1146, 0x2245, 0x8337, 0x8157, 0x8267},
-            {0x2315, 0x4113, 0x5102, 0x1146, 0x2245, 0x8337, 0x8157, 0x8267},
-            {0x5102, 0x4223, 0x1326, 0x3304, 0x1146, 0x2245, 0x8337, 0x8157, 0x8267},
-            {0x1146, 0x2245, 0x6201, 0x4223, 0x1326, 0x8337, 0x8157, 0x8267},
-            {0x6201, 0x2315, 0x4113, 0x5102, 0x4223, 0x1326, 0x3304, 0x1146, 0x2245, 0x8337, 0x8157, 0x8267},
-            {0x4113, 0x4223, 0x1326, 0x1146, 0x2245, 0x2315, 0x8337, 0x8157, 0x8267},
-            {0x4223, 0x4113, 0x8157, 0x8267, 0x3304, 0x1146, 0x2245},
-            {0x6201, 0x5102, 0x1146, 0x2245, 0x4223, 0x4113, 0x8157, 0x8267},
-            {0x8157, 0x8267, 0x4223, 0x6201, 0x2315, 0x3304, 0x1146, 0x2245},
-            {0x2315, 0x8157, 0x8267, 0x4223, 0x5102, 0x1146, 0x2245},
-            {0x1326, 0x5102, 0x4113, 0x8157, 0x8267, 0x3304, 0x1146, 0x2245},
-            {0x1326, 0x1146, 0x2245, 0x6201, 0x4113, 0x8157, 0x8267},
-            {0x5102, 0x6201, 0x2315, 0x8157, 0x8267, 0x1326, 0x3304, 0x1146, 0x2245},
-            {0x1326, 0x1146, 0x2245, 0x2315, 0x8157, 0x8267},
-            {0x2315, 0x2245, 0x8267, 0x8337},
-            {0x2315, 0x2245, 0x8267, 0x8337, 0x6201, 0x5102, 0x3304},
-            {0x4113, 0x6201, 0x2245, 0x8267, 0x8337},
-            {0x5102, 0x4113, 0x8337, 0x8267, 0x2245, 0x3304},
-            {0x2315, 0x2245, 0x8267, 0x8337, 0x5102, 0x4223, 0x1326},
-            {0x6201, 0x4223, 0x1326, 0x3304, 0x8337, 0x2315, 0x2245, 0x8267},
-            {0x4113, 0x6201, 0x2245, 0x8267, 0x8337, 0x5102, 0x4223, 0x1326},
-            {0x4113, 0x4223, 0x1326, 0x3304, 0x2245, 0x8267, 0x8337},
-            {0x2315, 0x2245, 0x8267, 0x4223, 0x4113},
-            {0x2315, 0x2245, 0x8267, 0x4223, 0x4113, 0x6201, 0x5102, 0x3304},
-            {0x6201, 0x2245, 0x8267, 0x4223},
-            {0x3304, 0x2245, 0x8267, 0x4223, 0x5102},
-            {0x5102, 0x4113, 0x2315, 0x2245, 0x8267, 0x1326},
-            {0x4113, 0x2315, 0x2245, 0x8267, 0x1326, 0x3304, 0x6201},
-            {0x5102, 0x6201, 0x2245, 0x8267, 0x1326},
-            {0x3304, 0x2245, 0x8267, 0x1326},
-            {0x8267, 0x8337, 0x2315, 0x3304, 0x1146},
-            {0x5102, 0x1146, 0x8267, 0x8337, 0x2315, 0x6201},
-            {0x3304, 0x1146, 0x8267, 0x8337, 0x4113, 0x6201},
-            {0x8337, 0x4113, 0x5102, 0x1146, 0x8267},
-            {0x8267, 0x8337, 0x2315, 0x3304, 0x1146, 0x5102, 0x4223, 0x1326},
-            {0x1146, 0x8267, 0x8337, 0x2315, 0x6201, 0x4223, 0x1326},
-            {0x8267, 0x8337, 0x4113, 0x6201, 0x3304, 0x1146, 0x5102, 0x4223, 0x1326},
-            {0x4113, 0x4223, 0x1326, 0x1146, 0x8267, 0x8337},
-            {0x3304, 0x2315, 0x4113, 0x4223, 0x8267, 0x1146},
-            {0x2315, 0x6201, 0x5102, 0x1146, 0x8267, 0x4223, 0x4113},
-            {0x1146, 0x8267, 0x4223, 0x6201, 0x3304},
-            {0x5102, 0x1146, 0x8267, 0x4223},
-            {0x8267, 0x1326, 0x5102, 0x4113, 0x2315, 0x3304, 0x1146},
-            {0x6201, 0x4113, 0x2315, 0x1326, 0x1146, 0x8267},
-            {0x6201, 0x3304, 0x1146, 0x8267, 0x1326, 0x5102},
-            {0x1326, 0x1146, 0x8267},
-            {0x1326, 0x8337, 0x8157, 0x1146},
-            {0x8337, 0x8157, 0x1146, 0x1326, 0x6201, 0x5102, 0x3304},
-            {0x8337, 0x8157, 0x1146, 0x1326, 0x6201, 0x2315, 0x4113},
-            {0x4113, 0x5102, 0x3304, 0x2315, 0x1326, 0x8337, 0x8157, 0x1146},
-            {0x8337, 0x8157, 0x1146, 0x5102, 0x4223},
-            {0x6201, 0x4223, 0x8337, 0x8157, 0x1146, 0x3304},
-            {0x8337, 0x8157, 0x1146, 0x5102, 0x4223, 0x6201, 0x2315, 0x4113},
-            {0x4223, 0x8337, 0x8157, 0x1146, 0x3304, 0x2315, 0x4113},
-            {0x4223, 0x4113, 0x8157, 0x1146, 0x1326},
-            {0x4223, 0x4113, 0x8157, 0x1146, 0x1326, 0x6201, 0x5102, 0x3304},
-            {0x1146, 0x8157, 0x2315, 0x6201, 0x4223, 0x1326},
-            {0x4223, 0x5102, 0x3304, 0x2315, 0x8157, 0x1146, 0x1326},
-            {0x4113, 0x8157, 0x1146, 0x5102},
-            {0x6201, 0x4113, 0x8157, 0x1146, 0x3304},
-            {0x2315, 0x8157, 0x1146, 0x5102, 0x6201},
-            {0x2315, 0x8157, 0x1146, 0x3304},
-            {0x2245, 0x3304, 0x1326, 0x8337, 0x8157},
-            {0x6201, 0x2245, 0x8157, 0x8337, 0x1326, 0x5102},
-            {0x2245, 0x3304, 0x1326, 0x8337, 0x8157, 0x6201, 0x2315, 0x4113},
-            {0x2245, 0x2315, 0x4113, 0x5102, 0x1326, 0x8337, 0x8157},
-            {0x4223, 0x8337, 0x8157, 0x2245, 0x3304, 0x5102},
-            {0x8157, 0x2245, 0x6201, 0x4223, 0x8337},
-            {0x2245, 0x3304, 0x5102, 0x4223, 0x8337, 0x8157, 0x4113, 0x6201, 0x2315},
-            {0x4223, 0x8337, 0x8157, 0x2245, 0x2315, 0x4113},
-            {0x4113, 0x8157, 0x2245, 0x3304, 0x1326, 0x4223},
-            {0x1326, 0x4223, 0x4113, 0x8157, 0x2245, 0x6201, 0x5102},
-            {0x8157, 0x2245, 0x3304, 0x1326, 0x4223, 0x6201, 0x2315},
-            {0x5102, 0x1326, 0x4223, 0x2315, 0x8157, 0x2245},
-            {0x3304, 0x5102, 0x4113, 0x8157, 0x2245},
-            {0x4113, 0x8157, 0x2245, 0x6201},
-            {0x5102, 0x6201, 0x2315, 0x8157, 0x2245, 0x3304},
-            {0x2315, 0x8157, 0x2245},
-            {0x1146, 0x1326, 0x8337, 0x2315, 0x2245},
-            {0x1146, 0x1326, 0x8337, 0x2315, 0x2245, 0x6201, 0x5102, 0x3304},
-            {0x6201, 0x2245, 0x1146, 0x1326, 0x8337, 0x4113},
-            {0x2245, 0x1146, 0x1326, 0x8337, 0x4113, 0x5102, 0x3304},
-            {0x5102, 0x1146, 0x2245, 0x2315, 0x8337, 0x4223},
-            {0x1146, 0x3304, 0x6201, 0x4223, 0x8337, 0x2315, 0x2245},
-            {0x8337, 0x4113, 0x6201, 0x2245, 0x1146, 0x5102, 0x4223},
-            {0x4223, 0x8337, 0x4113, 0x3304, 0x2245, 0x1146},
-            {0x4113, 0x2315, 0x2245, 0x1146, 0x1326, 0x4223},
-            {0x1146, 0x1326, 0x4223, 0x4113, 0x2315, 0x2245, 0x6201, 0x5102, 0x3304},
-            {0x1326, 0x4223, 0x6201, 0x2245, 0x1146},
-            {0x4223, 0x5102, 0x3304, 0x2245, 0x1146, 0x1326},
-            {0x2245, 0x1146, 0x5102, 0x4113, 0x2315},
-            {0x4113, 0x2315, 0x2245, 0x1146, 0x3304, 0x6201},
-            {0x6201, 0x2245, 0x1146, 0x5102},
-            {0x3304, 0x2245, 0x1146},
-            {0x3304, 0x1326, 0x8337, 0x2315},
-            {0x5102, 0x1326, 0x8337, 0x2315, 0x6201},
-            {0x6201, 0x3304, 0x1326, 0x8337, 0x4113},
-            {0x5102, 0x1326, 0x8337, 0x4113},
-            {0x4223, 0x8337, 0x2315, 0x3304, 0x5102},
-            {0x6201, 0x4223, 0x8337, 0x2315},
-            {0x3304, 0x5102, 0x4223, 0x8337, 0x4113, 0x6201},
-            {0x4113, 0x4223, 0x8337},
-            {0x4113, 0x2315, 0x3304, 0x1326, 0x4223},
-            {0x1326, 0x4223, 0x4113, 0x2315, 0x6201, 0x5102},
-            {0x3304, 0x1326, 0x4223, 0x6201},
-            {0x5102, 0x1326, 0x4223},
-            {0x5102, 0x4113, 0x2315, 0x3304},
-            {0x6201, 0x4113, 0x2315},
-            {0x6201, 0x3304, 0x5102},
-            {}
+            NEGATIVE_X = 1 << 0,
+            POSITIVE_X = 1 << 1,
+            NEGATIVE_Y = 1 << 2,
+            POSITIVE_Y = 1 << 3,
+            NEGATIVE_Z = 1 << 4,
+            POSITIVE_Z = 1 << 5
         };
 
-    public:
         /** Delete copy constructor */
         MarchingCubes(const MarchingCubes&) = delete;
 
@@ -388,6 +94,123 @@ namespace MarchingCubes
          */
         void GetMesh(std::function<float(float, float, float)> signedDistanceFunc, const AABB& bounds, float cellSize, std::vector<Triangle>& outputTriangles);
 
+        /**
+         * @brief Gets the resulting mesh upon performing marching cubes.
+         *
+         * Accepts any callable taking (x, y, z) and returning the signed distance,
+         * so that the function can be inlined into the sampling loop.
+         * @param[in] signedDistanceFunc Signed distance function
+         * @param[in] bounds Shape bounds
+         * @param[in] cellSize Cell size
+         * @param[out] outputTriangles Vector where the triangles will be placed
+         */
+        template <typename DensityFunc>
+        void GetMesh(DensityFunc&& signedDistanceFunc, const AABB& bounds, float cellSize, std::vector<Triangle>& outputTriangles);
+
+        /**
+         * @brief Gets the resulting mesh upon performing marching cubes, splitting the bounds into z-slabs processed in parallel.
+         *
+         * The slabs are concatenated in order, so the output is identical to the
+         * single-threaded GetMesh for any number of threads.
+         * The density function is called from several threads at once.
+         * @param[in] signedDistanceFunc Signed distance function
+         * @param[in] bounds Shape bounds
+         * @param[in] cellSize Cell size
+         * @param[out] outputTriangles Vector where the triangles will be placed
+         * @param[in] numThreads Number of threads to use
+         */
+        template <typename DensityFunc>
+        void GetMesh(DensityFunc&& signedDistanceFunc, const AABB& bounds, float cellSize, std::vector<Triangle>& outputTriangles, int numThreads);
+
+        /**
+         * @brief Gets the meshes of several isovalues of the same function, sampling it only once.
+         *
+         * The lattice is traversed once, every row of cells being classified and triangulated
+         * for each isovalue in turn while it is in the cache.
+         * @param[in] signedDistanceFunc Signed distance function
+         * @param[in] bounds Shape bounds
+         * @param[in] cellSize Cell size
+         * @param[in] isovalues Function values of the surfaces. Values above an isovalue are inside its surface.
+         * @param[out] outputMeshes Vectors where the triangles of each isovalue will be placed, in the same order as the isovalues
+         */
+        template <typename DensityFunc>
+        void GetMeshes(DensityFunc&& signedDistanceFunc, const AABB& bounds, float cellSize, const std::vector<float>& isovalues, std::vector<std::vector<Triangle>>& outputMeshes);
+
+        /**
+         * @brief Gets the resulting indexed mesh upon performing marching cubes.
+         *
+         * Vertices shared by neighboring cells are only created once, using the
+         * vertex reuse data from the Transvoxel tables.
+         * @param[in] signedDistanceFunc Signed distance function
+         * @param[in] bounds Shape bounds
+         * @param[in] cellSize Cell size
+         * @param[out] outputVertices Vector where the vertex positions will be placed
+         * @param[out] outputIndices Vector where the triangle vertex indices will be placed
+         * @return True if successful. False if the vertex count exceeds the range of the index type.
+         */
+        bool GetIndexedMesh(std::function<float(float, float, float)> signedDistanceFunc, const AABB& bounds, float cellSize, std::vector<glm::vec3>& outputVertices, std::vector<uint32_t>& outputIndices);
+
+        /**
+         * @brief Gets the resulting indexed mesh upon performing marching cubes, using 16-bit indices.
+         * @param[in] signedDistanceFunc Signed distance function
+         * @param[in] bounds Shape bounds
+         * @param[in] cellSize Cell size
+         * @param[out] outputVertices Vector where the vertex positions will be placed
+         * @param[out] outputIndices Vector where the triangle vertex indices will be placed
+         * @return True if successful. False if the vertex count exceeds the range of the index type.
+         */
+        bool GetIndexedMesh(std::function<float(float, float, float)> signedDistanceFunc, const AABB& bounds, float cellSize, std::vector<glm::vec3>& outputVertices, std::vector<uint16_t>& outputIndices);
+
+        /**
+         * @brief Gets the resulting indexed mesh upon performing marching cubes, for any callable and index type.
+         * @param[in] signedDistanceFunc Signed distance function
+         * @param[in] bounds Shape bounds
+         * @param[in] cellSize Cell size
+         * @param[out] outputVertices Vector where the vertex positions will be placed
+         * @param[out] outputIndices Vector where the triangle vertex indices will be placed
+         * @param[in] transitionFaces Combination of TransitionFace flags. The cells along these faces become
+         *                            transition cells, which match a mesh with half the cell size on the other side.
+         * @return True if successful. False if the vertex count exceeds the range of the index type.
+         */
+        template <typename DensityFunc, typename IndexType>
+        bool GetIndexedMesh(DensityFunc&& signedDistanceFunc, const AABB& bounds, float cellSize, std::vector<glm::vec3>& outputVertices, std::vector<IndexType>& outputIndices, int transitionFaces = 0);
+
+        /**
+         * @brief Gets the resulting indexed mesh upon performing marching cubes, with smooth vertex normals.
+         *
+         * The normals are the central-difference gradients of the sampled function, interpolated
+         * along the edges like the positions. The function is sampled with a one-cell apron
+         * around the bounds, so normals match across the borders of adjacent meshes.
+         * @param[in] signedDistanceFunc Signed distance function
+         * @param[in] bounds Shape bounds
+         * @param[in] cellSize Cell size
+         * @param[out] outputVertices Vector where the vertex positions will be placed
+         * @param[out] outputNormals Vector where the vertex normals will be placed, parallel to outputVertices
+         * @param[out] outputIndices Vector where the triangle vertex indices will be placed
+         * @param[in] transitionFaces Combination of TransitionFace flags. The cells along these faces become
+         *                            transition cells, which match a mesh with half the cell size on the other side.
+         * @return True if successful. False if the vertex count exceeds the range of the index type.
+         */
+        template <typename DensityFunc, typename IndexType>
+        bool GetIndexedMesh(DensityFunc&& signedDistanceFunc, const AABB& bounds, float cellSize, std::vector<glm::vec3>& outputVertices, std::vector<glm::vec3>& outputNormals, std::vector<IndexType>& outputIndices, int transitionFaces = 0);
+
+        /**
+         * @brief Gets the resulting indexed mesh upon performing marching cubes, writing the vertices into a vertex sink.
+         *
+         * The vertices go straight into the caller's own buffer and layout, see VertexSink.hpp.
+         * Their normals are computed like with GetIndexedMesh, if the sink needs them.
+         * @param[in] signedDistanceFunc Signed distance function
+         * @param[in] bounds Shape bounds
+         * @param[in] cellSize Cell size
+         * @param[out] outputVertices Vertex sink where the vertices will be written
+         * @param[out] outputIndices Vector where the triangle vertex indices will be placed
+         * @param[in] transitionFaces Combination of TransitionFace flags. The cells along these faces become
+         *                            transition cells, which match a mesh with half the cell size on the other side.
+         * @return True if successful. False if the vertex count exceeds the range of the index type.
+         */
+        template <typename DensityFunc, typename VertexSink, typename IndexType>
+        bool WriteIndexedMesh(DensityFunc&& signedDistanceFunc, const AABB& bounds, float cellSize, VertexSink& outputVertices, std::vector<IndexType>& outputIndices, int transitionFaces = 0);
+
         /**
          * @brief Gets the cell triangles based on the resulting cell configuration calculated from the provided function
          * @param[in] signedDistanceFunc Signed distance function
@@ -396,14 +219,780 @@ namespace MarchingCubes
          * @param[in] cellZ Z-position of the cell
          * @param[in] cellSize Cell size
          * @param[out] outputTriangles Vector where the triangles will be placed 
+         * @param[in] isovalue Function value of the surface. Values above it are inside.
          */
-        void GetCellTriangles(std::function<float(float, float, float)> signedDistanceFunc, float cellX, float cellY, float cellZ, float cellSize, std::vector<Triangle>& outputTriangles);
+        void GetCellTriangles(std::function<float(float, float, float)> signedDistanceFunc, float cellX, float cellY, float cellZ, float cellSize, std::vector<Triangle>& outputTriangles, float isovalue = 0.0f);
+
+        /**
+         * @brief Gets the number of cells that fit in the provided bounds along each axis
+         * @param[in] bounds Shape bounds
+         * @param[in] cellSize Cell size
+         * @return Number of cells along each axis
+         */
+        static glm::ivec3 GetCellCount(const AABB& bounds, float cellSize);
 
     private:
         /**
          * @brief Constructor
          */
         MarchingCubes();
+
+        /**
+         * @brief Samples the provided function at every grid corner inside the bounds
+         *
+         * If the function provides GetDensityRange, the blocks where it provably keeps its sign
+         * are not sampled, and their grid corners only get a value of the right sign. If it provides
+         * EvaluateSignBatch, it may only get the sign right at the grid corners the meshers do not read.
+         * If it provides GetLatticePart, that part is evaluated once for the whole lattice.
+         * @param[in] signedDistanceFunc Signed distance function
+         * @param[in] origin Position of the first grid corner
+         * @param[in] cellSize Cell size
+         * @param[in] numCells Number of cells along each axis
+         * @param[out] outputValues Vector where the (numCells + 1)^3 samples will be placed, x varying fastest
+         * @param[in] numThreads Number of threads sampling the z-slabs in parallel
+         * @param[in] maxIsovalue Highest isovalue the meshers read the samples for, from 0. The function must only
+         *                        get the sign right where it is on the same side of all of them.
+         * @param[in] transitionFaces Combination of TransitionFace flags. Transition cells read every grid corner
+         *                            on these faces, so they are all sampled exactly.
+         * @param[in] apronSize Number of cells between the lattice bounds and the transition faces
+         */
+        template <typename DensityFunc>
+        static void SampleLattice(DensityFunc& signedDistanceFunc, const glm::vec3& origin, float cellSize, const glm::ivec3& numCells, std::vector<float>& outputValues, int numThreads = 1, float maxIsovalue = 0.0f, int transitionFaces = 0, int apronSize = 0);
+
+        /**
+         * @brief Gets the cell triangles based on the already sampled values at the cell corners
+         * @param[in] caseIndex Case index of the cell
+         * @param[in] values Function values at the 8 cell corners
+         * @param[in] cellPosition Position of the cell's minimum corner
+         * @param[in] cellSize Cell size
+         * @param[out] outputTriangles Array where the triangles will be placed. Must have room for 5 triangles.
+         * @return Number of triangles placed in the array
+         */
+        int PolygonizeCell(int caseIndex, const float values[8], const glm::vec3& cellPosition, float cellSize, Triangle* outputTriangles);
+
+        /**
+         * @brief Finds all the cells in a sampled lattice that the surface passes through
+         * @param[in] lattice Sampled lattice
+         * @param[in] numCells Number of cells along each axis
+         * @param[in] zBegin Z-index of the first cell slab to search
+         * @param[in] zEnd One past the z-index of the last cell slab to search
+         * @param[out] outputActiveCells Vector where the active cells will be placed, in x, y, z order
+         * @return Total number of triangles produced by the active cells
+         */
+        size_t GetActiveCells(const std::vector<float>& lattice, const glm::ivec3& numCells, int zBegin, int zEnd, std::vector<ActiveCell>& outputActiveCells);
+
+        /**
+         * @brief Triangulates active cells of a sampled lattice
+         * @param[in] lattice Sampled lattice
+         * @param[in] origin Position of the first grid corner
+         * @param[in] cellSize Cell size
+         * @param[in] numCells Number of cells along each axis
+         * @param[in] activeCells Active cells
+         * @param[out] outputTriangles Array where the triangles will be placed. Must have room for all of them.
+         */
+        void PolygonizeActiveCells(const std::vector<float>& lattice, const glm::vec3& origin, float cellSize, const glm::ivec3& numCells, const std::vector<ActiveCell>& activeCells, Triangle* outputTriangles);
+
+        /**
+         * @brief Triangulates a sampled lattice into an indexed mesh
+         * @param[in] lattice Sampled lattice
+         * @param[in] apronLattice Lattice sampled with a one-cell apron, used for the normals. Can be null.
+         * @param[in] origin Position of the first grid corner
+         * @param[in] cellSize Cell size
+         * @param[in] numCells Number of cells along each axis
+         * @param[out] outputVertices Vertex sink where the vertices will be written. The normals are only set if apronLattice is given.
+         * @param[out] outputIndices Vector where the triangle vertex indices will be placed
+         * @return True if successful. False if the vertex count exceeds the range of the index type.
+         */
+        template <typename VertexSink, typename IndexType>
+        bool PolygonizeIndexed(const std::vector<float>& lattice, const std::vector<float>* apronLattice, const glm::vec3& origin, float cellSize, const glm::ivec3& numCells, VertexSink& outputVertices, std::vector<IndexType>& outputIndices);
+
+        /**
+         * @brief Triangulates a sampled lattice into an indexed mesh, with transition cells along some of its faces
+         * @param[in] signedDistanceFunc Signed distance function, used to sample the transition faces at half the cell size
+         * @param[in] lattice Sampled lattice
+         * @param[in] apronLattice Lattice sampled with a one-cell apron, used for the normals. Can be null.
+         * @param[in] origin Position of the first grid corner
+         * @param[in] cellSize Cell size
+         * @param[in] numCells Number of cells along each axis
+         * @param[in] transitionFaces Combination of TransitionFace flags
+         * @param[out] outputVertices Vertex sink where the vertices will be written. The normals are only set if apronLattice is given.
+         * @param[out] outputIndices Vector where the triangle vertex indices will be placed
+         * @return True if successful. False if the vertex count exceeds the range of the index type.
+         */
+        template <typename DensityFunc, typename VertexSink, typename IndexType>
+        bool PolygonizeWithTransitions(DensityFunc& signedDistanceFunc, const std::vector<float>& lattice, const std::vector<float>* apronLattice, const glm::vec3& origin, float cellSize, const glm::ivec3& numCells, int transitionFaces, VertexSink& outputVertices, std::vector<IndexType>& outputIndices);
+
+        /**
+         * @brief Triangulates the transition cells along the transition faces
+         * @param[in] lattice Sampled lattice
+         * @param[in] apronLattice Lattice sampled with a one-cell apron, used for the normals. Can be null.
+         * @param[in] faceSamples Samples at half the cell size around the transition faces, see GetTransitionFaceBlock
+         * @param[in] origin Position of the first grid corner
+         * @param[in] cellSize Cell size
+         * @param[in] numCells Number of cells along each axis
+         * @param[in] transitionFaces Combination of TransitionFace flags
+         * @param[out] outputVertices Vector where the vertex positions will be placed
+         * @param[out] outputNormals Vector where the vertex normals will be placed. Only used if apronLattice is given.
+         * @param[out] outputIndices Vector where the triangle vertex indices will be placed, relative to the first output vertex
+         */
+        void PolygonizeTransitionCells(const std::vector<float>& lattice, const std::vector<float>* apronLattice, const std::vector<float>& faceSamples, const glm::vec3& origin, float cellSize, const glm::ivec3& numCells, int transitionFaces, std::vector<glm::vec3>& outputVertices, std::vector<glm::vec3>* outputNormals, std::vector<uint32_t>& outputIndices) const;
+
+        /**
+         * @brief Gets the block of half-size grid points sampled around a transition face.
+         *
+         * The block is one point thick on each side of the face and one point wider than it,
+         * so central differences are available on the face. Coordinates are in half cells from the origin.
+         * @param[in] numCells Number of cells along each axis
+         * @param[in] face Index of the face, the bit index of its TransitionFace flag
+         * @param[out] outputMin First point of the block
+         * @param[out] outputSize Number of points along each axis
+         */
+        static void GetTransitionFaceBlock(const glm::ivec3& numCells, int face, glm::ivec3& outputMin, glm::ivec3& outputSize);
+
+        /**
+         * @brief Copies a box out of a sampled lattice
+         * @param[in] lattice Sampled lattice
+         * @param[in] numSamples Number of samples along each axis of the lattice
+         * @param[in] begin First sample of the box
+         * @param[in] boxNumSamples Number of samples along each axis of the box
+         * @param[out] outputValues Vector where the samples of the box will be placed, x varying fastest
+         */
+        static void ExtractSubLattice(const std::vector<float>& lattice, const glm::ivec3& numSamples, const glm::ivec3& begin, const glm::ivec3& boxNumSamples, std::vector<float>& outputValues);
+
+        /**
+         * @brief Gets the exact number of vertices GetIndexedMesh creates for the provided active cells
+         * @param[in] activeCells Active cells
+         * @return Number of vertices
+         */
+        size_t GetIndexedVertexCount(const std::vector<ActiveCell>& activeCells);
+
+        /**
+         * @brief Classifies a row of cells in a sampled lattice
+         * @param[in] lattice Sampled lattice
+         * @param[in] numCells Number of cells along each axis
+         * @param[in] y Y-index of the cell row
+         * @param[in] z Z-index of the cell row
+         * @param[out] outputCases Array where the case indices of the row will be placed
+         * @param[out] outputActiveCells Array where the x-indices of the cells intersecting the surface will be placed
+         * @return Number of cells intersecting the surface
+         */
+        static int ClassifyLatticeRow(const std::vector<float>& lattice, const glm::ivec3& numCells, int y, int z, unsigned char* outputCases, int* outputActiveCells);
+
+        /**
+         * @brief Gets the offsets of the 8 cell corners inside a sampled lattice
+         * @param[in] numCells Number of cells along each axis
+         * @param[out] outputOffsets Array where the corner offsets will be placed
+         */
+        void GetCornerOffsets(const glm::ivec3& numCells, int outputOffsets[8]) const;
+
+        /**
+         * @brief Gets the position of a vertex on a cell edge, interpolated from the corner values
+         * @param[in] values Function values at the 8 cell corners
+         * @param[in] cellPosition Position of the cell's minimum corner
+         * @param[in] cellSize Cell size
+         * @param[in] vertexData Vertex data of the flattened case
+         * @return Vertex position
+         */
+        glm::vec3 GetEdgeVertex(const float values[8], const glm::vec3& cellPosition, float cellSize, unsigned short vertexData) const;
+
+        /**
+         * @brief Gets the normal of a vertex on a cell edge, interpolated from the gradients at the edge corners
+         * @param[in] apronLattice Lattice sampled with a one-cell apron
+         * @param[in] numCells Number of cells along each axis, excluding the apron
+         * @param[in] cell Indices of the cell
+         * @param[in] values Function values at the 8 cell corners
+         * @param[in] vertexData Vertex data of the flattened case
+         * @return Unit vertex normal, pointing away from the positive side of the function
+         */
+        glm::vec3 GetEdgeNormal(const std::vector<float>& apronLattice, const glm::ivec3& numCells, const glm::ivec3& cell, const float values[8], unsigned short vertexData) const;
+
+        /**
+         * @brief Gets the unnormalized gradient at a grid corner, by central differences
+         * @param[in] apronLattice Lattice sampled with a one-cell apron
+         * @param[in] numCells Number of cells along each axis, excluding the apron
+         * @param[in] corner Indices of the grid corner
+         * @return Gradient, scaled by twice the cell size
+         */
+        static glm::vec3 GetLatticeGradient(const std::vector<float>& apronLattice, const glm::ivec3& numCells, const glm::ivec3& corner);
     };
-}
 
+    /**
+     * @brief Gets the resulting mesh upon performing marching cubes.
+     *
+     * Accepts any callable taking (x, y, z) and returning the signed distance,
+     * so that the function can be inlined into the sampling loop.
+     * @param[in] signedDistanceFunc Signed distance function
+     * @param[in] bounds Shape bounds
+     * @param[in] cellSize Cell size
+     * @param[out] outputTriangles Vector where the triangles will be placed
+     */
+    template <typename DensityFunc>
+    void MarchingCubes::GetMesh(DensityFunc&& signedDistanceFunc, const AABB& bounds, float cellSize, std::vector<Triangle>& outputTriangles)
+    {
+        glm::ivec3 numCells = GetCellCount(bounds, cellSize);
+        if ((numCells.x <= 0) || (numCells.y <= 0) || (numCells.z <= 0))
+        {
+            return;
+        }
+
+        // Every grid corner is shared by up to 8 cells, so we evaluate the
+        // function once per corner and let the cells read from the lattice.
+        std::vector<float> lattice;
+        SampleLattice(signedDistanceFunc, bounds.min, cellSize, numCells, lattice);
+
+        // First pass: find the cells that the surface passes through, and
+        // how many triangles they produce, so the output is only allocated once.
+        std::vector<ActiveCell> activeCells;
+        size_t numTriangles = GetActiveCells(lattice, numCells, 0, numCells.z, activeCells);
+
+        size_t triangleIndex = outputTriangles.size();
+        outputTriangles.resize(triangleIndex + numTriangles);
+
+        // Second pass: triangulate the active cells
+        PolygonizeActiveCells(lattice, bounds.min, cellSize, numCells, activeCells, outputTriangles.data() + triangleIndex);
+    }
+
+    /**
+     * @brief Gets the resulting mesh upon performing marching cubes, splitting the bounds into z-slabs processed in parallel.
+     *
+     * The slabs are concatenated in order, so the output is identical to the
+     * single-threaded GetMesh for any number of threads.
+     * The density function is called from several threads at once.
+     * @param[in] signedDistanceFunc Signed distance function
+     * @param[in] bounds Shape bounds
+     * @param[in] cellSize Cell size
+     * @param[out] outputTriangles Vector where the triangles will be placed
+     * @param[in] numThreads Number of threads to use
+     */
+    template <typename DensityFunc>
+    void MarchingCubes::GetMesh(DensityFunc&& signedDistanceFunc, const AABB& bounds, float cellSize, std::vector<Triangle>& outputTriangles, int numThreads)
+    {
+        glm::ivec3 numCells = GetCellCount(bounds, cellSize);
+        if ((numCells.x <= 0) || (numCells.y <= 0) || (numCells.z <= 0))
+        {
+            return;
+        }
+
+        std::vector<float> lattice;
+        SampleLattice(signedDistanceFunc, bounds.min, cellSize, numCells, lattice, numThreads);
+
+        // Slabs are fixed up front so each one knows where its triangles go
+        // once the counts are known
+        const int numSlabs = std::max(1, std::min(numThreads, numCells.z));
+        std::vector<std::vector<ActiveCell>> slabActiveCells(numSlabs);
+        std::vector<size_t> slabTriangleOffsets(numSlabs + 1, 0);
+
+        ParallelFor(0, numSlabs, numSlabs, [&](int slabBegin, int slabEnd)
+        {
+            for (int slab = slabBegin; slab < slabEnd; ++slab)
+            {
+                const int zBegin = static_cast<int>(static_cast<long long>(numCells.z) * slab / numSlabs);
+                const int zEnd = static_cast<int>(static_cast<long long>(numCells.z) * (slab + 1) / numSlabs);
+                slabTriangleOffsets[slab + 1] = GetActiveCells(lattice, numCells, zBegin, zEnd, slabActiveCells[slab]);
+            }
+        });
+
+        size_t triangleIndex = outputTriangles.size();
+        slabTriangleOffsets[0] = triangleIndex;
+        for (int slab = 0; slab < numSlabs; ++slab)
+        {
+            slabTriangleOffsets[slab + 1] += slabTriangleOffsets[slab];
+        }
+        outputTriangles.resize(slabTriangleOffsets[numSlabs]);
+
+        Triangle* triangles = outputTriangles.data();
+        ParallelFor(0, numSlabs, numSlabs, [&](int slabBegin, int slabEnd)
+        {
+            for (int slab = slabBegin; slab < slabEnd; ++slab)
+            {
+                PolygonizeActiveCells(lattice, bounds.min, cellSize, numCells, slabActiveCells[slab], triangles + slabTriangleOffsets[slab]);
+            }
+        });
+    }
+
+    /**
+     * @brief Gets the meshes of several isovalues of the same function, sampling it only once.
+     *
+     * The lattice is traversed once, every row of cells being classified and triangulated
+     * for each isovalue in turn while it is in the cache.
+     * @param[in] signedDistanceFunc Signed distance function
+     * @param[in] bounds Shape bounds
+     * @param[in] cellSize Cell size
+     * @param[in] isovalues Function values of the surfaces. Values above an isovalue are inside its surface.
+     * @param[out] outputMeshes Vectors where the triangles of each isovalue will be placed, in the same order as the isovalues
+     */
+    template <typename DensityFunc>
+    void MarchingCubes::GetMeshes(DensityFunc&& signedDistanceFunc, const AABB& bounds, float cellSize, const std::vector<float>& isovalues, std::vector<std::vector<Triangle>>& outputMeshes)
+    {
+        outputMeshes.resize(isovalues.size());
+
+        glm::ivec3 numCells = GetCellCount(bounds, cellSize);
+        if ((numCells.x <= 0) || (numCells.y <= 0) || (numCells.z <= 0) || isovalues.empty())
+        {
+            return;
+        }
+
+        // The lattice holds the function minus the lowest isovalue, so the other
+        // isovalues are the offsets of their surfaces from 0
+        const float minIsovalue = *std::min_element(isovalues.begin(), isovalues.end());
+        const float maxIsovalue = *std::max_element(isovalues.begin(), isovalues.end());
+        ShiftedDensity<typename std::remove_reference<DensityFunc>::type> shiftedFunc(signedDistanceFunc, minIsovalue, maxIsovalue);
+
+        std::vector<float> lattice;
+        SampleLattice(shiftedFunc, bounds.min, cellSize, numCells, lattice, 1, maxIsovalue - minIsovalue);
+
+        const size_t strideY = numCells.x + 1;
+        const size_t strideZ = strideY * (numCells.y + 1);
+
+        std::vector<float> shiftedRowValues(4 * strideY);
+        std::vector<unsigned char> rowCases(numCells.x);
+        std::vector<int> rowActiveCells(numCells.x);
+        Triangle cellTriangles[5];
+        for (int z = 0; z < numCells.z; ++z)
+        {
+            for (int y = 0; y < numCells.y; ++y)
+            {
+                const size_t rowIndex = y * strideY + z * strideZ;
+
+                // Same order as the corner bits of the case index
+                const float* rows[4] =
+                {
+                    &lattice[rowIndex],
+                    &lattice[rowIndex + strideZ],
+                    &lattice[rowIndex + strideY],
+                    &lattice[rowIndex + strideY + strideZ]
+                };
+
+                // Only the isovalues within the range of the row cross it
+                float rowMin = rows[0][0];
+                float rowMax = rows[0][0];
+                for (int i = 0; i < 4; ++i)
+                {
+                    const std::pair<const float*, const float*> rowRange = std::minmax_element(rows[i], rows[i] + strideY);
+                    rowMin = std::min(rowMin, *rowRange.first);
+                    rowMax = std::max(rowMax, *rowRange.second);
+                }
+
+                for (size_t surface = 0; surface < isovalues.size(); ++surface)
+                {
+                    const float offset = isovalues[surface] - minIsovalue;
+                    if ((rowMin > offset) || (rowMax <= offset))
+                    {
+                        continue;
+                    }
+
+                    const float* shiftedRows[4];
+                    for (int i = 0; i < 4; ++i)
+                    {
+                        float* shiftedRow = &shiftedRowValues[i * strideY];
+                        for (size_t x = 0; x < strideY; ++x)
+                        {
+                            shiftedRow[x] = rows[i][x] - offset;
+                        }
+                        shiftedRows[i] = shiftedRow;
+                    }
+
+                    std::vector<Triangle>& triangles = outputMeshes[surface];
+                    const int numRowActiveCells = ClassifyCellRow(shiftedRows, numCells.x, rowCases.data(), rowActiveCells.data());
+                    for (int i = 0; i < numRowActiveCells; ++i)
+                    {
+                        const int x = rowActiveCells[i];
+
+                        // Corner bits: 1 = x, 2 = z, 4 = y
+                        float values[8];
+                        for (int j = 0; j < 8; ++j)
+                        {
+                            values[j] = shiftedRows[(j >> 1) & 3][x + (j & 1)];
+                        }
+
+                        glm::vec3 cellPosition = bounds.min + glm::vec3(x, y, z) * cellSize;
+                        const int numCellTriangles = PolygonizeCell(rowCases[x], values, cellPosition, cellSize, cellTriangles);
+                        triangles.insert(triangles.end(), cellTriangles, cellTriangles + numCellTriangles);
+                    }
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Gets the resulting indexed mesh upon performing marching cubes, for any callable and index type.
+     * @param[in] signedDistanceFunc Signed distance function
+     * @param[in] bounds Shape bounds
+     * @param[in] cellSize Cell size
+     * @param[out] outputVertices Vector where the vertex positions will be placed
+     * @param[out] outputIndices Vector where the triangle vertex indices will be placed
+     * @param[in] transitionFaces Combination of TransitionFace flags. The cells along these faces become
+     *                        transition cells, which match a mesh with half the cell size on the other side.
+     * @return True if successful. False if the vertex count exceeds the range of the index type.
+     */
+    template <typename DensityFunc, typename IndexType>
+    bool MarchingCubes::GetIndexedMesh(DensityFunc&& signedDistanceFunc, const AABB& bounds, float cellSize, std::vector<glm::vec3>& outputVertices, std::vector<IndexType>& outputIndices, int transitionFaces)
+    {
+        PositionNormalSink vertexSink(outputVertices, nullptr);
+        return WriteIndexedMesh(signedDistanceFunc, bounds, cellSize, vertexSink, outputIndices, transitionFaces);
+    }
+
+    /**
+     * @brief Gets the resulting indexed mesh upon performing marching cubes, with smooth vertex normals.
+     *
+     * The normals are the central-difference gradients of the sampled function, interpolated
+     * along the edges like the positions. The function is sampled with a one-cell apron
+     * around the bounds, so normals match across the borders of adjacent meshes.
+     * @param[in] signedDistanceFunc Signed distance function
+     * @param[in] bounds Shape bounds
+     * @param[in] cellSize Cell size
+     * @param[out] outputVertices Vector where the vertex positions will be placed
+     * @param[out] outputNormals Vector where the vertex normals will be placed, parallel to outputVertices
+     * @param[out] outputIndices Vector where the triangle vertex indices will be placed
+     * @param[in] transitionFaces Combination of TransitionFace flags. The cells along these faces become
+     *                        transition cells, which match a mesh with half the cell size on the other side.
+     * @return True if successful. False if the vertex count exceeds the range of the index type.
+     */
+    template <typename DensityFunc, typename IndexType>
+    bool MarchingCubes::GetIndexedMesh(DensityFunc&& signedDistanceFunc, const AABB& bounds, float cellSize, std::vector<glm::vec3>& outputVertices, std::vector<glm::vec3>& outputNormals, std::vector<IndexType>& outputIndices, int transitionFaces)
+    {
+        PositionNormalSink vertexSink(outputVertices, &outputNormals);
+        return WriteIndexedMesh(signedDistanceFunc, bounds, cellSize, vertexSink, outputIndices, transitionFaces);
+    }
+
+    /**
+     * @brief Gets the resulting indexed mesh upon performing marching cubes, writing the vertices into a vertex sink.
+     *
+     * The vertices go straight into the caller's own buffer and layout, see VertexSink.hpp.
+     * Their normals are computed like with GetIndexedMesh, if the sink needs them.
+     * @param[in] signedDistanceFunc Signed distance function
+     * @param[in] bounds Shape bounds
+     * @param[in] cellSize Cell size
+     * @param[out] outputVertices Vertex sink where the vertices will be written
+     * @param[out] outputIndices Vector where the triangle vertex indices will be placed
+     * @param[in] transitionFaces Combination of TransitionFace flags. The cells along these faces become
+     *                        transition cells, which match a mesh with half the cell size on the other side.
+     * @return True if successful. False if the vertex count exceeds the range of the index type.
+     */
+    template <typename DensityFunc, typename VertexSink, typename IndexType>
+    bool MarchingCubes::WriteIndexedMesh(DensityFunc&& signedDistanceFunc, const AABB& bounds, float cellSize, VertexSink& outputVertices, std::vector<IndexType>& outputIndices, int transitionFaces)
+    {
+        glm::ivec3 numCells = GetCellCount(bounds, cellSize);
+        if ((numCells.x <= 0) || (numCells.y <= 0) || (numCells.z <= 0))
+        {
+            return true;
+        }
+
+        if (!outputVertices.HasNormals())
+        {
+            std::vector<float> lattice;
+            SampleLattice(signedDistanceFunc, bounds.min, cellSize, numCells, lattice, 1, 0.0f, transitionFaces);
+
+            if (transitionFaces != 0)
+            {
+                return PolygonizeWithTransitions(signedDistanceFunc, lattice, nullptr, bounds.min, cellSize, numCells, transitionFaces, outputVertices, outputIndices);
+            }
+            return PolygonizeIndexed(lattice, nullptr, bounds.min, cellSize, numCells, outputVertices, outputIndices);
+        }
+
+        // Central differences at the grid corners on the bounds need the
+        // samples one cell outside of them
+        std::vector<float> apronLattice;
+        SampleLattice(signedDistanceFunc, bounds.min - cellSize, cellSize, numCells + 2, apronLattice, 1, 0.0f, transitionFaces, 1);
+
+        // The triangulation itself only reads the inner lattice
+        std::vector<float> lattice;
+        ExtractSubLattice(apronLattice, numCells + 3, glm::ivec3(1), numCells + 1, lattice);
+
+        if (transitionFaces != 0)
+        {
+            return PolygonizeWithTransitions(signedDistanceFunc, lattice, &apronLattice, bounds.min, cellSize, numCells, transitionFaces, outputVertices, outputIndices);
+        }
+        return PolygonizeIndexed(lattice, &apronLattice, bounds.min, cellSize, numCells, outputVertices, outputIndices);
+    }
+
+    /**
+     * @brief Triangulates a sampled lattice into an indexed mesh
+     * @param[in] lattice Sampled lattice
+     * @param[in] apronLattice Lattice sampled with a one-cell apron, used for the normals. Can be null.
+     * @param[in] origin Position of the first grid corner
+     * @param[in] cellSize Cell size
+     * @param[in] numCells Number of cells along each axis
+     * @param[out] outputVertices Vertex sink where the vertices will be written. The normals are only set if apronLattice is given.
+     * @param[out] outputIndices Vector where the triangle vertex indices will be placed
+     * @return True if successful. False if the vertex count exceeds the range of the index type.
+     */
+    template <typename VertexSink, typename IndexType>
+    bool MarchingCubes::PolygonizeIndexed(const std::vector<float>& lattice, const std::vector<float>* apronLattice, const glm::vec3& origin, float cellSize, const glm::ivec3& numCells, VertexSink& outputVertices, std::vector<IndexType>& outputIndices)
+    {
+        static_assert(std::is_unsigned<IndexType>::value, "Index type must be an unsigned integer");
+
+        std::vector<ActiveCell> activeCells;
+        size_t numTriangles = GetActiveCells(lattice, numCells, 0, numCells.z, activeCells);
+        size_t numVertices = GetIndexedVertexCount(activeCells);
+
+        size_t vertexIndex = outputVertices.GetVertexCount();
+        const size_t maxNumVertices = static_cast<size_t>(std::numeric_limits<IndexType>::max()) + 1;
+        if (vertexIndex + numVertices > maxNumVertices)
+        {
+            return false;
+        }
+
+        outputVertices.Resize(vertexIndex + numVertices);
+
+        size_t indexIndex = outputIndices.size();
+        outputIndices.resize(indexIndex + numTriangles * 3);
+
+        const int strideY = numCells.x + 1;
+        const int strideZ = strideY * (numCells.y + 1);
+
+        int cornerOffsets[8];
+        GetCornerOffsets(numCells, cornerOffsets);
+
+        // Each cell owns the (up to) 3 vertices lying on the edges that meet at its
+        // maximum corner, stored in slots 1 to 3. Cells only reuse vertices from the
+        // preceding cells in x, y, and z, so we only need to keep two z-decks around.
+        const size_t deckSize = static_cast<size_t>(numCells.x) * numCells.y;
+        std::vector<IndexType> vertexCache(2 * deckSize * 4);
+
+        float values[8];
+        IndexType cellVertices[12];
+        for (size_t activeCellIndex = 0; activeCellIndex < activeCells.size(); ++activeCellIndex)
+        {
+            const ActiveCell& cell = activeCells[activeCellIndex];
+            const int baseIndex = cell.x + cell.y * strideY + cell.z * strideZ;
+            for (int i = 0; i < 8; ++i)
+            {
+                values[i] = lattice[baseIndex + cornerOffsets[i]];
+            }
+
+            const RegularCase& cellCase = regularCases.cases[cell.caseIndex];
+
+            glm::vec3 cellPosition = origin + glm::vec3(cell.x, cell.y, cell.z) * cellSize;
+            IndexType* cellCache = &vertexCache[((cell.z & 1) * deckSize + cell.y * numCells.x + cell.x) * 4];
+
+            for (int i = 0; i < cellCase.numVertices; ++i)
+            {
+                const unsigned short vertexData = cellCase.vertexData[i];
+
+                // The high byte holds the direction to the cell owning the vertex
+                // (bit 0: x - 1, bit 1: z - 1, bit 2: y - 1, bit 3: this cell),
+                // and the slot of the vertex in that cell.
+                const int reuseDirection = vertexData >> 12;
+                const int reuseSlot = (vertexData >> 8) & 0x0F;
+
+                const int ownerX = cell.x - (reuseDirection & 1);
+                const int ownerY = cell.y - ((reuseDirection >> 2) & 1);
+                const int ownerZ = cell.z - ((reuseDirection >> 1) & 1);
+
+                if (((reuseDirection & 8) == 0) && (ownerX >= 0) && (ownerY >= 0) && (ownerZ >= 0))
+                {
+                    cellVertices[i] = vertexCache[((ownerZ & 1) * deckSize + ownerY * numCells.x + ownerX) * 4 + reuseSlot];
+                    continue;
+                }
+
+                cellVertices[i] = static_cast<IndexType>(vertexIndex);
+                if (apronLattice != nullptr)
+                {
+                    outputVertices.SetNormal(vertexIndex, GetEdgeNormal(*apronLattice, numCells, glm::ivec3(cell.x, cell.y, cell.z), values, vertexData));
+                }
+                outputVertices.SetPosition(vertexIndex++, GetEdgeVertex(values, cellPosition, cellSize, vertexData));
+
+                if ((reuseDirection & 8) != 0)
+                {
+                    cellCache[reuseSlot] = cellVertices[i];
+                }
+            }
+
+            for (int i = 0; i < cellCase.numTriangles * 3; ++i)
+            {
+                outputIndices[indexIndex++] = cellVertices[cellCase.vertexIndices[i]];
+            }
+        }
+
+        return true;
+    }
+
+    /**
+     * @brief Triangulates a sampled lattice into an indexed mesh, with transition cells along some of its faces
+     * @param[in] signedDistanceFunc Signed distance function, used to sample the transition faces at half the cell size
+     * @param[in] lattice Sampled lattice
+     * @param[in] apronLattice Lattice sampled with a one-cell apron, used for the normals. Can be null.
+     * @param[in] origin Position of the first grid corner
+     * @param[in] cellSize Cell size
+     * @param[in] numCells Number of cells along each axis
+     * @param[in] transitionFaces Combination of TransitionFace flags
+     * @param[out] outputVertices Vertex sink where the vertices will be written. The normals are only set if apronLattice is given.
+     * @param[out] outputIndices Vector where the triangle vertex indices will be placed
+     * @return True if successful. False if the vertex count exceeds the range of the index type.
+     */
+    template <typename DensityFunc, typename VertexSink, typename IndexType>
+    bool MarchingCubes::PolygonizeWithTransitions(DensityFunc& signedDistanceFunc, const std::vector<float>& lattice, const std::vector<float>* apronLattice, const glm::vec3& origin, float cellSize, const glm::ivec3& numCells, int transitionFaces, VertexSink& outputVertices, std::vector<IndexType>& outputIndices)
+    {
+        // The regular cells are the ones that do not touch any transition face
+        glm::ivec3 regularBegin(0);
+        glm::ivec3 regularEnd = numCells;
+        for (int axis = 0; axis < 3; ++axis)
+        {
+            if ((transitionFaces & (NEGATIVE_X << (axis * 2))) != 0)
+            {
+                regularBegin[axis] += 1;
+            }
+            if ((transitionFaces & (POSITIVE_X << (axis * 2))) != 0)
+            {
+                regularEnd[axis] -= 1;
+            }
+        }
+
+        const glm::ivec3 numRegularCells = regularEnd - regularBegin;
+        if ((numRegularCells.x > 0) && (numRegularCells.y > 0) && (numRegularCells.z > 0))
+        {
+            std::vector<float> regularLattice;
+            ExtractSubLattice(lattice, numCells + 1, regularBegin, numRegularCells + 1, regularLattice);
+
+            std::vector<float> regularApronLattice;
+            if (apronLattice != nullptr)
+            {
+                ExtractSubLattice(*apronLattice, numCells + 3, regularBegin, numRegularCells + 3, regularApronLattice);
+            }
+
+            glm::vec3 regularOrigin = origin + glm::vec3(regularBegin) * cellSize;
+            if (!PolygonizeIndexed(regularLattice, (apronLattice != nullptr) ? &regularApronLattice : nullptr, regularOrigin, cellSize, numRegularCells, outputVertices, outputIndices))
+            {
+                return false;
+            }
+        }
+
+        // The transition faces are sampled at half the cell size, at the same
+        // points as the grid corners of the mesh on the other side. Each face is a
+        // lattice of its own, so the samples match those of that mesh's lattice.
+        std::vector<float> faceSamples;
+        std::vector<float> faceLatticePart;
+        const float halfCellSize = cellSize * 0.5f;
+        for (int face = 0; face < 6; ++face)
+        {
+            if ((transitionFaces & (1 << face)) == 0)
+            {
+                continue;
+            }
+
+            glm::ivec3 blockMin, blockSize;
+            GetTransitionFaceBlock(numCells, face, blockMin, blockSize);
+
+            const size_t numBlockSamples = static_cast<size_t>(blockSize.x) * blockSize.y * blockSize.z;
+            std::vector<float> xs(numBlockSamples);
+            std::vector<float> ys(numBlockSamples);
+            std::vector<float> zs(numBlockSamples);
+
+            size_t sampleIndex = 0;
+            for (int z = 0; z < blockSize.z; ++z)
+            {
+                for (int y = 0; y < blockSize.y; ++y)
+                {
+                    for (int x = 0; x < blockSize.x; ++x)
+                    {
+                        glm::vec3 position = origin + glm::vec3(blockMin + glm::ivec3(x, y, z)) * halfCellSize;
+                        xs[sampleIndex] = position.x;
+                        ys[sampleIndex] = position.y;
+                        zs[sampleIndex] = position.z;
+                        ++sampleIndex;
+                    }
+                }
+            }
+
+            GetLatticePart(signedDistanceFunc, origin + glm::vec3(blockMin) * halfCellSize, halfCellSize, blockSize, faceLatticePart);
+
+            const size_t blockOffset = faceSamples.size();
+            faceSamples.resize(blockOffset + numBlockSamples);
+            EvaluateLatticeBatch(signedDistanceFunc, xs.data(), ys.data(), zs.data(), faceLatticePart.empty() ? nullptr : faceLatticePart.data(), faceSamples.data() + blockOffset, nullptr, numBlockSamples);
+        }
+
+        std::vector<glm::vec3> transitionVertices;
+        std::vector<glm::vec3> transitionNormals;
+        std::vector<uint32_t> transitionIndices;
+        PolygonizeTransitionCells(lattice, apronLattice, faceSamples, origin, cellSize, numCells, transitionFaces, transitionVertices, (apronLattice != nullptr) ? &transitionNormals : nullptr, transitionIndices);
+
+        const size_t firstVertex = outputVertices.GetVertexCount();
+        const size_t maxNumVertices = static_cast<size_t>(std::numeric_limits<IndexType>::max()) + 1;
+        if (firstVertex + transitionVertices.size() > maxNumVertices)
+        {
+            return false;
+        }
+
+        outputVertices.Resize(firstVertex + transitionVertices.size());
+        for (size_t i = 0; i < transitionVertices.size(); ++i)
+        {
+            outputVertices.SetPosition(firstVertex + i, transitionVertices[i]);
+            if (apronLattice != nullptr)
+            {
+                outputVertices.SetNormal(firstVertex + i, transitionNormals[i]);
+            }
+        }
+
+        const size_t firstIndex = outputIndices.size();
+        outputIndices.resize(firstIndex + transitionIndices.size());
+        for (size_t i = 0; i < transitionIndices.size(); ++i)
+        {
+            outputIndices[firstIndex + i] = static_cast<IndexType>(firstVertex + transitionIndices[i]);
+        }
+
+        return true;
+    }
+
+    /**
+     * @brief Samples the provided function at every grid corner inside the bounds
+     *
+     * If the function provides GetDensityRange, the blocks where it provably keeps its sign
+     * are not sampled, and their grid corners only get a value of the right sign. If it provides
+     * EvaluateSignBatch, it may only get the sign right at the grid corners the meshers do not read.
+     * If it provides GetLatticePart, that part is evaluated once for the whole lattice.
+     * @param[in] signedDistanceFunc Signed distance function
+     * @param[in] origin Position of the first grid corner
+     * @param[in] cellSize Cell size
+     * @param[in] numCells Number of cells along each axis
+     * @param[out] outputValues Vector where the (numCells + 1)^3 samples will be placed, x varying fastest
+     * @param[in] numThreads Number of threads sampling the z-slabs in parallel
+     * @param[in] maxIsovalue Highest isovalue the meshers read the samples for, from 0. The function must only
+     *                        get the sign right where it is on the same side of all of them.
+     * @param[in] transitionFaces Combination of TransitionFace flags. Transition cells read every grid corner
+     *                            on these faces, so they are all sampled exactly.
+     * @param[in] apronSize Number of cells between the lattice bounds and the transition faces
+     */
+    template <typename DensityFunc>
+    void MarchingCubes::SampleLattice(DensityFunc& signedDistanceFunc, const glm::vec3& origin, float cellSize, const glm::ivec3& numCells, std::vector<float>& outputValues, int numThreads, float maxIsovalue, int transitionFaces, int apronSize)
+    {
+        const glm::ivec3 numSamples = numCells + 1;
+        outputValues.resize(static_cast<size_t>(numSamples.x) * numSamples.y * numSamples.z);
+
+        // Part of the density that is cheaper to evaluate over the whole lattice at once, if any
+        std::vector<float> latticePartValues;
+        GetLatticePart(signedDistanceFunc, origin, cellSize, numSamples, latticePartValues);
+        const float* latticePart = latticePartValues.empty() ? nullptr : latticePartValues.data();
+
+        // The lattice part is only taken by the sign-conservative evaluation if the source has that overload
+        float* values = outputValues.data();
+        if ((latticePart != nullptr) ? !HasLatticeSignBatch<DensityFunc>::value : !HasEvaluateSignBatch<DensityFunc>::value)
+        {
+            ParallelFor(0, numSamples.z, numThreads, [&](int zBegin, int zEnd)
+            {
+                SampleLatticePart(signedDistanceFunc, origin, cellSize, numSamples, latticePart, zBegin, zEnd, values);
+            });
+            return;
+        }
+
+        // Far from the surface, the source only gets the signs right. The corners the meshers
+        // read are sampled again once the crossed edges are known.
+        std::vector<unsigned char> isSignOnly(outputValues.size());
+        std::vector<unsigned char> isOnCrossedEdge(outputValues.size());
+        ParallelFor(0, numSamples.z, numThreads, [&](int zBegin, int zEnd)
+        {
+            SampleLatticePart(signedDistanceFunc, origin, cellSize, numSamples, latticePart, zBegin, zEnd, values, isSignOnly.data());
+        });
+        ParallelFor(0, numSamples.z, numThreads, [&](int zBegin, int zEnd)
+        {
+            FindCrossedEdgeCorners(values, numSamples, maxIsovalue, zBegin, zEnd, isOnCrossedEdge.data());
+
+            // A half-size edge of a transition cell can be crossed while the whole edge is not
+            FlagFaceCorners(numSamples, glm::ivec3(apronSize), numCells - apronSize, transitionFaces, zBegin, zEnd, isOnCrossedEdge.data());
+        });
+        ParallelFor(0, numSamples.z, numThreads, [&](int zBegin, int zEnd)
+        {
+            RefineSignOnlySamples(signedDistanceFunc, origin, cellSize, numSamples, latticePart, zBegin, zEnd, isOnCrossedEdge.data(), isSignOnly.data(), values);
+        });
+    }
+}
@@ -0,0 +1,153 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <cstdint>
+#include <vector>
+
+namespace MarchingCubes
+{
+    /**
+     * Quadric error mesh simplification, by edge collapses.
+     *
+     * Every vertex accumulates the planes of the triangles around it into a quadric, which gives
+     * the sum of the squared distances of a point to these planes. Edges are collapsed cheapest
+     * first, into the point minimizing the quadric of both vertices, so flat and gently curved
+     * regions lose most of their triangles while sharp features stay.
+     *
+     * Vertices on the open border of the mesh are never moved or removed, so that the meshes of
+     * neighboring chunks still match along their common faces. Collapses that would flip a
+     * triangle or make the mesh non-manifold are skipped.
+     *
+     * The decimation only touches its arguments, so it can run on several threads at once.
+     */
+    class MeshDecimator
+    {
+    public:
+        /**
+         * @brief Simplifies an indexed mesh
+         * @param[in,out] positions Vertex positions. Only the vertices still used remain, in their original order.
+         * @param[in,out] indices Triangle vertex indices
+         * @param[in] maxError Largest collapse error, as a distance to the planes of the original triangles
+         * @param[in] minTriangleRatio Fraction of the triangles where the simplification stops, even below the largest error
+         * @param[out] outputVertexMap Vector where the original index of every remaining vertex will be placed, to carry other vertex attributes over. Can be null.
+         * @return Number of triangles removed
+         */
+        static size_t Decimate(std::vector<glm::vec3>& positions, std::vector<uint32_t>& indices, float maxError, float minTriangleRatio, std::vector<uint32_t>* outputVertexMap);
+
+    private:
+        /**
+         * Symmetric 4x4 matrix of the sum of squared distances to a set of planes,
+         * as its 10 upper triangular coefficients
+         */
+        struct Quadric
+        {
+            double coefficients[10];
+
+            /**
+             * @brief Adds the plane a * x + b * y + c * z + d = 0
+             * @param[in] plane Plane coefficients, with a unit normal
+             */
+            void AddPlane(const glm::dvec4& plane);
+
+            /**
+             * @brief Adds another quadric
+             * @param[in] other Quadric to add
+             */
+            void Add(const Quadric& other);
+
+            /**
+             * @brief Gets the sum of the squared distances of a point to the planes
+             * @param[in] point Point
+             * @return Error
+             */
+            double GetError(const glm::dvec3& point) const;
+
+            /**
+             * @brief Finds the point with the smallest error
+             * @param[out] outputPoint Point with the smallest error
+             * @return False if the planes do not determine a single point
+             */
+            bool GetMinimum(glm::dvec3& outputPoint) const;
+        };
+
+        /**
+         * Candidate edge collapse
+         */
+        struct Collapse
+        {
+            /**
+             * Error of the collapse
+             */
+            double error;
+
+            /**
+             * Vertex kept, and moved to the new position
+             */
+            uint32_t keptVertex;
+
+            /**
+             * Vertex removed
+             */
+            uint32_t removedVertex;
+
+            /**
+             * Versions of the vertices when the collapse was evaluated
+             */
+            uint32_t keptVersion;
+            uint32_t removedVersion;
+
+            /**
+             * New position of the kept vertex
+             */
+            glm::vec3 position;
+
+            bool operator<(const Collapse& other) const
+            {
+                // Cheapest collapse first in a std::priority_queue
+                return error > other.error;
+            }
+        };
+
+        /**
+         * Working state of a simplification
+         */
+        struct State
+        {
+            std::vector<glm::vec3>& positions;
+            std::vector<uint32_t>& indices;
+            std::vector<Quadric> quadrics;
+            std::vector<std::vector<uint32_t>> vertexTriangles;
+            std::vector<uint32_t> versions;
+            std::vector<bool> isLocked;
+            std::vector<bool> isVertexRemoved;
+            std::vector<bool> isTriangleRemoved;
+        };
+
+        /**
+         * @brief Evaluates the collapse of an edge
+         * @param[in] state Working state
+         * @param[in] vertex0 First edge vertex
+         * @param[in] vertex1 Second edge vertex
+         * @param[out] outputCollapse Collapse
+         * @return False if the edge cannot be collapsed
+         */
+        static bool EvaluateCollapse(const State& state, uint32_t vertex0, uint32_t vertex1, Collapse& outputCollapse);
+
+        /**
+         * @brief Checks whether a collapse keeps the mesh manifold and no triangle flips
+         * @param[in] state Working state
+         * @param[in] collapse Collapse
+         * @return True if the collapse can be done
+         */
+        static bool IsCollapseValid(const State& state, const Collapse& collapse);
+
+        /**
+         * @brief Gathers the vertices sharing a live triangle with a vertex
+         * @param[in] state Working state
+         * @param[in] vertex Vertex
+         * @param[out] outputNeighbors Vector where the sorted neighbors will be placed
+         */
+        static void GetNeighbors(const State& state, uint32_t vertex, std::vector<uint32_t>& outputNeighbors);
+    };
+}
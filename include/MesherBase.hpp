@@ -0,0 +1,78 @@
+#pragma once
+
+#include "Engine/Geometry/BoundingVolumes/AABB.hpp"
+
+#include <glm/glm.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace MarchingCubes
+{
+    /**
+     * Common interface of the isosurface extraction algorithms, so that the
+     * algorithm can be chosen at runtime.
+     *
+     * Implementations are stateless, and may be called from several threads at once.
+     * The vertices are written into a vertex sink, see VertexSink.hpp.
+     */
+    template <typename DensityFunc, typename VertexSink>
+    class MesherBase
+    {
+    public:
+        /**
+         * @brief Destructor
+         */
+        virtual ~MesherBase()
+        {
+        }
+
+        /**
+         * @brief Gets the resulting indexed mesh
+         * @param[in] signedDistanceFunc Signed distance function
+         * @param[in] bounds Shape bounds
+         * @param[in] cellSize Cell size
+         * @param[in] transitionFaces Faces of the bounds next to bounds meshed with twice the cell size.
+         *                            Ignored if transition faces are not supported.
+         * @param[out] outputVertices Vertex sink where the vertices will be written. The normals are left untouched if not supported.
+         * @param[out] outputIndices Vector where the triangle vertex indices will be placed
+         * @return True if successful
+         */
+        virtual bool GetIndexedMesh(DensityFunc& signedDistanceFunc, const AABB& bounds, float cellSize, int transitionFaces, VertexSink& outputVertices, std::vector<uint32_t>& outputIndices) const = 0;
+
+        /**
+         * @brief Does the mesher compute vertex normals?
+         * @return True if supported
+         */
+        virtual bool SupportsNormals() const = 0;
+
+        /**
+         * @brief Can the mesher stitch bounds meshed with different cell sizes?
+         * @return True if supported
+         */
+        virtual bool SupportsTransitionFaces() const = 0;
+
+    protected:
+        /**
+         * @brief Writes the vertex positions of a mesh built in a separate vector into the vertex sink
+         * @param[in] positions Vertex positions
+         * @param[in] firstIndex Index in outputIndices of the first index of the mesh, relative to the first position
+         * @param[out] outputVertices Vertex sink where the vertices will be written
+         * @param[in,out] outputIndices Triangle vertex indices, offset to the vertices of the sink
+         */
+        static void WritePositions(const std::vector<glm::vec3>& positions, size_t firstIndex, VertexSink& outputVertices, std::vector<uint32_t>& outputIndices)
+        {
+            const size_t firstVertex = outputVertices.GetVertexCount();
+            outputVertices.Resize(firstVertex + positions.size());
+            for (size_t i = 0; i < positions.size(); ++i)
+            {
+                outputVertices.SetPosition(firstVertex + i, positions[i]);
+            }
+            for (size_t i = firstIndex; i < outputIndices.size(); ++i)
+            {
+                outputIndices[i] += static_cast<uint32_t>(firstVertex);
+            }
+        }
+    };
+}
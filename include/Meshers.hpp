@@ -0,0 +1,233 @@
+#pragma once
+
+#include "DualContouring.hpp"
+#include "FlyingEdges.hpp"
+#include "MarchingCubes.hpp"
+#include "MesherBase.hpp"
+#include "MeshingAlgorithm.hpp"
+#include "OctreeMesher.hpp"
+#include "SurfaceNets.hpp"
+
+#include <memory>
+
+namespace MarchingCubes
+{
+    /**
+     * Marching cubes, with smooth normals and transition cells
+     */
+    template <typename DensityFunc, typename VertexSink>
+    class MarchingCubesMesher : public MesherBase<DensityFunc, VertexSink>
+    {
+    public:
+        /**
+         * @copydoc MesherBase::GetIndexedMesh
+         */
+        bool GetIndexedMesh(DensityFunc& signedDistanceFunc, const AABB& bounds, float cellSize, int transitionFaces, VertexSink& outputVertices, std::vector<uint32_t>& outputIndices) const override
+        {
+            return MarchingCubes::GetInstance().WriteIndexedMesh(signedDistanceFunc, bounds, cellSize, outputVertices, outputIndices, transitionFaces);
+        }
+
+        /**
+         * @copydoc MesherBase::SupportsNormals
+         */
+        bool SupportsNormals() const override
+        {
+            return true;
+        }
+
+        /**
+         * @copydoc MesherBase::SupportsTransitionFaces
+         */
+        bool SupportsTransitionFaces() const override
+        {
+            return true;
+        }
+    };
+
+    /**
+     * Flying Edges
+     */
+    template <typename DensityFunc, typename VertexSink>
+    class FlyingEdgesMesher : public MesherBase<DensityFunc, VertexSink>
+    {
+    public:
+        /**
+         * @brief Constructor
+         * @param[in] numThreads Number of threads used for every mesh
+         */
+        explicit FlyingEdgesMesher(int numThreads)
+            : m_numThreads(numThreads)
+        {
+        }
+
+        /**
+         * @copydoc MesherBase::GetIndexedMesh
+         */
+        bool GetIndexedMesh(DensityFunc& signedDistanceFunc, const AABB& bounds, float cellSize, int transitionFaces, VertexSink& outputVertices, std::vector<uint32_t>& outputIndices) const override
+        {
+            std::vector<glm::vec3> positions;
+            const size_t firstIndex = outputIndices.size();
+            FlyingEdges::GetIndexedMesh(signedDistanceFunc, bounds, cellSize, positions, outputIndices, m_numThreads);
+            this->WritePositions(positions, firstIndex, outputVertices, outputIndices);
+            return true;
+        }
+
+        /**
+         * @copydoc MesherBase::SupportsNormals
+         */
+        bool SupportsNormals() const override
+        {
+            return false;
+        }
+
+        /**
+         * @copydoc MesherBase::SupportsTransitionFaces
+         */
+        bool SupportsTransitionFaces() const override
+        {
+            return false;
+        }
+
+    private:
+        /**
+         * Number of threads used for every mesh
+         */
+        int m_numThreads;
+    };
+
+    /**
+     * Adaptive octree
+     */
+    template <typename DensityFunc, typename VertexSink>
+    class OctreeMesherAdapter : public MesherBase<DensityFunc, VertexSink>
+    {
+    public:
+        /**
+         * @copydoc MesherBase::GetIndexedMesh
+         */
+        bool GetIndexedMesh(DensityFunc& signedDistanceFunc, const AABB& bounds, float cellSize, int transitionFaces, VertexSink& outputVertices, std::vector<uint32_t>& outputIndices) const override
+        {
+            std::vector<glm::vec3> positions;
+            const size_t firstIndex = outputIndices.size();
+            OctreeMesher::GetIndexedMesh(signedDistanceFunc, bounds, cellSize, positions, outputIndices);
+            this->WritePositions(positions, firstIndex, outputVertices, outputIndices);
+            return true;
+        }
+
+        /**
+         * @copydoc MesherBase::SupportsNormals
+         */
+        bool SupportsNormals() const override
+        {
+            return false;
+        }
+
+        /**
+         * @copydoc MesherBase::SupportsTransitionFaces
+         */
+        bool SupportsTransitionFaces() const override
+        {
+            return false;
+        }
+    };
+
+    /**
+     * Surface Nets
+     */
+    template <typename DensityFunc, typename VertexSink>
+    class SurfaceNetsMesher : public MesherBase<DensityFunc, VertexSink>
+    {
+    public:
+        /**
+         * @copydoc MesherBase::GetIndexedMesh
+         */
+        bool GetIndexedMesh(DensityFunc& signedDistanceFunc, const AABB& bounds, float cellSize, int transitionFaces, VertexSink& outputVertices, std::vector<uint32_t>& outputIndices) const override
+        {
+            std::vector<glm::vec3> positions;
+            const size_t firstIndex = outputIndices.size();
+            SurfaceNets::GetIndexedMesh(signedDistanceFunc, bounds, cellSize, positions, outputIndices);
+            this->WritePositions(positions, firstIndex, outputVertices, outputIndices);
+            return true;
+        }
+
+        /**
+         * @copydoc MesherBase::SupportsNormals
+         */
+        bool SupportsNormals() const override
+        {
+            return false;
+        }
+
+        /**
+         * @copydoc MesherBase::SupportsTransitionFaces
+         */
+        bool SupportsTransitionFaces() const override
+        {
+            return false;
+        }
+    };
+
+    /**
+     * Dual Contouring
+     */
+    template <typename DensityFunc, typename VertexSink>
+    class DualContouringMesher : public MesherBase<DensityFunc, VertexSink>
+    {
+    public:
+        /**
+         * @copydoc MesherBase::GetIndexedMesh
+         */
+        bool GetIndexedMesh(DensityFunc& signedDistanceFunc, const AABB& bounds, float cellSize, int transitionFaces, VertexSink& outputVertices, std::vector<uint32_t>& outputIndices) const override
+        {
+            std::vector<glm::vec3> positions;
+            const size_t firstIndex = outputIndices.size();
+            DualContouring::GetIndexedMesh(signedDistanceFunc, bounds, cellSize, positions, outputIndices);
+            this->WritePositions(positions, firstIndex, outputVertices, outputIndices);
+            return true;
+        }
+
+        /**
+         * @copydoc MesherBase::SupportsNormals
+         */
+        bool SupportsNormals() const override
+        {
+            return false;
+        }
+
+        /**
+         * @copydoc MesherBase::SupportsTransitionFaces
+         */
+        bool SupportsTransitionFaces() const override
+        {
+            return false;
+        }
+    };
+
+    /**
+     * @brief Creates the mesher of an algorithm
+     * @param[in] algorithm Meshing algorithm
+     * @param[in] numThreads Number of threads used for every mesh, by the algorithms meshing in parallel
+     * @return Mesher
+     */
+    template <typename DensityFunc, typename VertexSink>
+    std::unique_ptr<MesherBase<DensityFunc, VertexSink>> CreateMesher(MeshingAlgorithm algorithm, int numThreads)
+    {
+        switch (algorithm)
+        {
+            case MeshingAlgorithm::FlyingEdges:
+                return std::unique_ptr<MesherBase<DensityFunc, VertexSink>>(new FlyingEdgesMesher<DensityFunc, VertexSink>(numThreads));
+
+            case MeshingAlgorithm::Octree:
+                return std::unique_ptr<MesherBase<DensityFunc, VertexSink>>(new OctreeMesherAdapter<DensityFunc, VertexSink>());
+
+            case MeshingAlgorithm::SurfaceNets:
+                return std::unique_ptr<MesherBase<DensityFunc, VertexSink>>(new SurfaceNetsMesher<DensityFunc, VertexSink>());
+
+            case MeshingAlgorithm::DualContouring:
+                return std::unique_ptr<MesherBase<DensityFunc, VertexSink>>(new DualContouringMesher<DensityFunc, VertexSink>());
+
+            default:
+                return std::unique_ptr<MesherBase<DensityFunc, VertexSink>>(new MarchingCubesMesher<DensityFunc, VertexSink>());
+        }
+    }
+}
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <cstring>
+
+namespace MarchingCubes
+{
+    /**
+     * Isosurface extraction algorithm used to mesh the terrain chunks
+     */
+    enum class MeshingAlgorithm
+    {
+        MarchingCubes,
+        FlyingEdges,
+        Octree,
+        SurfaceNets,
+        DualContouring,
+
+        Count
+    };
+
+    /**
+     * @brief Gets the display name of a meshing algorithm
+     * @param[in] algorithm Meshing algorithm
+     * @return Display name
+     */
+    inline const char* GetMeshingAlgorithmName(MeshingAlgorithm algorithm)
+    {
+        switch (algorithm)
+        {
+            case MeshingAlgorithm::FlyingEdges:
+                return "Flying Edges";
+
+            case MeshingAlgorithm::Octree:
+                return "Adaptive octree";
+
+            case MeshingAlgorithm::SurfaceNets:
+                return "Surface Nets";
+
+            case MeshingAlgorithm::DualContouring:
+                return "Dual Contouring";
+
+            default:
+                return "Marching Cubes";
+        }
+    }
+
+    /**
+     * @brief Gets the command line identifier of a meshing algorithm
+     * @param[in] algorithm Meshing algorithm
+     * @return Identifier
+     */
+    inline const char* GetMeshingAlgorithmId(MeshingAlgorithm algorithm)
+    {
+        switch (algorithm)
+        {
+            case MeshingAlgorithm::FlyingEdges:
+                return "flying-edges";
+
+            case MeshingAlgorithm::Octree:
+                return "octree";
+
+            case MeshingAlgorithm::SurfaceNets:
+                return "surface-nets";
+
+            case MeshingAlgorithm::DualContouring:
+                return "dual-contouring";
+
+            default:
+                return "marching-cubes";
+        }
+    }
+
+    /**
+     * @brief Finds the meshing algorithm with a command line identifier
+     * @param[in] id Identifier
+     * @param[out] outputAlgorithm Meshing algorithm
+     * @return True if found
+     */
+    inline bool ParseMeshingAlgorithm(const char* id, MeshingAlgorithm& outputAlgorithm)
+    {
+        for (int i = 0; i < static_cast<int>(MeshingAlgorithm::Count); ++i)
+        {
+            if (std::strcmp(id, GetMeshingAlgorithmId(static_cast<MeshingAlgorithm>(i))) == 0)
+            {
+                outputAlgorithm = static_cast<MeshingAlgorithm>(i);
+                return true;
+            }
+        }
+        return false;
+    }
+}
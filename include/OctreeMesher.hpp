@@ -0,0 +1,390 @@
+#pragma once
+
+#include "Engine/Geometry/BoundingVolumes/AABB.hpp"
+
+#include "DensityBatch.hpp"
+#include "MarchingCubes.hpp"
+#include "Triangle.hpp"
+
+#include <glm/glm.hpp>
+
+#include <cstdint>
+#include <vector>
+
+namespace MarchingCubes
+{
+    /**
+     * Adaptive isosurface extraction over an octree.
+     *
+     * The octree covers the cells of the bounds, and a node is only subdivided if the surface
+     * passes through it and the function deviates from the trilinear interpolation of its corners
+     * by more than the error threshold, or if the surface crosses the node without crossing its
+     * corners. Flat surfaces, and regions of deep air or rock, end up in large leaves.
+     *
+     * The faces on the bounds are shared with the neighboring chunks, so they are split from the
+     * samples on the bounds alone, like a quadtree over each face: a node face crossed by the surface
+     * is split down to 2 cells, then down to 1 cell if it deviates from the bilinear interpolation of
+     * its corners. Along the edges of the bounds, the squares past the edge on the same planes are
+     * sampled too, and split the faces on either side alike. The chunks sharing a face then cut its
+     * crossed parts the same way, and the nodes whose faces on the bounds are not crossed stay adaptive.
+     *
+     * The octree is then balanced so that touching leaves differ by at most one level, and every
+     * leaf is polygonized by tracing the surface across its faces, split where the neighboring
+     * leaves are smaller. Leaves of different sizes therefore join without cracks.
+     *
+     * The function is sampled in batches, one octree level at a time, after every point on the bounds.
+     */
+    class OctreeMesher
+    {
+    public:
+        /**
+         * @brief Gets the resulting mesh upon performing adaptive extraction
+         * @param[in] signedDistanceFunc Signed distance function
+         * @param[in] bounds Shape bounds
+         * @param[in] cellSize Size of the smallest cells
+         * @param[out] outputTriangles Vector where the triangles will be placed
+         * @param[in] errorThreshold Largest deviation of the function from the trilinear interpolation inside a leaf crossed by the surface
+         */
+        template <typename DensityFunc>
+        static void GetMesh(DensityFunc&& signedDistanceFunc, const AABB& bounds, float cellSize, std::vector<Triangle>& outputTriangles, float errorThreshold = 0.05f);
+
+        /**
+         * @brief Gets the resulting indexed mesh upon performing adaptive extraction
+         * @param[in] signedDistanceFunc Signed distance function
+         * @param[in] bounds Shape bounds
+         * @param[in] cellSize Size of the smallest cells
+         * @param[out] outputVertices Vector where the vertex positions will be placed
+         * @param[out] outputIndices Vector where the triangle vertex indices will be placed
+         * @param[in] errorThreshold Largest deviation of the function from the trilinear interpolation inside a leaf crossed by the surface
+         * @return Number of function samples taken
+         */
+        template <typename DensityFunc>
+        static size_t GetIndexedMesh(DensityFunc&& signedDistanceFunc, const AABB& bounds, float cellSize, std::vector<glm::vec3>& outputVertices, std::vector<uint32_t>& outputIndices, float errorThreshold = 0.05f);
+
+    private:
+        /**
+         * Octree node. Positions and sizes are in smallest cells.
+         */
+        struct Node
+        {
+            /**
+             * Minimum corner
+             */
+            glm::ivec3 min;
+
+            /**
+             * Size along each axis
+             */
+            int size;
+
+            /**
+             * Index of the first of the 8 children, or -1 for leaves
+             */
+            int firstChild;
+
+            /**
+             * Is the node outside of the bounds?
+             */
+            bool isOutside;
+        };
+
+        /**
+         * How the faces of a node lying on the bounds constrain its subdivision
+         */
+        enum class BoundsFaceSplit
+        {
+            /**
+             * No face on the bounds crossed by the surface
+             */
+            None,
+
+            /**
+             * A face on the bounds is crossed, and must not be split
+             */
+            Leaf,
+
+            /**
+             * A face on the bounds is crossed, and must be split
+             */
+            Split
+        };
+
+        /**
+         * Square on the plane of a face of the bounds
+         */
+        struct BoundsSquare
+        {
+            /**
+             * Axis normal to the plane
+             */
+            int axis;
+
+            /**
+             * Minimum corner
+             */
+            glm::ivec3 min;
+
+            /**
+             * Is the square a face of the node, rather than past an edge of the bounds?
+             */
+            bool isOnNode;
+        };
+
+        /**
+         * Number of points sampled past the bounds, on the planes of the faces of the bounds
+         */
+        static constexpr int apronSize = 2;
+
+        /**
+         * Largest number of squares of a node on the planes of the faces of the bounds,
+         * for 6 faces with 3 squares along each of their 2 axes
+         */
+        static constexpr int maxBoundsSquares = 6 * 3 * 3;
+
+        /**
+         * @brief Constructor
+         * @param[in] numCells Number of smallest cells along each axis
+         * @param[in] errorThreshold Largest deviation of the function from the trilinear interpolation inside a leaf crossed by the surface
+         */
+        OctreeMesher(const glm::ivec3& numCells, float errorThreshold);
+
+        /**
+         * @brief Gets the points where the function needs to be sampled to continue building the octree
+         * @return Points, in smallest cells. Empty once the octree is complete.
+         */
+        const std::vector<glm::ivec3>& GetRequestedPoints() const;
+
+        /**
+         * @brief Provides the samples at the requested points, and continues building the octree
+         * @param[in] values Samples, in the same order as the requested points
+         */
+        void AddSamples(const std::vector<float>& values);
+
+        /**
+         * @brief Polygonizes the leaves of the completed octree
+         * @param[in] origin Position of the first grid corner
+         * @param[in] cellSize Size of the smallest cells
+         * @param[out] outputVertices Vector where the vertex positions will be placed
+         * @param[out] outputIndices Vector where the triangle vertex indices will be placed
+         */
+        void Polygonize(const glm::vec3& origin, float cellSize, std::vector<glm::vec3>& outputVertices, std::vector<uint32_t>& outputIndices) const;
+
+        /**
+         * @brief Gets the number of function samples taken
+         * @return Number of samples
+         */
+        size_t GetSampleCount() const;
+
+        /**
+         * @brief Classifies a new node, and queues it for refinement if needed
+         * @param[in] nodeIndex Node index
+         */
+        void AddNode(int nodeIndex);
+
+        /**
+         * @brief Creates the 8 children of a node
+         * @param[in] nodeIndex Node index
+         */
+        void Subdivide(int nodeIndex);
+
+        /**
+         * @brief Decides whether a node needs to be subdivided, from its 27 samples
+         * @param[in] node Node
+         * @return True if the node needs to be subdivided
+         */
+        bool NeedsSubdivision(const Node& node) const;
+
+        /**
+         * @brief Decides how the faces of a node lying on the bounds split it, from the samples on the bounds alone
+         * @param[in] node Node
+         * @return Constraint on the subdivision of the node
+         */
+        BoundsFaceSplit GetBoundsFaceSplit(const Node& node) const;
+
+        /**
+         * @brief Decides how a square on the plane of a face of the bounds is split, from its samples alone
+         * @param[in] axis Axis normal to the plane
+         * @param[in] min Minimum corner of the square
+         * @param[in] size Size of the square
+         * @return Split if the square must be split, Leaf if it must not, None if it is not crossed by the surface
+         */
+        BoundsFaceSplit GetBoundsSquareSplit(int axis, const glm::ivec3& min, int size) const;
+
+        /**
+         * @brief Lists the squares of a node on the faces of the bounds, and the squares next to them past
+         * the edges of the bounds, on the same planes
+         * @param[in] node Node
+         * @param[out] outputSquares Array where the squares will be placed, with room for maxBoundsSquares
+         * @return Number of squares
+         */
+        int GetBoundsSquares(const Node& node, BoundsSquare* outputSquares) const;
+
+        /**
+         * @brief Requests the samples of the squares past the edges of the bounds that a node needs to decide
+         * how its faces on the bounds are split
+         * @param[in] node Node
+         * @return True if any point was requested
+         */
+        bool RequestBoundsEdgePoints(const Node& node);
+
+        /**
+         * @brief Requests the points needed by the pending nodes, and advances to the next stage when there are none
+         */
+        void RequestPoints();
+
+        /**
+         * @brief Requests a point, unless it has already been sampled or requested
+         * @param[in] point Point, in smallest cells
+         */
+        void RequestPoint(const glm::ivec3& point);
+
+        /**
+         * @brief Subdivides leaves until touching leaves differ by at most one level
+         */
+        void Balance();
+
+        /**
+         * @brief Finds the leaf containing a smallest cell
+         * @param[in] cell Smallest cell
+         * @return Leaf index, or -1 if the cell is outside of the bounds
+         */
+        int FindLeaf(const glm::ivec3& cell) const;
+
+        /**
+         * @brief Gets the sample at a point
+         * @param[in] point Point, in smallest cells
+         * @return Sample
+         */
+        float GetSample(const glm::ivec3& point) const;
+
+        /**
+         * @brief Gets the index of a point in the sample lattice
+         * @param[in] point Point, in smallest cells
+         * @return Index
+         */
+        size_t GetPointIndex(const glm::ivec3& point) const;
+
+    private:
+        /**
+         * Number of smallest cells along each axis
+         */
+        glm::ivec3 m_numCells;
+
+        /**
+         * Largest deviation of the function from the trilinear interpolation inside a leaf crossed by the surface
+         */
+        float m_errorThreshold;
+
+        /**
+         * Octree nodes. The first one is the root.
+         */
+        std::vector<Node> m_nodes;
+
+        /**
+         * Nodes waiting for their samples to decide whether to subdivide them
+         */
+        std::vector<int> m_pendingNodes;
+
+        /**
+         * Has the refinement finished?
+         */
+        bool m_isRefined;
+
+        /**
+         * Points to sample next
+         */
+        std::vector<glm::ivec3> m_requestedPoints;
+
+        /**
+         * Samples taken so far, laid out like the lattice of MarchingCubes::SampleLattice,
+         * with apronSize more points on each side
+         */
+        std::vector<float> m_samples;
+
+        /**
+         * Has each lattice point been sampled or requested?
+         */
+        std::vector<bool> m_isSampled;
+
+        /**
+         * Number of samples taken or requested so far
+         */
+        size_t m_numSamples;
+
+        /**
+         * Index of the leaf containing each smallest cell
+         */
+        std::vector<int> m_cellLeaves;
+    };
+
+    /**
+     * @brief Gets the resulting mesh upon performing adaptive extraction
+     * @param[in] signedDistanceFunc Signed distance function
+     * @param[in] bounds Shape bounds
+     * @param[in] cellSize Size of the smallest cells
+     * @param[out] outputTriangles Vector where the triangles will be placed
+     * @param[in] errorThreshold Largest deviation of the function from the trilinear interpolation inside a leaf crossed by the surface
+     */
+    template <typename DensityFunc>
+    void OctreeMesher::GetMesh(DensityFunc&& signedDistanceFunc, const AABB& bounds, float cellSize, std::vector<Triangle>& outputTriangles, float errorThreshold)
+    {
+        std::vector<glm::vec3> vertices;
+        std::vector<uint32_t> indices;
+        GetIndexedMesh(signedDistanceFunc, bounds, cellSize, vertices, indices, errorThreshold);
+
+        const size_t firstTriangle = outputTriangles.size();
+        outputTriangles.resize(firstTriangle + indices.size() / 3);
+        for (size_t i = 0; i < indices.size() / 3; ++i)
+        {
+            for (int j = 0; j < 3; ++j)
+            {
+                outputTriangles[firstTriangle + i].vertices[j] = vertices[indices[i * 3 + j]];
+            }
+        }
+    }
+
+    /**
+     * @brief Gets the resulting indexed mesh upon performing adaptive extraction
+     * @param[in] signedDistanceFunc Signed distance function
+     * @param[in] bounds Shape bounds
+     * @param[in] cellSize Size of the smallest cells
+     * @param[out] outputVertices Vector where the vertex positions will be placed
+     * @param[out] outputIndices Vector where the triangle vertex indices will be placed
+     * @param[in] errorThreshold Largest deviation of the function from the trilinear interpolation inside a leaf crossed by the surface
+     * @return Number of function samples taken
+     */
+    template <typename DensityFunc>
+    size_t OctreeMesher::GetIndexedMesh(DensityFunc&& signedDistanceFunc, const AABB& bounds, float cellSize, std::vector<glm::vec3>& outputVertices, std::vector<uint32_t>& outputIndices, float errorThreshold)
+    {
+        glm::ivec3 numCells = MarchingCubes::GetCellCount(bounds, cellSize);
+        if ((numCells.x <= 0) || (numCells.y <= 0) || (numCells.z <= 0))
+        {
+            return 0;
+        }
+
+        OctreeMesher octree(numCells, errorThreshold);
+
+        std::vector<float> xs, ys, zs, values;
+        while (!octree.GetRequestedPoints().empty())
+        {
+            const std::vector<glm::ivec3>& points = octree.GetRequestedPoints();
+            xs.resize(points.size());
+            ys.resize(points.size());
+            zs.resize(points.size());
+            values.resize(points.size());
+            for (size_t i = 0; i < points.size(); ++i)
+            {
+                glm::vec3 position = bounds.min + glm::vec3(points[i]) * cellSize;
+                xs[i] = position.x;
+                ys[i] = position.y;
+                zs[i] = position.z;
+            }
+
+            EvaluateDensityBatch(signedDistanceFunc, xs.data(), ys.data(), zs.data(), values.data(), points.size());
+            octree.AddSamples(values);
+        }
+
+        octree.Polygonize(bounds.min, cellSize, outputVertices, outputIndices);
+        return octree.GetSampleCount();
+    }
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+namespace MarchingCubes
+{
+    /**
+     * @brief Gets the number of threads to use when none is specified
+     * @return Number of hardware threads, or 1 if unknown
+     */
+    inline int GetDefaultThreadCount()
+    {
+        return std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    }
+
+    /**
+     * @brief Splits [begin, end) into contiguous ranges and processes them concurrently.
+     *
+     * The calling thread processes the last range, so no thread is spawned when
+     * numThreads is 1 or the range is too small to split.
+     * @param[in] begin First index
+     * @param[in] end One past the last index
+     * @param[in] numThreads Maximum number of threads to use
+     * @param[in] func Function taking (rangeBegin, rangeEnd)
+     */
+    template <typename Func>
+    void ParallelFor(int begin, int end, int numThreads, const Func& func)
+    {
+        const int count = end - begin;
+        if (count <= 0)
+        {
+            return;
+        }
+
+        const int numRanges = std::max(1, std::min(numThreads, count));
+
+        std::vector<std::thread> threads;
+        threads.reserve(numRanges - 1);
+
+        int rangeBegin = begin;
+        for (int i = 0; i < numRanges; ++i)
+        {
+            const int rangeEnd = begin + static_cast<int>(static_cast<long long>(count) * (i + 1) / numRanges);
+            if (i == numRanges - 1)
+            {
+                func(rangeBegin, rangeEnd);
+            }
+            else
+            {
+                threads.emplace_back(func, rangeBegin, rangeEnd);
+            }
+            rangeBegin = rangeEnd;
+        }
+
+        for (size_t i = 0; i < threads.size(); ++i)
+        {
+            threads[i].join();
+        }
+    }
+}
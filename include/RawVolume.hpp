@@ -0,0 +1,143 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace MarchingCubes
+{
+    /**
+     * Type of the samples of a raw volume
+     */
+    enum class RawSampleType : uint32_t
+    {
+        UInt8 = 0,
+        UInt16 = 1,
+        Float32 = 2
+    };
+
+    /**
+     * Header at the start of a raw volume file, in little-endian byte order.
+     * The samples follow it, x varying fastest, then y, then z.
+     */
+    struct RawVolumeHeader
+    {
+        /**
+         * Identifies the file format, "RAWV"
+         */
+        char magic[4];
+
+        /**
+         * RawSampleType of the samples
+         */
+        uint32_t sampleType;
+
+        /**
+         * Number of samples along each axis
+         */
+        uint32_t numSamples[3];
+
+        /**
+         * Distance between two samples along each axis
+         */
+        float spacing[3];
+    };
+
+    /**
+     * Read-only memory mapping of a raw volume file.
+     *
+     * Volumes can be much larger than the memory, so they are meant to be read one z-slice at a
+     * time, from front to back. The slices already read can be released, so the pages of the file
+     * do not pile up in memory.
+     */
+    class RawVolume
+    {
+    public:
+        /**
+         * @brief Constructor
+         */
+        RawVolume();
+
+        /**
+         * @brief Destructor
+         */
+        ~RawVolume();
+
+        RawVolume(const RawVolume&) = delete;
+        void operator=(const RawVolume&) = delete;
+
+        /**
+         * @brief Maps a raw volume file, and checks its header
+         * @param[in] path File path
+         * @return False if the file cannot be mapped, or is not a valid raw volume
+         */
+        bool Open(const std::string& path);
+
+        /**
+         * @brief Unmaps the file
+         */
+        void Close();
+
+        /**
+         * @brief Gets the number of samples along each axis
+         * @return Number of samples
+         */
+        glm::ivec3 GetNumSamples() const;
+
+        /**
+         * @brief Gets the distance between two samples along each axis
+         * @return Sample spacing
+         */
+        glm::vec3 GetSpacing() const;
+
+        /**
+         * @brief Gets the type of the samples
+         * @return Sample type
+         */
+        RawSampleType GetSampleType() const;
+
+        /**
+         * @brief Reads a z-slice of samples, as a density function whose surface is at the isovalue
+         * @param[in] z Z-index of the slice
+         * @param[in] isovalue Sample value of the surface. Samples above it are inside.
+         * @param[out] outputValues Array where the numSamples.x * numSamples.y values will be placed, x varying fastest
+         */
+        void ReadSlice(int z, float isovalue, float* outputValues) const;
+
+        /**
+         * @brief Lets the system drop the pages of the slices before a z-slice from memory
+         * @param[in] z Z-index of the first slice still needed
+         */
+        void ReleaseSlicesBefore(int z);
+
+    private:
+        /**
+         * @brief Gets the size of a sample
+         * @param[in] sampleType Sample type
+         * @return Size in bytes, or 0 for unknown types
+         */
+        static size_t GetSampleSize(RawSampleType sampleType);
+
+        /**
+         * Mapped file, or null
+         */
+        unsigned char* m_data;
+
+        /**
+         * Size of the mapped file
+         */
+        size_t m_size;
+
+        /**
+         * Size at the start of the mapping already released
+         */
+        size_t m_releasedSize;
+
+        /**
+         * File header
+         */
+        RawVolumeHeader m_header;
+    };
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include "RawVolume.hpp"
+#include "Triangle.hpp"
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace MarchingCubes
+{
+    /**
+     * Out-of-core marching cubes over raw volume files.
+     *
+     * The volume is streamed through the mesher one slab of cells at a time, from front to back:
+     * only the two z-slices around the slab are kept, converted to floats, and the triangles of
+     * every slab are handed over before the next one is read. Memory use is proportional to
+     * numSamples.x * numSamples.y rather than to the whole volume, and the file is read sequentially.
+     */
+    class RawVolumeMesher
+    {
+    public:
+        /**
+         * @brief Gets the isosurface of a raw volume, one slab of cells at a time
+         * @param[in] volume Raw volume. The slices are released once meshed.
+         * @param[in] isovalue Sample value of the surface. Samples above it are inside.
+         * @param[in] writeTriangles Function receiving the triangles of every slab, in units of the sample spacing from the first sample
+         * @return Total number of triangles
+         */
+        static size_t GetMesh(RawVolume& volume, float isovalue, const std::function<void(const std::vector<Triangle>&)>& writeTriangles);
+
+        /**
+         * @brief Writes the isosurface of a raw volume to a binary STL file, slab by slab
+         * @param[in] volume Raw volume. The slices are released once meshed.
+         * @param[in] isovalue Sample value of the surface. Samples above it are inside.
+         * @param[in] path Path of the STL file
+         * @return False if the file cannot be written
+         */
+        static bool WriteStl(RawVolume& volume, float isovalue, const std::string& path);
+    };
+}
@@ -0,0 +1,456 @@
+#pragma once
+
+#include <cstddef>
+
+namespace MarchingCubes
+{
+    // The following data originates from Eric Lengyel's Transvoxel Algorithm.
+    // http://transvoxel.org/
+
+    // The RegularCellData structure holds information about the triangulation
+    // used for a single equivalence class in the modified Marching Cubes algorithm,
+    // described in Section 3.2.
+    struct RegularCellData
+    {
+        unsigned char	geometryCounts;		// High nibble is vertex count, low nibble is triangle count.
+        unsigned char	vertexIndex[15];	// Groups of 3 indexes giving the triangulation.
+        
+        constexpr long GetVertexCount() const
+        {
+            return (geometryCounts >> 4);
+        }
+        
+        constexpr long GetTriangleCount() const
+        {
+            return (geometryCounts & 0x0F);
+        }
+    };
+
+    /**
+     * Regular cell tables of the Transvoxel Algorithm, read at compile time to build
+     * the flattened case table below
+     */
+    struct RegularCellTables
+    {
+        // The regularCellClass table maps an 8-bit regular Marching Cubes case index to
+        // an equivalence class index. Even though there are 18 equivalence classes in our
+        // modified Marching Cubes algorithm, a couple of them use the same exact triangulations,
+        // just with different vertex locations. We combined those classes for this table so
+        // that the class index ranges from 0 to 15.
+        static constexpr unsigned char regularCellClass[256] =
+        {
+            0x00, 0x01, 0x01, 0x03, 0x01, 0x03, 0x02, 0x04, 0x01, 0x02, 0x03, 0x04, 0x03, 0x04, 0x04, 0x03,
+            0x01, 0x03, 0x02, 0x04, 0x02, 0x04, 0x06, 0x0C, 0x02, 0x05, 0x05, 0x0B, 0x05, 0x0A, 0x07, 0x04,
+            0x01, 0x02, 0x03, 0x04, 0x02, 0x05, 0x05, 0x0A, 0x02, 0x06, 0x04, 0x0C, 0x05, 0x07, 0x0B, 0x04,
+            0x03, 0x04, 0x04, 0x03, 0x05, 0x0B, 0x07, 0x04, 0x05, 0x07, 0x0A, 0x04, 0x08, 0x0E, 0x0E, 0x03,
+            0x01, 0x02, 0x02, 0x05, 0x03, 0x04, 0x05, 0x0B, 0x02, 0x06, 0x05, 0x07, 0x04, 0x0C, 0x0A, 0x04,
+            0x03, 0x04, 0x05, 0x0A, 0x04, 0x03, 0x07, 0x04, 0x05, 0x07, 0x08, 0x0E, 0x0B, 0x04, 0x0E, 0x03,
+            0x02, 0x06, 0x05, 0x07, 0x05, 0x07, 0x08, 0x0E, 0x06, 0x09, 0x07, 0x0F, 0x07, 0x0F, 0x0E, 0x0D,
+            0x04, 0x0C, 0x0B, 0x04, 0x0A, 0x04, 0x0E, 0x03, 0x07, 0x0F, 0x0E, 0x0D, 0x0E, 0x0D, 0x02, 0x01,
+            0x01, 0x02, 0x02, 0x05, 0x02, 0x05, 0x06, 0x07, 0x03, 0x05, 0x04, 0x0A, 0x04, 0x0B, 0x0C, 0x04,
+            0x02, 0x05, 0x06, 0x07, 0x06, 0x07, 0x09, 0x0F, 0x05, 0x08, 0x07, 0x0E, 0x07, 0x0E, 0x0F, 0x0D,
+            0x03, 0x05, 0x04, 0x0B, 0x05, 0x08, 0x07, 0x0E, 0x04, 0x07, 0x03, 0x04, 0x0A, 0x0E, 0x04, 0x03,
+            0x04, 0x0A, 0x0C, 0x04, 0x07, 0x0E, 0x0F, 0x0D, 0x0B, 0x0E, 0x04, 0x03, 0x0E, 0x02, 0x0D, 0x01,
+            0x03, 0x05, 0x05, 0x08, 0x04, 0x0A, 0x07, 0x0E, 0x04, 0x07, 0x0B, 0x0E, 0x03, 0x04, 0x04, 0x03,
+            0x04, 0x0B, 0x07, 0x0E, 0x0C, 0x04, 0x0F, 0x0D, 0x0A, 0x0E, 0x0E, 0x02, 0x04, 0x03, 0x0D, 0x01,
+            0x04, 0x07, 0x0A, 0x0E, 0x0B, 0x0E, 0x0E, 0x02, 0x0C, 0x0F, 0x04, 0x0D, 0x04, 0x0D, 0x03, 0x01,
+            0x03, 0x04, 0x04, 0x03, 0x04, 0x03, 0x0D, 0x01, 0x04, 0x0D, 0x03, 0x01, 0x03, 0x01, 0x01, 0x00
+        };
+
+
+        // The regularCellData table holds the triangulation data for all 16 distinct classes to
+        // which a case can be mapped by the regularCellClass table.
+        static constexpr RegularCellData regularCellData[16] =
+        {
+            {0x00, {}},
+            {0x31, {0, 1, 2}},
+            {0x62, {0, 1, 2, 3, 4, 5}},
+            {0x42, {0, 1, 2, 0, 2, 3}},
+            {0x53, {0, 1, 4, 1, 3, 4, 1, 2, 3}},
+            {0x73, {0, 1, 2, 0, 2, 3, 4, 5, 6}},
+            {0x93, {0, 1, 2, 3, 4, 5, 6, 7, 8}},
+            {0x84, {0, 1, 4, 1, 3, 4, 1, 2, 3, 5, 6, 7}},
+            {0x84, {0, 1, 2, 0, 2, 3, 4, 5, 6, 4, 6, 7}},
+            {0xC4, {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11}},
+            {0x64, {0, 4, 5, 0, 1, 4, 1, 3, 4, 1, 2, 3}},
+            {0x64, {0, 5, 4, 0, 4, 1, 1, 4, 3, 1, 3, 2}},
+            {0x64, {0, 4, 5, 0, 3, 4, 0, 1, 3, 1, 2, 3}},
+            {0x64, {0, 1, 2, 0, 2, 3, 0, 3, 4, 0, 4, 5}},
+            {0x75, {0, 1, 2, 0, 2, 3, 0, 3, 4, 0, 4, 5, 0, 5, 6}},
+            {0x95, {0, 4, 5, 0, 3, 4, 0, 1, 3, 1, 2, 3, 6, 7, 8}}
+        };
+
+
+        // The regularVertexData table gives the vertex locations for every one of the 256 possible
+        // cases in the modified Marching Cubes algorithm. Each 16-bit value also provides information
+        // about whether a vertex can be reused from a neighboring cell. See Section 3.3 for details.
+        // The low byte contains the indexes for the two endpoints of the edge on which the vertex lies,
+        // as numbered in Figure 3.7. The high byte contains the vertex reuse data shown in Figure 3.8.
+        static constexpr unsigned short regularVertexData[256][12] =
+        {
+            {},
+            {0x6201, 0x5102, 0x3304},
+            {0x6201, 0x2315, 0x4113},
+            {0x5102, 0x3304, 0x2315, 0x4113},
+            {0x5102, 0x4223, 0x1326},
+            {0x3304, 0x6201, 0x4223, 0x1326},
+            {0x6201, 0x2315, 0x4113, 0x5102, 0x4223, 0x1326},
+            {0x4223, 0x1326, 0x3304, 0x2315, 0x4113},
+            {0x4113, 0x8337, 0x4223},
+            {0x6201, 0x5102, 0x3304, 0x4223, 0x4113, 0x8337},
+            {0x6201, 0x2315, 0x8337, 0x4223},
+            {0x5102, 0x3304, 0x2315, 0x8337, 0x4223},
+            {0x5102, 0x4113, 0x8337, 0x1326},
+            {0x4113, 0x8337, 0x1326, 0x3304, 0x6201},
+            {0x6201, 0x2315, 0x8337, 0x1326, 0x5102},
+            {0x3304, 0x2315, 0x8337, 0x1326},
+            {0x3304, 0x1146, 0x2245},
+            {0x6201, 0x5102, 0x1146, 0x2245},
+            {0x6201, 0x2315, 0x4113, 0x3304, 0x1146, 0x2245},
+            {0x2315, 0x4113, 0x5102, 0x1146, 0x2245},
+            {0x5102, 0x4223, 0x1326, 0x3304, 0x1146, 0x2245},
+            {0x1146, 0x2245, 0x6201, 0x4223, 0x1326},
+            {0x3304, 0x1146, 0x2245, 0x6201, 0x2315, 0x4113, 0x5102, 0x4223, 0x1326},
+            {0x4223, 0x1326, 0x1146, 0x2245, 0x2315, 0x4113},
+            {0x4223, 0x4113, 0x8337, 0x3304, 0x1146, 0x2245},
+            {0x6201, 0x5102, 0x1146, 0x2245, 0x4223, 0x4113, 0x8337},
+            {0x4223, 0x6201, 0x2315, 0x8337, 0x3304, 0x1146, 0x2245},
+            {0x4223, 0x8337, 0x2315, 0x2245, 0x1146, 0x5102},
+            {0x5102, 0x4113, 0x8337, 0x1326, 0x3304, 0x1146, 0x2245},
+            {0x4113, 0x8337, 0x1326, 0x1146, 0x2245, 0x6201},
+            {0x6201, 0x2315, 0x8337, 0x1326, 0x5102, 0x3304, 0x1146, 0x2245},
+            {0x2245, 0x2315, 0x8337, 0x1326, 0x1146},
+            {0x2315, 0x2245, 0x8157},
+            {0x6201, 0x5102, 0x3304, 0x2315, 0x2245, 0x8157},
+            {0x4113, 0x6201, 0x2245, 0x8157},
+            {0x2245, 0x8157, 0x4113, 0x5102, 0x3304},
+            {0x5102, 0x4223, 0x1326, 0x2315, 0x2245, 0x8157},
+            {0x6201, 0x4223, 0x1326, 0x3304, 0x2315, 0x2245, 0x8157},
+            {0x6201, 0x2245, 0x8157, 0x4113, 0x5102, 0x4223, 0x1326},
+            {0x4223, 0x1326, 0x3304, 0x2245, 0x8157, 0x4113},
+            {0x4223, 0x4113, 0x8337, 0x2315, 0x2245, 0x8157},
+            {0x6201, 0x5102, 0x3304, 0x4223, 0x4113, 0x8337, 0x2315, 0x2245, 0x8157},
+            {0x8337, 0x4223, 0x6201, 0x2245, 0x8157},
+            {0x5102, 0x3304, 0x2245, 0x8157, 0x8337, 0x4223},
+            {0x5102, 0x4113, 0x8337, 0x1326, 0x2315, 0x2245, 0x8157},
+            {0x4113, 0x8337, 0x1326, 0x3304, 0x6201, 0x2315, 0x2245, 0x8157},
+            {0x5102, 0x1326, 0x8337, 0x8157, 0x2245, 0x6201},
+            {0x8157, 0x8337, 0x1326, 0x3304, 0x2245},
+            {0x2315, 0x3304, 0x1146, 0x8157},
+            {0x6201, 0x5102, 0x1146, 0x8157, 0x2315},
+            {0x3304, 0x1146, 0x8157, 0x4113, 0x6201},
+            {0x4113, 0x5102, 0x1146, 0x8157},
+            {0x2315, 0x3304, 0x1146, 0x8157, 0x5102, 0x4223, 0x1326},
+            {0x1326, 0x4223, 0x6201, 0x2315, 0x8157, 0x1146},
+            {0x3304, 0x1146, 0x8157, 0x4113, 0x6201, 0x5102, 0x4223, 0x1326},
+            {0x1326, 0x1146, 0x8157, 0x4113, 0x4223},
+            {0x2315, 0x3304, 0x1146, 0x8157, 0x4223, 0x4113, 0x8337},
+            {0x6201, 0x5102, 0x1146, 0x8157, 0x2315, 0x4223, 0x4113, 0x8337},
+            {0x3304, 0x1146, 0x8157, 0x8337, 0x4223, 0x6201},
+            {0x4223, 0x5102, 0x1146, 0x8157, 0x8337},
+            {0x2315, 0x3304, 0x1146, 0x8157, 0x5102, 0x4113, 0x8337, 0x1326},
+            {0x6201, 0x4113, 0x8337, 0x1326, 0x1146, 0x8157, 0x2315},
+            {0x6201, 0x3304, 0x1146, 0x8157, 0x8337, 0x1326, 0x5102},
+            {0x1326, 0x1146, 0x8157, 0x8337},
+            {0x1326, 0x8267, 0x1146},
+            {0x6201, 0x5102, 0x3304, 0x1326, 0x8267, 0x1146},
+            {0x6201, 0x2315, 0x4113, 0x1326, 0x8267, 0x1146},
+            {0x5102, 0x3304, 0x2315, 0x4113, 0x1326, 0x8267, 0x1146},
+            {0x5102, 0x4223, 0x8267, 0x1146},
+            {0x3304, 0x6201, 0x4223, 0x8267, 0x1146},
+            {0x5102, 0x4223, 0x8267, 0x1146, 0x6201, 0x2315, 0x4113},
+            {0x1146, 0x8267, 0x4223, 0x4113, 0x2315, 0x3304},
+            {0x4113, 0x8337, 0x4223, 0x1326, 0x8267, 0x1146},
+            {0x6201, 0x5102, 0x3304, 0x4223, 0x4113, 0x8337, 0x1326, 0x8267, 0x1146},
+            {0x6201, 0x2315, 0x8337, 0x4223, 0x1326, 0x8267, 0x1146},
+            {0x5102, 0x3304, 0x2315, 0x8337, 0x4223, 0x1326, 0x8267, 0x1146},
+            {0x8267, 0x1146, 0x5102, 0x4113, 0x8337},
+            {0x6201, 0x4113, 0x8337, 0x8267, 0x1146, 0x3304},
+            {0x6201, 0x2315, 0x8337, 0x8267, 0x1146, 0x5102},
+            {0x1146, 0x3304, 0x2315, 0x8337, 0x8267},
+            {0x3304, 0x1326, 0x8267, 0x2245},
+            {0x1326, 0x8267, 0x2245, 0x6201, 0x5102},
+            {0x3304, 0x1326, 0x8267, 0x2245, 0x6201, 0x2315, 0x4113},
+            {0x1326, 0x8267, 0x2245, 0x2315, 0x4113, 0x5102},
+            {0x5102, 0x4223, 0x8267, 0x2245, 0x3304},
+            {0x6201, 0x4223, 0x8267, 0x2245},
+            {0x5102, 0x4223, 0x8267, 0x2245, 0x3304, 0x6201, 0x2315, 0x4113},
+            {0x4113, 0x4223, 0x8267, 0x2245, 0x2315},
+            {0x3304, 0x1326, 0x8267, 0x2245, 0x4223, 0x4113, 0x8337},
+            {0x1326, 0x8267, 0x2245, 0x6201, 0x5102, 0x4223, 0x4113, 0x8337},
+            {0x3304, 0x1326, 0x8267, 0x2245, 0x4223, 0x6201, 0x2315, 0x8337},
+            {0x5102, 0x1326, 0x8267, 0x2245, 0x2315, 0x8337, 0x4223},
+            {0x3304, 0x2245, 0x8267, 0x8337, 0x4113, 0x5102},
+            {0x8337, 0x8267, 0x2245, 0x6201, 0x4113},
+            {0x5102, 0x6201, 0x2315, 0x8337, 0x8267, 0x2245, 0x3304},
+            {0x2315, 0x8337, 0x8267, 0x2245},
+            {0x2315, 0x2245, 0x8157, 0x1326, 0x8267, 0x1146},
+            {0x6201, 0x5102, 0x3304, 0x2315, 0x2245, 0x8157, 0x1326, 0x8267, 0x1146},
+            {0x6201, 0x2245, 0x8157, 0x4113, 0x1326, 0x8267, 0x1146},
+            {0x2245, 0x8157, 0x4113, 0x5102, 0x3304, 0x1326, 0x8267, 0x1146},
+            {0x4223, 0x8267, 0x1146, 0x5102, 0x2315, 0x2245, 0x8157},
+            {0x3304, 0x6201, 0x4223, 0x8267, 0x1146, 0x2315, 0x2245, 0x8157},
+            {0x4223, 0x8267, 0x1146, 0x5102, 0x6201, 0x2245, 0x8157, 0x4113},
+            {0x3304, 0x2245, 0x8157, 0x4113, 0x4223, 0x8267, 0x1146},
+            {0x4223, 0x4113, 0x8337, 0x2315, 0x2245, 0x8157, 0x1326, 0x8267, 0x1146},
+            {0x6201, 0x5102, 0x3304, 0x4223, 0x4113, 0x8337, 0x2315, 0x2245, 0x8157, 0x1326, 0x8267, 0x1146},
+            {0x8337, 0x4223, 0x6201, 0x2245, 0x8157, 0x1326, 0x8267, 0x1146},
+            {0x4223, 0x5102, 0x3304, 0x2245, 0x8157, 0x8337, 0x1326, 0x8267, 0x1146},
+            {0x8267, 0x1146, 0x5102, 0x4113, 0x8337, 0x2315, 0x2245, 0x8157},
+            {0x6201, 0x4113, 0x8337, 0x8267, 0x1146, 0x3304, 0x2315, 0x2245, 0x8157},
+            {0x8337, 0x8267, 0x1146, 0x5102, 0x6201, 0x2245, 0x8157},
+            {0x3304, 0x2245, 0x8157, 0x8337, 0x8267, 0x1146},
+            {0x8157, 0x2315, 0x3304, 0x1326, 0x8267},
+            {0x8267, 0x8157, 0x2315, 0x6201, 0x5102, 0x1326},
+            {0x8267, 0x1326, 0x3304, 0x6201, 0x4113, 0x8157},
+            {0x8267, 0x8157, 0x4113, 0x5102, 0x1326},
+            {0x5102, 0x4223, 0x8267, 0x8157, 0x2315, 0x3304},
+            {0x2315, 0x6201, 0x4223, 0x8267, 0x8157},
+            {0x3304, 0x5102, 0x4223, 0x8267, 0x8157, 0x4113, 0x6201},
+            {0x4113, 0x4223, 0x8267, 0x8157},
+            {0x8157, 0x2315, 0x3304, 0x1326, 0x8267, 0x4223, 0x4113, 0x8337},
+            {0x8157, 0x2315, 0x6201, 0x5102, 0x1326, 0x8267, 0x4223, 0x4113, 0x8337},
+            {0x8157, 0x8337, 0x4223, 0x6201, 0x3304, 0x1326, 0x8267},
+            {0x5102, 0x1326, 0x8267, 0x8157, 0x8337, 0x4223},
+            {0x8267, 0x8157, 0x2315, 0x3304, 0x5102, 0x4113, 0x8337},
+            {0x6201, 0x4113, 0x8337, 0x8267, 0x8157, 0x2315},
+            {0x6201, 0x3304, 0x5102, 0x8337, 0x8267, 0x8157},
+            {0x8337, 0x8267, 0x8157},
+            {0x8337, 0x8157, 0x8267},
+            {0x6201, 0x5102, 0x3304, 0x8337, 0x8157, 0x8267},
+            {0x6201, 0x2315, 0x4113, 0x8337, 0x8157, 0x8267},
+            {0x5102, 0x3304, 0x2315, 0x4113, 0x8337, 0x8157, 0x8267},
+            {0x5102, 0x4223, 0x1326, 0x8337, 0x8157, 0x8267},
+            {0x6201, 0x4223, 0x1326, 0x3304, 0x8337, 0x8157, 0x8267},
+            {0x6201, 0x2315, 0x4113, 0x5102, 0x4223, 0x1326, 0x8337, 0x8157, 0x8267},
+            {0x4223, 0x1326, 0x3304, 0x2315, 0x4113, 0x8337, 0x8157, 0x8267},
+            {0x4113, 0x8157, 0x8267, 0x4223},
+            {0x4223, 0x4113, 0x8157, 0x8267, 0x6201, 0x5102, 0x3304},
+            {0x8157, 0x8267, 0x4223, 0x6201, 0x2315},
+            {0x3304, 0x2315, 0x8157, 0x8267, 0x4223, 0x5102},
+            {0x1326, 0x5102, 0x4113, 0x8157, 0x8267},
+            {0x8157, 0x4113, 0x6201, 0x3304, 0x1326, 0x8267},
+            {0x1326, 0x5102, 0x6201, 0x2315, 0x8157, 0x8267},
+            {0x8267, 0x1326, 0x3304, 0x2315, 0x8157},
+            {0x3304, 0x1146, 0x2245, 0x8337, 0x8157, 0x8267},
+            {0x6201, 0x5102, 0x1146, 0x2245, 0x8337, 0x8157, 0x8267},
+            {0x6201, 0x2315, 0x4113, 0x3304, 0x1146, 0x2245, 0x8337, 0x8157, 0x8267},
+            {0x2315, 0x4113, 0x5102, 0x1146, 0x2245, 0x8337, 0x8157, 0x8267},
+            {0x5102, 0x4223, 0x1326, 0x3304, 0x1146, 0x2245, 0x8337, 0x8157, 0x8267},
+            {0x1146, 0x2245, 0x6201, 0x4223, 0x1326, 0x8337, 0x8157, 0x8267},
+            {0x6201, 0x2315, 0x4113, 0x5102, 0x4223, 0x1326, 0x3304, 0x1146, 0x2245, 0x8337, 0x8157, 0x8267},
+            {0x4113, 0x4223, 0x1326, 0x1146, 0x2245, 0x2315, 0x8337, 0x8157, 0x8267},
+            {0x4223, 0x4113, 0x8157, 0x8267, 0x3304, 0x1146, 0x2245},
+            {0x6201, 0x5102, 0x1146, 0x2245, 0x4223, 0x4113, 0x8157, 0x8267},
+            {0x8157, 0x8267, 0x4223, 0x6201, 0x2315, 0x3304, 0x1146, 0x2245},
+            {0x2315, 0x8157, 0x8267, 0x4223, 0x5102, 0x1146, 0x2245},
+            {0x1326, 0x5102, 0x4113, 0x8157, 0x8267, 0x3304, 0x1146, 0x2245},
+            {0x1326, 0x1146, 0x2245, 0x6201, 0x4113, 0x8157, 0x8267},
+            {0x5102, 0x6201, 0x2315, 0x8157, 0x8267, 0x1326, 0x3304, 0x1146, 0x2245},
+            {0x1326, 0x1146, 0x2245, 0x2315, 0x8157, 0x8267},
+            {0x2315, 0x2245, 0x8267, 0x8337},
+            {0x2315, 0x2245, 0x8267, 0x8337, 0x6201, 0x5102, 0x3304},
+            {0x4113, 0x6201, 0x2245, 0x8267, 0x8337},
+            {0x5102, 0x4113, 0x8337, 0x8267, 0x2245, 0x3304},
+            {0x2315, 0x2245, 0x8267, 0x8337, 0x5102, 0x4223, 0x1326},
+            {0x6201, 0x4223, 0x1326, 0x3304, 0x8337, 0x2315, 0x2245, 0x8267},
+            {0x4113, 0x6201, 0x2245, 0x8267, 0x8337, 0x5102, 0x4223, 0x1326},
+            {0x4113, 0x4223, 0x1326, 0x3304, 0x2245, 0x8267, 0x8337},
+            {0x2315, 0x2245, 0x8267, 0x4223, 0x4113},
+            {0x2315, 0x2245, 0x8267, 0x4223, 0x4113, 0x6201, 0x5102, 0x3304},
+            {0x6201, 0x2245, 0x8267, 0x4223},
+            {0x3304, 0x2245, 0x8267, 0x4223, 0x5102},
+            {0x5102, 0x4113, 0x2315, 0x2245, 0x8267, 0x1326},
+            {0x4113, 0x2315, 0x2245, 0x8267, 0x1326, 0x3304, 0x6201},
+            {0x5102, 0x6201, 0x2245, 0x8267, 0x1326},
+            {0x3304, 0x2245, 0x8267, 0x1326},
+            {0x8267, 0x8337, 0x2315, 0x3304, 0x1146},
+            {0x5102, 0x1146, 0x8267, 0x8337, 0x2315, 0x6201},
+            {0x3304, 0x1146, 0x8267, 0x8337, 0x4113, 0x6201},
+            {0x8337, 0x4113, 0x5102, 0x1146, 0x8267},
+            {0x8267, 0x8337, 0x2315, 0x3304, 0x1146, 0x5102, 0x4223, 0x1326},
+            {0x1146, 0x8267, 0x8337, 0x2315, 0x6201, 0x4223, 0x1326},
+            {0x8267, 0x8337, 0x4113, 0x6201, 0x3304, 0x1146, 0x5102, 0x4223, 0x1326},
+            {0x4113, 0x4223, 0x1326, 0x1146, 0x8267, 0x8337},
+            {0x3304, 0x2315, 0x4113, 0x4223, 0x8267, 0x1146},
+            {0x2315, 0x6201, 0x5102, 0x1146, 0x8267, 0x4223, 0x4113},
+            {0x1146, 0x8267, 0x4223, 0x6201, 0x3304},
+            {0x5102, 0x1146, 0x8267, 0x4223},
+            {0x8267, 0x1326, 0x5102, 0x4113, 0x2315, 0x3304, 0x1146},
+            {0x6201, 0x4113, 0x2315, 0x1326, 0x1146, 0x8267},
+            {0x6201, 0x3304, 0x1146, 0x8267, 0x1326, 0x5102},
+            {0x1326, 0x1146, 0x8267},
+            {0x1326, 0x8337, 0x8157, 0x1146},
+            {0x8337, 0x8157, 0x1146, 0x1326, 0x6201, 0x5102, 0x3304},
+            {0x8337, 0x8157, 0x1146, 0x1326, 0x6201, 0x2315, 0x4113},
+            {0x4113, 0x5102, 0x3304, 0x2315, 0x1326, 0x8337, 0x8157, 0x1146},
+            {0x8337, 0x8157, 0x1146, 0x5102, 0x4223},
+            {0x6201, 0x4223, 0x8337, 0x8157, 0x1146, 0x3304},
+            {0x8337, 0x8157, 0x1146, 0x5102, 0x4223, 0x6201, 0x2315, 0x4113},
+            {0x4223, 0x8337, 0x8157, 0x1146, 0x3304, 0x2315, 0x4113},
+            {0x4223, 0x4113, 0x8157, 0x1146, 0x1326},
+            {0x4223, 0x4113, 0x8157, 0x1146, 0x1326, 0x6201, 0x5102, 0x3304},
+            {0x1146, 0x8157, 0x2315, 0x6201, 0x4223, 0x1326},
+            {0x4223, 0x5102, 0x3304, 0x2315, 0x8157, 0x1146, 0x1326},
+            {0x4113, 0x8157, 0x1146, 0x5102},
+            {0x6201, 0x4113, 0x8157, 0x1146, 0x3304},
+            {0x2315, 0x8157, 0x1146, 0x5102, 0x6201},
+            {0x2315, 0x8157, 0x1146, 0x3304},
+            {0x2245, 0x3304, 0x1326, 0x8337, 0x8157},
+            {0x6201, 0x2245, 0x8157, 0x8337, 0x1326, 0x5102},
+            {0x2245, 0x3304, 0x1326, 0x8337, 0x8157, 0x6201, 0x2315, 0x4113},
+            {0x2245, 0x2315, 0x4113, 0x5102, 0x1326, 0x8337, 0x8157},
+            {0x4223, 0x8337, 0x8157, 0x2245, 0x3304, 0x5102},
+            {0x8157, 0x2245, 0x6201, 0x4223, 0x8337},
+            {0x2245, 0x3304, 0x5102, 0x4223, 0x8337, 0x8157, 0x4113, 0x6201, 0x2315},
+            {0x4223, 0x8337, 0x8157, 0x2245, 0x2315, 0x4113},
+            {0x4113, 0x8157, 0x2245, 0x3304, 0x1326, 0x4223},
+            {0x1326, 0x4223, 0x4113, 0x8157, 0x2245, 0x6201, 0x5102},
+            {0x8157, 0x2245, 0x3304, 0x1326, 0x4223, 0x6201, 0x2315},
+            {0x5102, 0x1326, 0x4223, 0x2315, 0x8157, 0x2245},
+            {0x3304, 0x5102, 0x4113, 0x8157, 0x2245},
+            {0x4113, 0x8157, 0x2245, 0x6201},
+            {0x5102, 0x6201, 0x2315, 0x8157, 0x2245, 0x3304},
+            {0x2315, 0x8157, 0x2245},
+            {0x1146, 0x1326, 0x8337, 0x2315, 0x2245},
+            {0x1146, 0x1326, 0x8337, 0x2315, 0x2245, 0x6201, 0x5102, 0x3304},
+            {0x6201, 0x2245, 0x1146, 0x1326, 0x8337, 0x4113},
+            {0x2245, 0x1146, 0x1326, 0x8337, 0x4113, 0x5102, 0x3304},
+            {0x5102, 0x1146, 0x2245, 0x2315, 0x8337, 0x4223},
+            {0x1146, 0x3304, 0x6201, 0x4223, 0x8337, 0x2315, 0x2245},
+            {0x8337, 0x4113, 0x6201, 0x2245, 0x1146, 0x5102, 0x4223},
+            {0x4223, 0x8337, 0x4113, 0x3304, 0x2245, 0x1146},
+            {0x4113, 0x2315, 0x2245, 0x1146, 0x1326, 0x4223},
+            {0x1146, 0x1326, 0x4223, 0x4113, 0x2315, 0x2245, 0x6201, 0x5102, 0x3304},
+            {0x1326, 0x4223, 0x6201, 0x2245, 0x1146},
+            {0x4223, 0x5102, 0x3304, 0x2245, 0x1146, 0x1326},
+            {0x2245, 0x1146, 0x5102, 0x4113, 0x2315},
+            {0x4113, 0x2315, 0x2245, 0x1146, 0x3304, 0x6201},
+            {0x6201, 0x2245, 0x1146, 0x5102},
+            {0x3304, 0x2245, 0x1146},
+            {0x3304, 0x1326, 0x8337, 0x2315},
+            {0x5102, 0x1326, 0x8337, 0x2315, 0x6201},
+            {0x6201, 0x3304, 0x1326, 0x8337, 0x4113},
+            {0x5102, 0x1326, 0x8337, 0x4113},
+            {0x4223, 0x8337, 0x2315, 0x3304, 0x5102},
+            {0x6201, 0x4223, 0x8337, 0x2315},
+            {0x3304, 0x5102, 0x4223, 0x8337, 0x4113, 0x6201},
+            {0x4113, 0x4223, 0x8337},
+            {0x4113, 0x2315, 0x3304, 0x1326, 0x4223},
+            {0x1326, 0x4223, 0x4113, 0x2315, 0x6201, 0x5102},
+            {0x3304, 0x1326, 0x4223, 0x6201},
+            {0x5102, 0x1326, 0x4223},
+            {0x5102, 0x4113, 0x2315, 0x3304},
+            {0x6201, 0x4113, 0x2315},
+            {0x6201, 0x3304, 0x5102},
+            {}
+        };
+    };
+
+    /**
+     * Everything needed to triangulate a cell of one case, flattened into a single
+     * cache line so that a cell costs one table fetch
+     */
+    struct alignas(64) RegularCase
+    {
+        /**
+         * Number of vertices and triangles
+         */
+        unsigned char numVertices;
+        unsigned char numTriangles;
+
+        /**
+         * Vertex data, in the format of the regularVertexData table: edge endpoints in the low byte, reuse data in the high byte
+         */
+        unsigned short vertexData[12];
+
+        /**
+         * Groups of 3 indices into vertexData giving the triangulation
+         */
+        unsigned char vertexIndices[15];
+
+        /**
+         * Number of vertices the cell creates instead of reusing, indexed by which of the
+         * preceding cells lie outside the lattice (bit 0: x - 1, bit 1: z - 1, bit 2: y - 1)
+         */
+        unsigned char numNewVertices[8];
+    };
+
+    static_assert(sizeof(RegularCase) == 64, "A flattened case should fill exactly one cache line");
+
+    /**
+     * Flattened case table, indexed by the 8-bit case index
+     */
+    struct RegularCaseTable
+    {
+        RegularCase cases[256];
+    };
+
+    /**
+     * Compile-time sequence of indices
+     */
+    template <size_t... Indices>
+    struct IndexSequence
+    {
+    };
+
+    /**
+     * Builds the index sequence 0, 1, ..., N - 1 as MakeIndexSequence<N>::Type
+     */
+    template <size_t N, size_t... Indices>
+    struct MakeIndexSequence : MakeIndexSequence<N - 1, N - 1, Indices...>
+    {
+    };
+
+    template <size_t... Indices>
+    struct MakeIndexSequence<0, Indices...>
+    {
+        typedef IndexSequence<Indices...> Type;
+    };
+
+    /**
+     * @brief Counts the vertices of a case that a cell creates instead of reusing
+     * @param[in] caseIndex Case index
+     * @param[in] numVertices Number of vertices of the case to look at
+     * @param[in] boundaryMask Which of the preceding cells lie outside the lattice, in the bits of the reuse direction
+     * @return Number of vertices created
+     */
+    constexpr unsigned char CountNewVertices(size_t caseIndex, long numVertices, int boundaryMask)
+    {
+        // Vertices are created when owned by the cell itself, or by a cell outside the lattice
+        return (numVertices == 0) ? 0 : static_cast<unsigned char>(CountNewVertices(caseIndex, numVertices - 1, boundaryMask)
+                                                                   + ((((RegularCellTables::regularVertexData[caseIndex][numVertices - 1] >> 12) & (8 | boundaryMask)) != 0) ? 1 : 0));
+    }
+
+    /**
+     * @brief Builds the flattened entry of a case from the regular cell tables
+     * @param[in] caseIndex Case index
+     * @param[in] classData Entry of the case's equivalence class in the regularCellData table
+     * @return Flattened case
+     */
+    template <size_t... VertexSlots, size_t... TriangleSlots>
+    constexpr RegularCase MakeRegularCase(size_t caseIndex, const RegularCellData& classData, IndexSequence<VertexSlots...>, IndexSequence<TriangleSlots...>)
+    {
+        return RegularCase{static_cast<unsigned char>(classData.GetVertexCount()),
+                           static_cast<unsigned char>(classData.GetTriangleCount()),
+                           {RegularCellTables::regularVertexData[caseIndex][VertexSlots]...},
+                           {classData.vertexIndex[TriangleSlots]...},
+                           {CountNewVertices(caseIndex, classData.GetVertexCount(), 0), CountNewVertices(caseIndex, classData.GetVertexCount(), 1),
+                            CountNewVertices(caseIndex, classData.GetVertexCount(), 2), CountNewVertices(caseIndex, classData.GetVertexCount(), 3),
+                            CountNewVertices(caseIndex, classData.GetVertexCount(), 4), CountNewVertices(caseIndex, classData.GetVertexCount(), 5),
+                            CountNewVertices(caseIndex, classData.GetVertexCount(), 6), CountNewVertices(caseIndex, classData.GetVertexCount(), 7)}};
+    }
+
+    /**
+     * @brief Builds the flattened case table from the regular cell tables
+     * @return Flattened case table
+     */
+    template <size_t... CaseIndices>
+    constexpr RegularCaseTable MakeRegularCaseTable(IndexSequence<CaseIndices...>)
+    {
+        return RegularCaseTable{{MakeRegularCase(CaseIndices,
+                                                 RegularCellTables::regularCellData[RegularCellTables::regularCellClass[CaseIndices]],
+                                                 MakeIndexSequence<12>::Type(),
+                                                 MakeIndexSequence<15>::Type())...}};
+    }
+}
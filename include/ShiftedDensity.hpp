@@ -0,0 +1,216 @@
+#pragma once
+
+#include "Engine/Geometry/BoundingVolumes/AABB.hpp"
+
+#include "DensityBatch.hpp"
+#include "DensityBounds.hpp"
+
+#include <glm/glm.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+namespace MarchingCubes
+{
+    /**
+     * Density source minus a constant, so that the surface at an isovalue becomes the surface at 0.
+     *
+     * Several isovalues can be meshed from the same samples, by shifting them back by the lowest
+     * isovalue. If the wrapped source provides GetDensityRange, a box is only reported as having a
+     * constant sign when the density stays above the highest isovalue or below the lowest one, so
+     * the blocks the lattice sampler skips are empty or solid for every isovalue. Likewise, if it
+     * provides EvaluateSignBatch, the densities it only gets the sign of are on the same side of
+     * every isovalue as the exact ones. If it provides GetLatticePart, that part is passed through.
+     */
+    template <typename DensitySource, bool = HasDensityRange<DensitySource>::value>
+    struct ShiftedDensity
+    {
+        /**
+         * Wrapped density source
+         */
+        DensitySource& source;
+
+        /**
+         * Lowest isovalue, subtracted from the density
+         */
+        float minIsovalue;
+
+        /**
+         * Highest isovalue
+         */
+        float maxIsovalue;
+
+        /**
+         * @brief Constructor
+         * @param[in] densitySource Density source to wrap
+         * @param[in] lowestIsovalue Lowest isovalue, subtracted from the density
+         * @param[in] highestIsovalue Highest isovalue
+         */
+        ShiftedDensity(DensitySource& densitySource, float lowestIsovalue, float highestIsovalue)
+            : source(densitySource)
+            , minIsovalue(lowestIsovalue)
+            , maxIsovalue(highestIsovalue)
+        {
+        }
+
+        /**
+         * @brief Evaluates the shifted density at n points
+         * @param[in] xs X-values of the points
+         * @param[in] ys Y-values of the points
+         * @param[in] zs Z-values of the points
+         * @param[out] out Array where the n densities will be placed
+         * @param[in] n Number of points
+         */
+        void EvaluateBatch(const float* xs, const float* ys, const float* zs, float* out, size_t n)
+        {
+            EvaluateDensityBatch(source, xs, ys, zs, out, n);
+            Shift(out, n);
+        }
+
+        /**
+         * @brief Evaluates the shifted density at n points, only getting the side of every isovalue right far from the surfaces
+         * @param[in] xs X-values of the points
+         * @param[in] ys Y-values of the points
+         * @param[in] zs Z-values of the points
+         * @param[out] out Array where the n densities will be placed
+         * @param[out] outputIsSignOnly Array of n flags, set to 1 for the densities that only have the right sign, 0 otherwise
+         * @param[in] n Number of points
+         * @param[in] lowestIsovalue Lowest shifted isovalue the flagged densities must also be on the right side of
+         * @param[in] highestIsovalue Highest shifted isovalue the flagged densities must also be on the right side of
+         */
+        template <typename Source = DensitySource>
+        typename std::enable_if<HasEvaluateSignBatch<Source>::value>::type
+        EvaluateSignBatch(const float* xs, const float* ys, const float* zs, float* out, unsigned char* outputIsSignOnly, size_t n, float lowestIsovalue = 0.0f, float highestIsovalue = 0.0f)
+        {
+            source.EvaluateSignBatch(xs, ys, zs, out, outputIsSignOnly, n, GetSourceMinIsovalue(lowestIsovalue), GetSourceMaxIsovalue(highestIsovalue));
+            Shift(out, n);
+        }
+
+        /**
+         * @brief Gets the part of the wrapped source that is evaluated over the whole lattice at once, unshifted
+         * @param[in] origin Position of the first grid corner
+         * @param[in] cellSize Cell size
+         * @param[in] numSamples Number of grid corners along each axis
+         * @param[out] outputValues Vector where the values at the grid corners will be placed, x varying fastest
+         */
+        template <typename Source = DensitySource>
+        typename std::enable_if<HasLatticePart<Source>::value>::type
+        GetLatticePart(const glm::vec3& origin, float cellSize, const glm::ivec3& numSamples, std::vector<float>& outputValues)
+        {
+            source.GetLatticePart(origin, cellSize, numSamples, outputValues);
+        }
+
+        /**
+         * @brief Like EvaluateBatch, with the part from GetLatticePart already known at each point
+         * @param[in] xs X-values of the points
+         * @param[in] ys Y-values of the points
+         * @param[in] zs Z-values of the points
+         * @param[in] latticePart Part of the wrapped source from GetLatticePart at each point
+         * @param[out] out Array where the n densities will be placed
+         * @param[in] n Number of points
+         */
+        template <typename Source = DensitySource>
+        typename std::enable_if<HasLatticePart<Source>::value>::type
+        EvaluateBatch(const float* xs, const float* ys, const float* zs, const float* latticePart, float* out, size_t n)
+        {
+            source.EvaluateBatch(xs, ys, zs, latticePart, out, n);
+            Shift(out, n);
+        }
+
+        /**
+         * @brief Like EvaluateSignBatch, with the part from GetLatticePart already known at each point
+         * @param[in] xs X-values of the points
+         * @param[in] ys Y-values of the points
+         * @param[in] zs Z-values of the points
+         * @param[in] latticePart Part of the wrapped source from GetLatticePart at each point
+         * @param[out] out Array where the n densities will be placed
+         * @param[out] outputIsSignOnly Array of n flags, set to 1 for the densities that only have the right sign, 0 otherwise
+         * @param[in] n Number of points
+         * @param[in] lowestIsovalue Lowest shifted isovalue the flagged densities must also be on the right side of
+         * @param[in] highestIsovalue Highest shifted isovalue the flagged densities must also be on the right side of
+         */
+        template <typename Source = DensitySource>
+        typename std::enable_if<HasLatticeSignBatch<Source>::value>::type
+        EvaluateSignBatch(const float* xs, const float* ys, const float* zs, const float* latticePart, float* out, unsigned char* outputIsSignOnly, size_t n, float lowestIsovalue = 0.0f, float highestIsovalue = 0.0f)
+        {
+            source.EvaluateSignBatch(xs, ys, zs, latticePart, out, outputIsSignOnly, n, GetSourceMinIsovalue(lowestIsovalue), GetSourceMaxIsovalue(highestIsovalue));
+            Shift(out, n);
+        }
+
+    private:
+        /**
+         * @brief Subtracts the lowest isovalue from n densities
+         * @param[in,out] values Array of n densities
+         * @param[in] n Number of densities
+         */
+        void Shift(float* values, size_t n) const
+        {
+            for (size_t i = 0; i < n; ++i)
+            {
+                values[i] -= minIsovalue;
+            }
+        }
+
+        /**
+         * @brief Gets the lowest isovalue of the wrapped source the signs must be right for
+         * @param[in] lowestIsovalue Lowest shifted isovalue requested
+         * @return Lowest isovalue of the wrapped source
+         */
+        float GetSourceMinIsovalue(float lowestIsovalue) const
+        {
+            return minIsovalue + std::min(lowestIsovalue, 0.0f);
+        }
+
+        /**
+         * @brief Gets the highest isovalue of the wrapped source the signs must be right for
+         * @param[in] highestIsovalue Highest shifted isovalue requested
+         * @return Highest isovalue of the wrapped source
+         */
+        float GetSourceMaxIsovalue(float highestIsovalue) const
+        {
+            return std::max(maxIsovalue, minIsovalue + highestIsovalue);
+        }
+    };
+
+    /**
+     * Density source minus a constant, for sources providing GetDensityRange
+     */
+    template <typename DensitySource>
+    struct ShiftedDensity<DensitySource, true> : ShiftedDensity<DensitySource, false>
+    {
+        /**
+         * @brief Constructor
+         * @param[in] densitySource Density source to wrap
+         * @param[in] lowestIsovalue Lowest isovalue, subtracted from the density
+         * @param[in] highestIsovalue Highest isovalue
+         */
+        ShiftedDensity(DensitySource& densitySource, float lowestIsovalue, float highestIsovalue)
+            : ShiftedDensity<DensitySource, false>(densitySource, lowestIsovalue, highestIsovalue)
+        {
+        }
+
+        /**
+         * @brief Gets bounds of the shifted density over a box, which only have a constant
+         * sign if the density is on the same side of every isovalue
+         * @param[in] box Box to bound the density over
+         * @param[out] outputMin Lower bound
+         * @param[out] outputMax Upper bound
+         */
+        void GetDensityRange(const AABB& box, float& outputMin, float& outputMax)
+        {
+            float minValue, maxValue;
+            this->source.GetDensityRange(box, minValue, maxValue);
+
+            outputMin = minValue - this->minIsovalue;
+            outputMax = maxValue - this->minIsovalue;
+
+            // Above the lowest isovalue, but not above all of them: make the range cross 0
+            if ((minValue > this->minIsovalue) && (minValue <= this->maxIsovalue))
+            {
+                outputMin = 0.0f;
+            }
+        }
+    };
+}
@@ -2,7 +2,9 @@
 
 #include "Engine/Geometry/BoundingVolumes/AABB.hpp"
 
+#include <algorithm>
 #include <cmath>
+#include <cstddef>
 
 /**
  * Sphere struct containing data and function
@@ -35,6 +37,59 @@ struct Sphere
                               powf(z - center[2], 2.0f));
     }
 
+    /**
+     * Returns the signed distance from the provided point to the surface.
+     * Allows the sphere to be passed directly as a density function.
+     * @param[in] x X-value
+     * @param[in] y Y-value
+     * @param[in] z Z-value
+     * @return Signed distance from the provided point to the surface.
+     */
+    float operator()(float x, float y, float z)
+    {
+        return GetSignedDistnaceToSurface(x, y, z);
+    }
+
+    /**
+     * Returns the signed distances from the provided points to the surface.
+     * @param[in] xs X-values of the points
+     * @param[in] ys Y-values of the points
+     * @param[in] zs Z-values of the points
+     * @param[out] out Array where the n signed distances will be placed
+     * @param[in] n Number of points
+     */
+    void EvaluateBatch(const float* xs, const float* ys, const float* zs, float* out, size_t n)
+    {
+        for (size_t i = 0; i < n; ++i)
+        {
+            out[i] = GetSignedDistnaceToSurface(xs[i], ys[i], zs[i]);
+        }
+    }
+
+    /**
+     * Returns bounds of the signed distance over a box.
+     * The bounds are exact: they are reached at the nearest and farthest points of the box.
+     * @param[in] box Box
+     * @param[out] outputMin Minimum signed distance over the box
+     * @param[out] outputMax Maximum signed distance over the box
+     */
+    void GetDensityRange(const AABB& box, float& outputMin, float& outputMax)
+    {
+        float nearest = 0.0f;
+        float farthest = 0.0f;
+        for (size_t i = 0; i < 3; ++i)
+        {
+            const float toMin = box.min[i] - center[i];
+            const float toMax = box.max[i] - center[i];
+            const float nearestOffset = (toMin > 0.0f) ? toMin : ((toMax < 0.0f) ? -toMax : 0.0f);
+            const float farthestOffset = std::max(std::abs(toMin), std::abs(toMax));
+            nearest += nearestOffset * nearestOffset;
+            farthest += farthestOffset * farthestOffset;
+        }
+        outputMin = radius - sqrtf(farthest);
+        outputMax = radius - sqrtf(nearest);
+    }
+
     /**
      * Gets the bounds of the sphere
      * @param[out] bounds Bounds of the sphere
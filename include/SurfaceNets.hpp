@@ -0,0 +1,127 @@
+#pragma once
+
+#include "Engine/Geometry/BoundingVolumes/AABB.hpp"
+
+#include "MarchingCubes.hpp"
+#include "Triangle.hpp"
+
+#include <glm/glm.hpp>
+
+#include <cstdint>
+#include <vector>
+
+namespace MarchingCubes
+{
+    /**
+     * Naive Surface Nets isosurface extraction.
+     *
+     * Places one vertex in every cell crossed by the surface, at the average of the
+     * intersections on its edges, and connects the vertices of the 4 cells around every
+     * intersected edge with a quad. This produces about as many triangles as marching
+     * cubes, but almost no slivers, and every vertex is shared by the quads around it.
+     *
+     * Quads are created for the edges starting at the grid corners inside the bounds,
+     * so the lattice is sampled one cell past the minimum corner. The quads of neighboring
+     * bounds tile without gaps, but the mesh of a single volume is shifted by up to one
+     * cell towards its minimum corner.
+     */
+    class SurfaceNets
+    {
+    public:
+        /**
+         * @brief Gets the resulting mesh upon performing surface nets
+         * @param[in] signedDistanceFunc Signed distance function
+         * @param[in] bounds Shape bounds
+         * @param[in] cellSize Cell size
+         * @param[out] outputTriangles Vector where the triangles will be placed
+         */
+        template <typename DensityFunc>
+        static void GetMesh(DensityFunc&& signedDistanceFunc, const AABB& bounds, float cellSize, std::vector<Triangle>& outputTriangles);
+
+        /**
+         * @brief Gets the resulting indexed mesh upon performing surface nets
+         * @param[in] signedDistanceFunc Signed distance function
+         * @param[in] bounds Shape bounds
+         * @param[in] cellSize Cell size
+         * @param[out] outputVertices Vector where the vertex positions will be placed
+         * @param[out] outputIndices Vector where the triangle vertex indices will be placed
+         */
+        template <typename DensityFunc>
+        static void GetIndexedMesh(DensityFunc&& signedDistanceFunc, const AABB& bounds, float cellSize, std::vector<glm::vec3>& outputVertices, std::vector<uint32_t>& outputIndices);
+
+    private:
+        friend class DualContouring;
+
+        /**
+         * @brief Extracts the isosurface from an already sampled lattice
+         * @param[in] lattice Sampled lattice of numCells + 1 cells, starting one cell before the bounds, x varying fastest
+         * @param[in] origin Position of the first grid corner of the lattice
+         * @param[in] cellSize Cell size
+         * @param[in] numCells Number of cells of the bounds along each axis
+         * @param[out] outputVertices Vector where the vertex positions will be placed
+         * @param[out] outputIndices Vector where the triangle vertex indices will be placed
+         */
+        static void Polygonize(const std::vector<float>& lattice, const glm::vec3& origin, float cellSize, const glm::ivec3& numCells, std::vector<glm::vec3>& outputVertices, std::vector<uint32_t>& outputIndices);
+
+        /**
+         * @brief Connects the vertices of the cells around every intersected edge starting at a grid corner inside the bounds
+         * @param[in] lattice Sampled lattice of numCells + 1 cells, starting one cell before the bounds, x varying fastest
+         * @param[in] numCells Number of cells of the bounds along each axis
+         * @param[in] cellVertices Vertex index of every lattice cell crossed by the surface, relative to firstVertex, x varying fastest
+         * @param[in] vertices Vertex positions
+         * @param[in] firstVertex Index in vertices of the first vertex of the mesh
+         * @param[out] outputIndices Vector where the triangle vertex indices will be placed
+         */
+        static void AddQuads(const std::vector<float>& lattice, const glm::ivec3& numCells, const std::vector<uint32_t>& cellVertices, const std::vector<glm::vec3>& vertices, size_t firstVertex, std::vector<uint32_t>& outputIndices);
+    };
+
+    /**
+     * @brief Gets the resulting mesh upon performing surface nets
+     * @param[in] signedDistanceFunc Signed distance function
+     * @param[in] bounds Shape bounds
+     * @param[in] cellSize Cell size
+     * @param[out] outputTriangles Vector where the triangles will be placed
+     */
+    template <typename DensityFunc>
+    void SurfaceNets::GetMesh(DensityFunc&& signedDistanceFunc, const AABB& bounds, float cellSize, std::vector<Triangle>& outputTriangles)
+    {
+        std::vector<glm::vec3> vertices;
+        std::vector<uint32_t> indices;
+        GetIndexedMesh(signedDistanceFunc, bounds, cellSize, vertices, indices);
+
+        const size_t firstTriangle = outputTriangles.size();
+        outputTriangles.resize(firstTriangle + indices.size() / 3);
+        for (size_t i = 0; i < indices.size() / 3; ++i)
+        {
+            for (int j = 0; j < 3; ++j)
+            {
+                outputTriangles[firstTriangle + i].vertices[j] = vertices[indices[i * 3 + j]];
+            }
+        }
+    }
+
+    /**
+     * @brief Gets the resulting indexed mesh upon performing surface nets
+     * @param[in] signedDistanceFunc Signed distance function
+     * @param[in] bounds Shape bounds
+     * @param[in] cellSize Cell size
+     * @param[out] outputVertices Vector where the vertex positions will be placed
+     * @param[out] outputIndices Vector where the triangle vertex indices will be placed
+     */
+    template <typename DensityFunc>
+    void SurfaceNets::GetIndexedMesh(DensityFunc&& signedDistanceFunc, const AABB& bounds, float cellSize, std::vector<glm::vec3>& outputVertices, std::vector<uint32_t>& outputIndices)
+    {
+        glm::ivec3 numCells = MarchingCubes::GetCellCount(bounds, cellSize);
+        if ((numCells.x <= 0) || (numCells.y <= 0) || (numCells.z <= 0))
+        {
+            return;
+        }
+
+        // The quads of the edges on the minimum faces use the cells just outside the bounds
+        const glm::vec3 origin = bounds.min - glm::vec3(cellSize);
+        std::vector<float> lattice;
+        MarchingCubes::SampleLattice(signedDistanceFunc, origin, cellSize, numCells + 1, lattice);
+
+        Polygonize(lattice, origin, cellSize, numCells, outputVertices, outputIndices);
+    }
+}
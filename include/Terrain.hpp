@@ -1,9 +1,18 @@
 #pragma once
 
+#include "Engine/Geometry/BoundingVolumes/AABB.hpp"
+
 #include "FastNoiseLite/FastNoiseLite.h"
+#include "ColumnCache.hpp"
+#include "NoiseBatch.hpp"
 
 #include <glm/glm.hpp>
 
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
 struct Terrain
 {
     FastNoiseLite noise[9];
@@ -11,6 +20,20 @@ struct Terrain
     float amplitudes[9] = { 2.0f, 1.0f, 5.0f, 3.0f, 0.5f, 3.0f, 8.0f, 0.75f, 1.0f };
     float frequencyFactors[9] = { 1.0f, 0.2f, 0.5f, 3.25f, 2.0f, 0.2f, 0.25f, 0.1f, 3.0f };
 
+    // Layers of 2D noise over the xz-plane instead of 3D noise. Their sum only depends on the
+    // column, so it is evaluated once per column of a lattice, and shared by the chunks stacked
+    // on top of each other through the column cache.
+    bool isLayer2D[9] = { false, false, false, false, false, false, false, false, false };
+
+    // Sums of the 2D layers over the columns of the lattices sampled lately
+    MarchingCubes::ColumnCache columnCache;
+
+    // Distance between the points of a world-aligned grid a 3D layer is sampled at and trilinearly
+    // interpolated from over a lattice, or 0 to sample it everywhere. The layers with the lowest
+    // frequencies barely change over a few voxels, so a lattice only samples them at the grid points
+    // around it. Off a lattice, the density is evaluated exactly.
+    float layerSampleSpacings[9] = { 0.0f, 4.0f, 0.0f, 0.0f, 0.0f, 4.0f, 4.0f, 4.0f, 0.0f };
+
     Terrain()
     {
         for (int i = 0; i < 9; ++i)
@@ -20,13 +43,292 @@ struct Terrain
         }
     }
 
+    bool IsLayerInterpolated(int layer) const
+    {
+        return !isLayer2D[layer] && (layerSampleSpacings[layer] > 0.0f);
+    }
+
+    // Bilinear interpolation in the yz-plane between the values at the corners of a grid face,
+    // corner bits 1 = z, 2 = y
+    static float InterpolateYZ(float value00, float value01, float value10, float value11, float ty, float tz)
+    {
+        const float z0 = value00 + (value10 - value00) * ty;
+        const float z1 = value01 + (value11 - value01) * ty;
+        return z0 + (z1 - z0) * tz;
+    }
+
+    // Height term, then the sum of the 2D layers, then the 3D layers, in the same order as the batch functions
     float DensityFunction(float x, float y, float z)
     {
-        float density = glm::clamp(-y, 0.0f, 1.0f) * 5.0f;
+        float columnValue = 0.0f;
+        for (int i = 0; i < 9; ++i)
+        {
+            if (isLayer2D[i])
+            {
+                columnValue += noise[i].GetNoise(x * frequencyFactors[i], z * frequencyFactors[i]) * amplitudes[i];
+            }
+        }
+
+        float density = glm::clamp(-y, 0.0f, 1.0f) * 5.0f + columnValue;
         for (int i = 0; i < 9; ++i)
         {
-            density += noise[i].GetNoise(x * frequencyFactors[i], y * frequencyFactors[i], z * frequencyFactors[i]) * amplitudes[i];
+            if (!isLayer2D[i])
+            {
+                density += noise[i].GetNoise(x * frequencyFactors[i], y * frequencyFactors[i], z * frequencyFactors[i]) * amplitudes[i];
+            }
         }
         return density;
     }
+
+    // Frequency of the noise generators, FastNoiseLite's default
+    static constexpr float noiseFrequency = 0.01f;
+
+    // Bounds of the density over a box, both exact and as sampled over a lattice. The height
+    // term is monotonic, so its bounds are exact. Each noise layer is bounded by its value at
+    // the box center plus its Lipschitz constant times the half diagonal, and by its amplitude
+    // times noiseMagnitudeBound, which caps the fast layers over large boxes. Over a lattice, an interpolated layer is a
+    // weighted mean of its values at grid points at most one spacing away from the box, so it
+    // is bounded over the box grown by one spacing. It costs one sample per query.
+    void GetDensityRange(const AABB& box, float& outputMin, float& outputMax)
+    {
+        const glm::vec3 center = (box.min + box.max) * 0.5f;
+
+        float noiseMin = 0.0f;
+        float noiseMax = 0.0f;
+        for (int i = 0; i < 9; ++i)
+        {
+            float layerValue;
+            if (isLayer2D[i])
+            {
+                layerValue = noise[i].GetNoise(center.x * frequencyFactors[i], center.z * frequencyFactors[i]) * amplitudes[i];
+            }
+            else
+            {
+                layerValue = noise[i].GetNoise(center.x * frequencyFactors[i], center.y * frequencyFactors[i], center.z * frequencyFactors[i]) * amplitudes[i];
+            }
+
+            const float margin = IsLayerInterpolated(i) ? layerSampleSpacings[i] : 0.0f;
+            const float halfDiagonal = glm::length(box.max - box.min + 2.0f * margin) * 0.5f;
+            const float layerLipschitz = MarchingCubes::noiseGradientBound * noiseFrequency * frequencyFactors[i] * amplitudes[i];
+            const float layerBound = amplitudes[i] * MarchingCubes::noiseMagnitudeBound;
+            noiseMin += std::max(layerValue - layerLipschitz * halfDiagonal, -layerBound);
+            noiseMax += std::min(layerValue + layerLipschitz * halfDiagonal, layerBound);
+        }
+
+        outputMin = glm::clamp(-box.max.y, 0.0f, 1.0f) * 5.0f + noiseMin;
+        outputMax = glm::clamp(-box.min.y, 0.0f, 1.0f) * 5.0f + noiseMax;
+    }
+
+    float operator()(float x, float y, float z)
+    {
+        return DensityFunction(x, y, z);
+    }
+
+    MarchingCubes::NoiseLayer GetNoiseLayer(int layer)
+    {
+        MarchingCubes::NoiseLayer noiseLayer;
+        noiseLayer.seed = seed[layer];
+        noiseLayer.scale = frequencyFactors[layer];
+        noiseLayer.frequency = noiseFrequency;
+        noiseLayer.amplitude = amplitudes[layer];
+        return noiseLayer;
+    }
+
+    // 3D layers sampled at every point, as evaluated by the batch functions. Over a lattice,
+    // the interpolated layers are in the lattice part instead.
+    int GetNoiseLayers(bool isOnLattice, MarchingCubes::NoiseLayer* outputLayers)
+    {
+        int numLayers = 0;
+        for (int layer = 0; layer < 9; ++layer)
+        {
+            if (!isLayer2D[layer] && !(isOnLattice && IsLayerInterpolated(layer)))
+            {
+                outputLayers[numLayers] = GetNoiseLayer(layer);
+                ++numLayers;
+            }
+        }
+        return numLayers;
+    }
+
+    // Sums of the 2D layers at n columns
+    void EvaluateColumnBatch(const float* xs, const float* zs, float* out, size_t n)
+    {
+        std::fill(out, out + n, 0.0f);
+        for (int layer = 0; layer < 9; ++layer)
+        {
+            if (isLayer2D[layer])
+            {
+                for (size_t i = 0; i < n; ++i)
+                {
+                    out[i] += noise[layer].GetNoise(xs[i] * frequencyFactors[layer], zs[i] * frequencyFactors[layer]) * amplitudes[layer];
+                }
+            }
+        }
+    }
+
+    // Sums of the 2D layers at the columns origin + (x, z) * cellSize, from the column cache
+    void GetColumnValues(const glm::vec2& origin, float cellSize, const glm::ivec2& numColumns, std::vector<float>& outputValues)
+    {
+        columnCache.GetValues(origin, cellSize, numColumns, [this](const float* xs, const float* zs, float* out, size_t n)
+        {
+            EvaluateColumnBatch(xs, zs, out, n);
+        }, outputValues);
+    }
+
+    // Sums of the 2D layers and the interpolated layers over a lattice. The 2D layers come from
+    // the column cache, and the interpolated layers are only sampled at the grid points around
+    // the lattice.
+    void GetLatticePart(const glm::vec3& origin, float cellSize, const glm::ivec3& numSamples, std::vector<float>& outputValues)
+    {
+        outputValues.assign(static_cast<size_t>(numSamples.x) * numSamples.y * numSamples.z, 0.0f);
+        if (std::find(isLayer2D, isLayer2D + 9, true) != isLayer2D + 9)
+        {
+            std::vector<float> columnValues;
+            GetColumnValues(glm::vec2(origin.x, origin.z), cellSize, glm::ivec2(numSamples.x, numSamples.z), columnValues);
+
+            size_t sampleIndex = 0;
+            for (int z = 0; z < numSamples.z; ++z)
+            {
+                for (int y = 0; y < numSamples.y; ++y)
+                {
+                    std::copy(columnValues.begin() + z * numSamples.x, columnValues.begin() + (z + 1) * numSamples.x, outputValues.begin() + sampleIndex);
+                    sampleIndex += numSamples.x;
+                }
+            }
+        }
+
+        for (int layer = 0; layer < 9; ++layer)
+        {
+            if (!IsLayerInterpolated(layer))
+            {
+                continue;
+            }
+
+            // Grid cell and weights of the grid corners along each axis, at the positions of the lattice sampler
+            const float spacing = layerSampleSpacings[layer];
+            glm::ivec3 gridMin(0);
+            glm::ivec3 gridMax(0);
+            std::vector<int> cellIndices[3];
+            std::vector<float> ts[3];
+            for (int axis = 0; axis < 3; ++axis)
+            {
+                cellIndices[axis].resize(numSamples[axis]);
+                ts[axis].resize(numSamples[axis]);
+                for (int i = 0; i < numSamples[axis]; ++i)
+                {
+                    const float gridPosition = (origin[axis] + i * cellSize) / spacing;
+                    const float gridCorner = std::floor(gridPosition);
+                    cellIndices[axis][i] = static_cast<int>(gridCorner);
+                    ts[axis][i] = gridPosition - gridCorner;
+                }
+                gridMin[axis] = cellIndices[axis].front();
+                gridMax[axis] = cellIndices[axis].back() + 2;
+            }
+
+            const glm::ivec3 gridSize = gridMax - gridMin;
+            const size_t numGridPoints = static_cast<size_t>(gridSize.x) * gridSize.y * gridSize.z;
+            std::vector<float> gridXs(numGridPoints);
+            std::vector<float> gridYs(numGridPoints);
+            std::vector<float> gridZs(numGridPoints);
+            std::vector<float> gridValues(numGridPoints, 0.0f);
+            size_t gridIndex = 0;
+            for (int z = gridMin.z; z < gridMax.z; ++z)
+            {
+                for (int y = gridMin.y; y < gridMax.y; ++y)
+                {
+                    for (int x = gridMin.x; x < gridMax.x; ++x)
+                    {
+                        gridXs[gridIndex] = static_cast<float>(x) * spacing;
+                        gridYs[gridIndex] = static_cast<float>(y) * spacing;
+                        gridZs[gridIndex] = static_cast<float>(z) * spacing;
+                        ++gridIndex;
+                    }
+                }
+            }
+
+            const MarchingCubes::NoiseLayer noiseLayer = GetNoiseLayer(layer);
+            MarchingCubes::AddNoiseLayers(&noiseLayer, 1, gridXs.data(), gridYs.data(), gridZs.data(), gridValues.data(), numGridPoints);
+
+            // Each lattice row first interpolates the grid points of its grid row in the yz-plane,
+            // then along x, so the yz-plane is only interpolated once per grid point
+            const size_t gridStrideY = gridSize.x;
+            const size_t gridStrideZ = gridStrideY * gridSize.y;
+            std::vector<float> rowValues(gridSize.x);
+            size_t sampleIndex = 0;
+            for (int z = 0; z < numSamples.z; ++z)
+            {
+                for (int y = 0; y < numSamples.y; ++y)
+                {
+                    const float* gridRow = &gridValues[(cellIndices[1][y] - gridMin.y) * gridStrideY + (cellIndices[2][z] - gridMin.z) * gridStrideZ];
+                    for (int x = 0; x < gridSize.x; ++x)
+                    {
+                        rowValues[x] = InterpolateYZ(gridRow[x], gridRow[x + gridStrideZ], gridRow[x + gridStrideY], gridRow[x + gridStrideY + gridStrideZ], ts[1][y], ts[2][z]);
+                    }
+
+                    for (int x = 0; x < numSamples.x; ++x)
+                    {
+                        const int gridX = cellIndices[0][x] - gridMin.x;
+                        outputValues[sampleIndex] += rowValues[gridX] + (rowValues[gridX + 1] - rowValues[gridX]) * ts[0][x];
+                        ++sampleIndex;
+                    }
+                }
+            }
+        }
+    }
+
+    // Adds the height term to the part of the density already known at n points
+    static void AddHeightTerm(const float* ys, float* values, size_t n)
+    {
+        for (size_t i = 0; i < n; ++i)
+        {
+            values[i] = glm::clamp(-ys[i], 0.0f, 1.0f) * 5.0f + values[i];
+        }
+    }
+
+    void EvaluateBatch(const float* xs, const float* ys, const float* zs, float* out, size_t n)
+    {
+        EvaluateColumnBatch(xs, zs, out, n);
+        AddHeightTerm(ys, out, n);
+
+        // All 3D layers at once, a few points at a time in SIMD lanes. The sums are the same as
+        // with the generators, see AddNoiseLayers.
+        MarchingCubes::NoiseLayer layers[9];
+        const int numLayers = GetNoiseLayers(false, layers);
+        MarchingCubes::AddNoiseLayers(layers, numLayers, xs, ys, zs, out, n);
+    }
+
+    // Like EvaluateBatch over a lattice, with the sums of the 2D layers and the interpolated layers already known at each point
+    void EvaluateBatch(const float* xs, const float* ys, const float* zs, const float* latticePart, float* out, size_t n)
+    {
+        std::copy(latticePart, latticePart + n, out);
+        AddHeightTerm(ys, out, n);
+
+        MarchingCubes::NoiseLayer layers[9];
+        const int numLayers = GetNoiseLayers(true, layers);
+        MarchingCubes::AddNoiseLayers(layers, numLayers, xs, ys, zs, out, n);
+    }
+
+    // Like EvaluateBatch, but the points deep in the air or the rock stop after the layers with
+    // the largest amplitudes, and only get a value of the right sign, see AddNoiseLayersBounded.
+    // Given a range of isovalues, the values are on the right side of all of them.
+    void EvaluateSignBatch(const float* xs, const float* ys, const float* zs, float* out, unsigned char* outputIsSignOnly, size_t n, float minIsovalue = 0.0f, float maxIsovalue = 0.0f)
+    {
+        EvaluateColumnBatch(xs, zs, out, n);
+        AddHeightTerm(ys, out, n);
+
+        MarchingCubes::NoiseLayer layers[9];
+        const int numLayers = GetNoiseLayers(false, layers);
+        MarchingCubes::AddNoiseLayersBounded(layers, numLayers, xs, ys, zs, out, outputIsSignOnly, n, minIsovalue, maxIsovalue);
+    }
+
+    // Like EvaluateSignBatch over a lattice, with the sums of the 2D layers and the interpolated layers already known at each point
+    void EvaluateSignBatch(const float* xs, const float* ys, const float* zs, const float* latticePart, float* out, unsigned char* outputIsSignOnly, size_t n, float minIsovalue = 0.0f, float maxIsovalue = 0.0f)
+    {
+        std::copy(latticePart, latticePart + n, out);
+        AddHeightTerm(ys, out, n);
+
+        MarchingCubes::NoiseLayer layers[9];
+        const int numLayers = GetNoiseLayers(true, layers);
+        MarchingCubes::AddNoiseLayersBounded(layers, numLayers, xs, ys, zs, out, outputIsSignOnly, n, minIsovalue, maxIsovalue);
+    }
 };
@@ -0,0 +1,97 @@
+#pragma once
+
+#include "Engine/Graphics/TerrainVertex.hpp"
+
+#include <glm/glm.hpp>
+
+#include <cstddef>
+#include <vector>
+
+namespace MarchingCubes
+{
+    /**
+     * Vertex sink quantizing the vertices straight into a vector of compact terrain vertices,
+     * see VertexSink.hpp
+     */
+    class TerrainVertexSink
+    {
+    public:
+        /**
+         * @brief Constructor
+         * @param[out] outputVertices Vector where the vertices will be placed
+         * @param[in] origin Origin of the quantized positions
+         * @param[in] positionStep Quantization step of the positions
+         */
+        TerrainVertexSink(std::vector<TerrainVertex>& outputVertices, const glm::vec3& origin, float positionStep)
+            : m_vertices(outputVertices)
+            , m_origin(origin)
+            , m_positionStep(positionStep)
+        {
+        }
+
+        /**
+         * @brief Gets the number of vertices written so far
+         * @return Number of vertices
+         */
+        size_t GetVertexCount() const
+        {
+            return m_vertices.size();
+        }
+
+        /**
+         * @brief Resizes the output to a number of vertices. New vertices have a +z normal.
+         * @param[in] numVertices Number of vertices
+         */
+        void Resize(size_t numVertices)
+        {
+            TerrainVertex vertex = {};
+            vertex.SetNormal(glm::vec3(0.0f, 0.0f, 1.0f));
+            m_vertices.resize(numVertices, vertex);
+        }
+
+        /**
+         * @brief Are the vertex normals needed?
+         * @return True if needed
+         */
+        bool HasNormals() const
+        {
+            return true;
+        }
+
+        /**
+         * @brief Sets the position of a vertex
+         * @param[in] index Vertex index
+         * @param[in] position Position
+         */
+        void SetPosition(size_t index, const glm::vec3& position)
+        {
+            m_vertices[index].SetPosition(position, m_origin, m_positionStep);
+        }
+
+        /**
+         * @brief Sets the normal of a vertex
+         * @param[in] index Vertex index
+         * @param[in] normal Unit normal
+         */
+        void SetNormal(size_t index, const glm::vec3& normal)
+        {
+            m_vertices[index].SetNormal(normal);
+        }
+
+    private:
+        /**
+         * Terrain vertices
+         */
+        std::vector<TerrainVertex>& m_vertices;
+
+        /**
+         * Origin of the quantized positions
+         */
+        glm::vec3 m_origin;
+
+        /**
+         * Quantization step of the positions
+         */
+        float m_positionStep;
+    };
+}
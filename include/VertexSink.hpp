@@ -0,0 +1,173 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <cstddef>
+#include <vector>
+
+namespace MarchingCubes
+{
+    /**
+     * Vertex sink writing the positions and normals into separate vectors.
+     *
+     * A vertex sink is where the meshers write the vertices, so they can go straight into
+     * the caller's own buffer without an intermediate copy. Sinks provide:
+     * size_t GetVertexCount() const, void Resize(size_t numVertices), bool HasNormals() const,
+     * void SetPosition(size_t index, const glm::vec3& position) and
+     * void SetNormal(size_t index, const glm::vec3& normal).
+     */
+    class PositionNormalSink
+    {
+    public:
+        /**
+         * @brief Constructor
+         * @param[out] outputPositions Vector where the vertex positions will be placed
+         * @param[out] outputNormals Vector where the vertex normals will be placed. Can be null if normals are not needed.
+         */
+        PositionNormalSink(std::vector<glm::vec3>& outputPositions, std::vector<glm::vec3>* outputNormals)
+            : m_positions(outputPositions)
+            , m_normals(outputNormals)
+        {
+        }
+
+        /**
+         * @brief Gets the number of vertices written so far
+         * @return Number of vertices
+         */
+        size_t GetVertexCount() const
+        {
+            return m_positions.size();
+        }
+
+        /**
+         * @brief Resizes the output to a number of vertices
+         * @param[in] numVertices Number of vertices
+         */
+        void Resize(size_t numVertices)
+        {
+            m_positions.resize(numVertices);
+            if (m_normals != nullptr)
+            {
+                m_normals->resize(numVertices);
+            }
+        }
+
+        /**
+         * @brief Are the vertex normals needed?
+         * @return True if needed
+         */
+        bool HasNormals() const
+        {
+            return m_normals != nullptr;
+        }
+
+        /**
+         * @brief Sets the position of a vertex
+         * @param[in] index Vertex index
+         * @param[in] position Position
+         */
+        void SetPosition(size_t index, const glm::vec3& position)
+        {
+            m_positions[index] = position;
+        }
+
+        /**
+         * @brief Sets the normal of a vertex
+         * @param[in] index Vertex index
+         * @param[in] normal Normal
+         */
+        void SetNormal(size_t index, const glm::vec3& normal)
+        {
+            (*m_normals)[index] = normal;
+        }
+
+    private:
+        /**
+         * Vertex positions
+         */
+        std::vector<glm::vec3>& m_positions;
+
+        /**
+         * Vertex normals, or null
+         */
+        std::vector<glm::vec3>* m_normals;
+    };
+
+    /**
+     * Vertex sink writing into a vector of user vertices, which have position and normal members.
+     * New vertices start as a copy of a template vertex, for the attributes the meshers do not set.
+     */
+    template <typename VertexType>
+    class VertexVectorSink
+    {
+    public:
+        /**
+         * @brief Constructor
+         * @param[out] outputVertices Vector where the vertices will be placed
+         * @param[in] vertexTemplate Initial value of the new vertices
+         */
+        VertexVectorSink(std::vector<VertexType>& outputVertices, const VertexType& vertexTemplate)
+            : m_vertices(outputVertices)
+            , m_vertexTemplate(vertexTemplate)
+        {
+        }
+
+        /**
+         * @brief Gets the number of vertices written so far
+         * @return Number of vertices
+         */
+        size_t GetVertexCount() const
+        {
+            return m_vertices.size();
+        }
+
+        /**
+         * @brief Resizes the output to a number of vertices
+         * @param[in] numVertices Number of vertices
+         */
+        void Resize(size_t numVertices)
+        {
+            m_vertices.resize(numVertices, m_vertexTemplate);
+        }
+
+        /**
+         * @brief Are the vertex normals needed?
+         * @return True if needed
+         */
+        bool HasNormals() const
+        {
+            return true;
+        }
+
+        /**
+         * @brief Sets the position of a vertex
+         * @param[in] index Vertex index
+         * @param[in] position Position
+         */
+        void SetPosition(size_t index, const glm::vec3& position)
+        {
+            m_vertices[index].position = position;
+        }
+
+        /**
+         * @brief Sets the normal of a vertex
+         * @param[in] index Vertex index
+         * @param[in] normal Normal
+         */
+        void SetNormal(size_t index, const glm::vec3& normal)
+        {
+            m_vertices[index].normal = normal;
+        }
+
+    private:
+        /**
+         * User vertices
+         */
+        std::vector<VertexType>& m_vertices;
+
+        /**
+         * Initial value of the new vertices
+         */
+        VertexType m_vertexTemplate;
+    };
+}
@@ -0,0 +1,209 @@
+#include "CellClassifier.hpp"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define MARCHING_CUBES_X86_SIMD 1
+#include <immintrin.h>
+#endif
+
+namespace MarchingCubes
+{
+    namespace
+    {
+        /**
+         * Signature shared by all classifier kernels
+         */
+        typedef int (*ClassifyCellRowFunc)(const float* const rows[4], int numCells, unsigned char* outputCases, int* outputActiveCells);
+
+        /**
+         * @brief Classifies the cells in [begin, numCells) one at a time
+         * @param[in] rows Lattice rows containing the cell corner values
+         * @param[in] begin Index of the first cell to classify
+         * @param[in] numCells Number of cells in the row
+         * @param[out] outputCases Array where the case indices will be placed
+         * @param[out] outputActiveCells Array where the indices of the active cells will be placed
+         * @param[in] numActiveCells Number of active cells found so far
+         * @return Number of active cells
+         */
+        int ClassifyCellRowScalarTail(const float* const rows[4], int begin, int numCells, unsigned char* outputCases, int* outputActiveCells, int numActiveCells)
+        {
+            for (int x = begin; x < numCells; ++x)
+            {
+                int caseIndex = 0;
+                for (int i = 0; i < 4; ++i)
+                {
+                    caseIndex |= (rows[i][x] > 0.0f ? 1 : 0) << (i * 2);
+                    caseIndex |= (rows[i][x + 1] > 0.0f ? 1 : 0) << (i * 2 + 1);
+                }
+
+                outputCases[x] = static_cast<unsigned char>(caseIndex);
+                if ((caseIndex != 0) && (caseIndex != 255))
+                {
+                    outputActiveCells[numActiveCells++] = x;
+                }
+            }
+            return numActiveCells;
+        }
+
+        /**
+         * @brief Scalar classifier kernel
+         */
+        int ClassifyCellRowScalar(const float* const rows[4], int numCells, unsigned char* outputCases, int* outputActiveCells)
+        {
+            return ClassifyCellRowScalarTail(rows, 0, numCells, outputCases, outputActiveCells, 0);
+        }
+
+#ifdef MARCHING_CUBES_X86_SIMD
+        /**
+         * @brief SSE2 classifier kernel, 16 cells per iteration
+         */
+        int ClassifyCellRowSSE2(const float* const rows[4], int numCells, unsigned char* outputCases, int* outputActiveCells)
+        {
+            const __m128 zero = _mm_setzero_ps();
+            const __m128i allInside = _mm_set1_epi8(static_cast<char>(0xFF));
+
+            int numActiveCells = 0;
+            int x = 0;
+            for (; x + 16 <= numCells; x += 16)
+            {
+                // Case indices for 4 cells at a time, as 32-bit lanes
+                __m128i cases[4];
+                for (int block = 0; block < 4; ++block)
+                {
+                    __m128i caseIndex = _mm_setzero_si128();
+                    for (int i = 0; i < 4; ++i)
+                    {
+                        const float* row = rows[i] + x + block * 4;
+                        __m128i lower = _mm_castps_si128(_mm_cmpgt_ps(_mm_loadu_ps(row), zero));
+                        __m128i upper = _mm_castps_si128(_mm_cmpgt_ps(_mm_loadu_ps(row + 1), zero));
+                        caseIndex = _mm_or_si128(caseIndex, _mm_and_si128(lower, _mm_set1_epi32(1 << (i * 2))));
+                        caseIndex = _mm_or_si128(caseIndex, _mm_and_si128(upper, _mm_set1_epi32(1 << (i * 2 + 1))));
+                    }
+                    cases[block] = caseIndex;
+                }
+
+                __m128i packed = _mm_packus_epi16(_mm_packs_epi32(cases[0], cases[1]), _mm_packs_epi32(cases[2], cases[3]));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(outputCases + x), packed);
+
+                // Empty (0) and full (255) cells produce no triangles
+                __m128i trivial = _mm_or_si128(_mm_cmpeq_epi8(packed, _mm_setzero_si128()), _mm_cmpeq_epi8(packed, allInside));
+                unsigned int activeMask = ~static_cast<unsigned int>(_mm_movemask_epi8(trivial)) & 0xFFFF;
+                while (activeMask != 0)
+                {
+                    outputActiveCells[numActiveCells++] = x + __builtin_ctz(activeMask);
+                    activeMask &= activeMask - 1;
+                }
+            }
+
+            return ClassifyCellRowScalarTail(rows, x, numCells, outputCases, outputActiveCells, numActiveCells);
+        }
+
+        /**
+         * @brief AVX2 classifier kernel, 32 cells per iteration
+         */
+        __attribute__((target("avx2")))
+        int ClassifyCellRowAVX2(const float* const rows[4], int numCells, unsigned char* outputCases, int* outputActiveCells)
+        {
+            const __m256 zero = _mm256_setzero_ps();
+            const __m256i allInside = _mm256_set1_epi8(static_cast<char>(0xFF));
+
+            int numActiveCells = 0;
+            int x = 0;
+            for (; x + 32 <= numCells; x += 32)
+            {
+                // Case indices for 8 cells at a time, as 32-bit lanes
+                __m256i cases[4];
+                for (int block = 0; block < 4; ++block)
+                {
+                    __m256i caseIndex = _mm256_setzero_si256();
+                    for (int i = 0; i < 4; ++i)
+                    {
+                        const float* row = rows[i] + x + block * 8;
+                        __m256i lower = _mm256_castps_si256(_mm256_cmp_ps(_mm256_loadu_ps(row), zero, _CMP_GT_OQ));
+                        __m256i upper = _mm256_castps_si256(_mm256_cmp_ps(_mm256_loadu_ps(row + 1), zero, _CMP_GT_OQ));
+                        caseIndex = _mm256_or_si256(caseIndex, _mm256_and_si256(lower, _mm256_set1_epi32(1 << (i * 2))));
+                        caseIndex = _mm256_or_si256(caseIndex, _mm256_and_si256(upper, _mm256_set1_epi32(1 << (i * 2 + 1))));
+                    }
+                    cases[block] = caseIndex;
+                }
+
+                // The packs work within 128-bit lanes, so restore the cell order afterwards
+                __m256i packed = _mm256_packus_epi16(_mm256_packs_epi32(cases[0], cases[1]), _mm256_packs_epi32(cases[2], cases[3]));
+                packed = _mm256_permutevar8x32_epi32(packed, _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7));
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(outputCases + x), packed);
+
+                // Empty (0) and full (255) cells produce no triangles
+                __m256i trivial = _mm256_or_si256(_mm256_cmpeq_epi8(packed, _mm256_setzero_si256()), _mm256_cmpeq_epi8(packed, allInside));
+                unsigned int activeMask = ~static_cast<unsigned int>(_mm256_movemask_epi8(trivial));
+                while (activeMask != 0)
+                {
+                    outputActiveCells[numActiveCells++] = x + __builtin_ctz(activeMask);
+                    activeMask &= activeMask - 1;
+                }
+            }
+
+            return ClassifyCellRowScalarTail(rows, x, numCells, outputCases, outputActiveCells, numActiveCells);
+        }
+#endif
+
+        /**
+         * Classifier kernel and its name, selected once based on the CPU features
+         */
+        struct CellClassifier
+        {
+            ClassifyCellRowFunc func;
+            const char* name;
+
+            CellClassifier()
+                : func(&ClassifyCellRowScalar)
+                , name("Scalar")
+            {
+#ifdef MARCHING_CUBES_X86_SIMD
+                __builtin_cpu_init();
+                if (__builtin_cpu_supports("avx2"))
+                {
+                    func = &ClassifyCellRowAVX2;
+                    name = "AVX2";
+                }
+                else if (__builtin_cpu_supports("sse2"))
+                {
+                    func = &ClassifyCellRowSSE2;
+                    name = "SSE2";
+                }
+#endif
+            }
+        };
+
+        /**
+         * @brief Gets the classifier selected for this CPU
+         * @return Classifier
+         */
+        const CellClassifier& GetCellClassifier()
+        {
+            static CellClassifier classifier;
+            return classifier;
+        }
+    }
+
+    /**
+     * @brief Computes the marching cubes case index of a row of consecutive cells
+     * from the already sampled lattice, and lists the cells that the surface passes through.
+     * @param[in] rows Lattice rows containing the cell corner values
+     * @param[in] numCells Number of cells in the row
+     * @param[out] outputCases Array where the numCells case indices will be placed
+     * @param[out] outputActiveCells Array where the indices of the cells with a case other than 0 or 255 will be placed
+     * @return Number of active cells
+     */
+    int ClassifyCellRow(const float* const rows[4], int numCells, unsigned char* outputCases, int* outputActiveCells)
+    {
+        return GetCellClassifier().func(rows, numCells, outputCases, outputActiveCells);
+    }
+
+    /**
+     * @brief Gets the name of the instruction set used by ClassifyCellRow on this CPU
+     * @return Instruction set name
+     */
+    const char* GetCellClassifierName()
+    {
+        return GetCellClassifier().name;
+    }
+}
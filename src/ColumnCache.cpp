@@ -0,0 +1,98 @@
+#include "ColumnCache.hpp"
+
+namespace MarchingCubes
+{
+    /**
+     * @brief Constructor
+     * @param[in] maxNumGrids Number of grids kept before evicting the least recently used one
+     */
+    ColumnCache::ColumnCache(size_t maxNumGrids)
+        : m_grids()
+        , m_maxNumGrids(maxNumGrids)
+        , m_mutex()
+    {
+    }
+
+    /**
+     * @brief Gets the values at the columns origin + (x, z) * cellSize, evaluating them if the grid is not cached
+     * @param[in] origin Position of the first column
+     * @param[in] cellSize Distance between two columns
+     * @param[in] numColumns Number of columns along x and z
+     * @param[in] evaluateColumns Function evaluating the columns of a grid that is not cached
+     * @param[out] outputValues Vector where the numColumns.x * numColumns.y values will be placed, x varying fastest
+     */
+    void ColumnCache::GetValues(const glm::vec2& origin, float cellSize, const glm::ivec2& numColumns, const EvaluateColumnsFunc& evaluateColumns, std::vector<float>& outputValues)
+    {
+        m_mutex.lock();
+        std::shared_ptr<const std::vector<float>> values = FindGrid(origin, cellSize, numColumns);
+        m_mutex.unlock();
+
+        if (!values)
+        {
+            // Evaluated without holding the lock. Threads missing the same grid at once both
+            // evaluate it, which gives the same values.
+            const size_t numGridColumns = static_cast<size_t>(numColumns.x) * numColumns.y;
+            std::vector<float> xs(numGridColumns);
+            std::vector<float> zs(numGridColumns);
+            size_t columnIndex = 0;
+            for (int z = 0; z < numColumns.y; ++z)
+            {
+                for (int x = 0; x < numColumns.x; ++x)
+                {
+                    xs[columnIndex] = origin.x + x * cellSize;
+                    zs[columnIndex] = origin.y + z * cellSize;
+                    ++columnIndex;
+                }
+            }
+
+            std::shared_ptr<std::vector<float>> newValues = std::make_shared<std::vector<float>>(numGridColumns);
+            evaluateColumns(xs.data(), zs.data(), newValues->data(), numGridColumns);
+            values = newValues;
+
+            m_mutex.lock();
+            if (!FindGrid(origin, cellSize, numColumns))
+            {
+                Grid grid;
+                grid.origin = origin;
+                grid.cellSize = cellSize;
+                grid.numColumns = numColumns;
+                grid.values = values;
+                m_grids.push_front(grid);
+                if (m_grids.size() > m_maxNumGrids)
+                {
+                    m_grids.pop_back();
+                }
+            }
+            m_mutex.unlock();
+        }
+
+        outputValues.assign(values->begin(), values->end());
+    }
+
+    /**
+     * @brief Evicts all grids
+     */
+    void ColumnCache::Clear()
+    {
+        m_mutex.lock();
+        m_grids.clear();
+        m_mutex.unlock();
+    }
+
+    /**
+     * @brief Finds a grid and moves it to the front of the list. The mutex must be locked.
+     * @return Values of the grid, or null if it is not cached
+     */
+    std::shared_ptr<const std::vector<float>> ColumnCache::FindGrid(const glm::vec2& origin, float cellSize, const glm::ivec2& numColumns)
+    {
+        for (std::list<Grid>::iterator it = m_grids.begin(); it != m_grids.end(); ++it)
+        {
+            if ((it->origin == origin) && (it->cellSize == cellSize) && (it->numColumns == numColumns))
+            {
+                m_grids.splice(m_grids.begin(), m_grids, it);
+                return m_grids.front().values;
+            }
+        }
+        return nullptr;
+    }
+}
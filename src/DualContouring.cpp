@@ -0,0 +1,228 @@
+#include "DualContouring.hpp"
+
+#include "SurfaceNets.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace MarchingCubes
+{
+    namespace
+    {
+        /**
+         * @brief Finds the point minimizing the squared distances to a set of planes, relative to their mass point.
+         *
+         * The symmetric system is diagonalized with Jacobi rotations, and the directions with small
+         * eigenvalues are dropped, so the point stays at the mass point along the directions the planes
+         * do not constrain (along a flat surface, or along a sharp edge).
+         * @param[in] ata Sum of n * n^T over the plane normals n
+         * @param[in] atb Sum of n * (n . (p - massPoint)) over the plane normals n and points p
+         * @return Offset of the point from the mass point
+         */
+        glm::vec3 SolveQef(const float ata[3][3], const glm::vec3& atb)
+        {
+            float a[3][3];
+            float v[3][3] = { { 1.0f, 0.0f, 0.0f }, { 0.0f, 1.0f, 0.0f }, { 0.0f, 0.0f, 1.0f } };
+            std::copy(&ata[0][0], &ata[0][0] + 9, &a[0][0]);
+
+            for (int sweep = 0; sweep < 5; ++sweep)
+            {
+                for (int p = 0; p < 2; ++p)
+                {
+                    for (int q = p + 1; q < 3; ++q)
+                    {
+                        if (std::abs(a[p][q]) < 1e-12f)
+                        {
+                            continue;
+                        }
+
+                        // Rotation zeroing a[p][q]
+                        const float theta = (a[q][q] - a[p][p]) / (2.0f * a[p][q]);
+                        const float t = ((theta >= 0.0f) ? 1.0f : -1.0f) / (std::abs(theta) + std::sqrt(theta * theta + 1.0f));
+                        const float c = 1.0f / std::sqrt(t * t + 1.0f);
+                        const float s = t * c;
+
+                        for (int k = 0; k < 3; ++k)
+                        {
+                            const float akp = a[k][p];
+                            const float akq = a[k][q];
+                            a[k][p] = c * akp - s * akq;
+                            a[k][q] = s * akp + c * akq;
+                        }
+                        for (int k = 0; k < 3; ++k)
+                        {
+                            const float apk = a[p][k];
+                            const float aqk = a[q][k];
+                            a[p][k] = c * apk - s * aqk;
+                            a[q][k] = s * apk + c * aqk;
+                        }
+                        for (int k = 0; k < 3; ++k)
+                        {
+                            const float vkp = v[k][p];
+                            const float vkq = v[k][q];
+                            v[k][p] = c * vkp - s * vkq;
+                            v[k][q] = s * vkp + c * vkq;
+                        }
+                    }
+                }
+            }
+
+            // Pseudo-inverse, keeping the eigenvalues above a tenth of the largest one
+            const float maxEigenvalue = std::max(a[0][0], std::max(a[1][1], a[2][2]));
+            glm::vec3 offset(0.0f);
+            for (int i = 0; i < 3; ++i)
+            {
+                if (a[i][i] > 0.1f * maxEigenvalue)
+                {
+                    const glm::vec3 eigenvector(v[0][i], v[1][i], v[2][i]);
+                    offset += eigenvector * (glm::dot(eigenvector, atb) / a[i][i]);
+                }
+            }
+            return offset;
+        }
+    }
+
+    /**
+     * @brief Finds the intersections of the surface with the lattice edges
+     * @param[in] lattice Sampled lattice of numCells + 1 cells, starting one cell before the bounds, x varying fastest
+     * @param[in] numCells Number of cells of the bounds along each axis
+     * @param[out] outputEdgeIntersections Index in outputIntersections of the intersection on every edge, or -1,
+     *                                     as 3 edges (x, y, z) per lattice point
+     * @param[out] outputIntersections Vector where the intersections will be placed
+     */
+    void DualContouring::GetEdgeIntersections(const std::vector<float>& lattice, const glm::ivec3& numCells, std::vector<int>& outputEdgeIntersections, std::vector<EdgeIntersection>& outputIntersections)
+    {
+        const glm::ivec3 numLatticeCells = numCells + 1;
+        const size_t strideY = numLatticeCells.x + 1;
+        const size_t strideZ = strideY * (numLatticeCells.y + 1);
+        const size_t axisStrides[3] = { 1, strideY, strideZ };
+
+        outputEdgeIntersections.assign(lattice.size() * 3, -1);
+        for (int z = 0; z <= numLatticeCells.z; ++z)
+        {
+            for (int y = 0; y <= numLatticeCells.y; ++y)
+            {
+                for (int x = 0; x <= numLatticeCells.x; ++x)
+                {
+                    const glm::ivec3 point(x, y, z);
+                    const size_t pointIndex = x + y * strideY + z * strideZ;
+                    const float value0 = lattice[pointIndex];
+                    for (int axis = 0; axis < 3; ++axis)
+                    {
+                        if (point[axis] == numLatticeCells[axis])
+                        {
+                            continue;
+                        }
+
+                        const float value1 = lattice[pointIndex + axisStrides[axis]];
+                        if ((value0 > 0.0f) == (value1 > 0.0f))
+                        {
+                            continue;
+                        }
+
+                        // Linear interpolation to smoothen the resulting mesh
+                        EdgeIntersection intersection;
+                        intersection.point = point;
+                        intersection.axis = axis;
+                        intersection.t = (0.0f - value0) / (value1 - value0);
+
+                        outputEdgeIntersections[pointIndex * 3 + axis] = static_cast<int>(outputIntersections.size());
+                        outputIntersections.push_back(intersection);
+                    }
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Places the cell vertices and connects them
+     * @param[in] lattice Sampled lattice of numCells + 1 cells, starting one cell before the bounds, x varying fastest
+     * @param[in] origin Position of the first grid corner of the lattice
+     * @param[in] cellSize Cell size
+     * @param[in] numCells Number of cells of the bounds along each axis
+     * @param[in] edgeIntersections Index of the intersection on every edge, from GetEdgeIntersections
+     * @param[in] intersections Intersections, from GetEdgeIntersections
+     * @param[in] normals Unit normals of the function at the intersections
+     * @param[out] outputVertices Vector where the vertex positions will be placed
+     * @param[out] outputIndices Vector where the triangle vertex indices will be placed
+     */
+    void DualContouring::Polygonize(const std::vector<float>& lattice, const glm::vec3& origin, float cellSize, const glm::ivec3& numCells, const std::vector<int>& edgeIntersections, const std::vector<EdgeIntersection>& intersections, const std::vector<glm::vec3>& normals, std::vector<glm::vec3>& outputVertices, std::vector<uint32_t>& outputIndices)
+    {
+        const glm::ivec3 numLatticeCells = numCells + 1;
+        const size_t strideY = numLatticeCells.x + 1;
+        const size_t strideZ = strideY * (numLatticeCells.y + 1);
+
+        const size_t firstVertex = outputVertices.size();
+
+        std::vector<uint32_t> cellVertices(static_cast<size_t>(numLatticeCells.x) * numLatticeCells.y * numLatticeCells.z);
+        for (int z = 0; z < numLatticeCells.z; ++z)
+        {
+            for (int y = 0; y < numLatticeCells.y; ++y)
+            {
+                for (int x = 0; x < numLatticeCells.x; ++x)
+                {
+                    const glm::ivec3 cell(x, y, z);
+
+                    // The 4 edges of each axis, starting at the corners of the face at the start of the axis.
+                    // Positions are relative to the cell, so a cell shared by two chunks gets the same vertex.
+                    int cellIntersections[12];
+                    glm::vec3 cellPositions[12];
+                    int numIntersections = 0;
+                    glm::vec3 massPoint(0.0f);
+                    for (int axis = 0; axis < 3; ++axis)
+                    {
+                        for (int i = 0; i < 4; ++i)
+                        {
+                            glm::ivec3 corner = cell;
+                            corner[(axis + 1) % 3] += i & 1;
+                            corner[(axis + 2) % 3] += i >> 1;
+
+                            const int intersection = edgeIntersections[(corner.x + corner.y * strideY + corner.z * strideZ) * 3 + axis];
+                            if (intersection != -1)
+                            {
+                                glm::vec3 position(corner - cell);
+                                position[axis] += intersections[intersection].t;
+
+                                cellIntersections[numIntersections] = intersection;
+                                cellPositions[numIntersections] = position;
+                                massPoint += position;
+                                ++numIntersections;
+                            }
+                        }
+                    }
+
+                    if (numIntersections == 0)
+                    {
+                        continue;
+                    }
+                    massPoint /= static_cast<float>(numIntersections);
+
+                    // Planes through the intersections, relative to the mass point
+                    float ata[3][3] = {};
+                    glm::vec3 atb(0.0f);
+                    for (int i = 0; i < numIntersections; ++i)
+                    {
+                        const glm::vec3& normal = normals[cellIntersections[i]];
+                        const float distance = glm::dot(normal, cellPositions[i] - massPoint);
+                        for (int row = 0; row < 3; ++row)
+                        {
+                            for (int column = 0; column < 3; ++column)
+                            {
+                                ata[row][column] += normal[row] * normal[column];
+                            }
+                        }
+                        atb += normal * distance;
+                    }
+
+                    // Vertices outside their cell would fold the quads over
+                    const glm::vec3 vertex = glm::clamp(massPoint + SolveQef(ata, atb), glm::vec3(0.0f), glm::vec3(1.0f));
+
+                    cellVertices[x + (y + static_cast<size_t>(z) * numLatticeCells.y) * numLatticeCells.x] = static_cast<uint32_t>(outputVertices.size() - firstVertex);
+                    outputVertices.push_back(origin + glm::vec3(cell) * cellSize + vertex * cellSize);
+                }
+            }
+        }
+
+        SurfaceNets::AddQuads(lattice, numCells, cellVertices, outputVertices, firstVertex, outputIndices);
+    }
+}
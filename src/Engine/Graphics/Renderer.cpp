@@ -10,6 +10,7 @@ Renderer::Renderer()
     : m_vbo(0)
     , m_vao(0)
     , m_ebo(0)
+    , m_terrainVao(0)
 {
 }
 
@@ -62,6 +63,22 @@ void Renderer::Initialize(const int& maxNumVertices, const int& maxNumVertexIndi
 
 	glEnableVertexAttribArray(3);
 	glVertexAttribPointer(3, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), reinterpret_cast<void*>(offsetof(Vertex, normal)));
+
+    // Same buffers, read as terrain vertices. The attributes are left unnormalized
+    // and decoded by the terrain vertex shader.
+    if (m_terrainVao == 0)
+    {
+        glGenVertexArrays(1, &m_terrainVao);
+    }
+    glBindVertexArray(m_terrainVao);
+    glBindBuffer(GL_ARRAY_BUFFER, m_vbo);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_ebo);
+
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 3, GL_UNSIGNED_SHORT, GL_FALSE, sizeof(TerrainVertex), reinterpret_cast<void*>(offsetof(TerrainVertex, position)));
+
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(1, 2, GL_SHORT, GL_FALSE, sizeof(TerrainVertex), reinterpret_cast<void*>(offsetof(TerrainVertex, normal)));
 }
 
 /**
@@ -77,6 +94,9 @@ void Renderer::Cleanup()
 
     glDeleteVertexArrays(1, &m_vao);
     m_vao = 0;
+
+    glDeleteVertexArrays(1, &m_terrainVao);
+    m_terrainVao = 0;
 }
 
 /**
@@ -105,6 +125,40 @@ void Renderer::DrawTriangles(const std::vector<Vertex>& vertices)
     glDrawArrays(GL_TRIANGLES, 0, vertices.size());
 }
 
+/**
+ * @brief Draw the provided indexed vertices as triangles
+ * @param[in] vertices Vertex list
+ * @param[in] indices Vertex index list, 3 per triangle
+ */
+void Renderer::DrawTriangles(const std::vector<Vertex>& vertices, const std::vector<GLuint>& indices)
+{
+    glBindBuffer(GL_ARRAY_BUFFER, m_vbo);
+    glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(Vertex) * vertices.size(), vertices.data());
+
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_ebo);
+    glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, 0, sizeof(GLuint) * indices.size(), indices.data());
+
+    glBindVertexArray(m_vao);
+    glDrawElements(GL_TRIANGLES, indices.size(), GL_UNSIGNED_INT, nullptr);
+}
+
+/**
+ * @brief Draw the provided indexed terrain vertices as triangles
+ * @param[in] vertices Terrain vertex list
+ * @param[in] indices Vertex index list, 3 per triangle
+ */
+void Renderer::DrawTriangles(const std::vector<TerrainVertex>& vertices, const std::vector<GLuint>& indices)
+{
+    glBindBuffer(GL_ARRAY_BUFFER, m_vbo);
+    glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(TerrainVertex) * vertices.size(), vertices.data());
+
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_ebo);
+    glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, 0, sizeof(GLuint) * indices.size(), indices.data());
+
+    glBindVertexArray(m_terrainVao);
+    glDrawElements(GL_TRIANGLES, indices.size(), GL_UNSIGNED_INT, nullptr);
+}
+
 /**
  * @brief Draw the provided vertices as a triangle fan
  * @param[in] vertices Vertex list
@@ -0,0 +1,352 @@
+#include "FlyingEdges.hpp"
+
+#include "CellClassifier.hpp"
+
+#include <algorithm>
+
+namespace MarchingCubes
+{
+    namespace
+    {
+        /**
+         * Per-row data of a row of lattice points
+         */
+        struct EdgeRow
+        {
+            /**
+             * Number of intersected x-, y-, and z-edges owned by this row.
+             * The y- and z-edges start at the points of this row.
+             */
+            int numX;
+            int numY;
+            int numZ;
+
+            /**
+             * Index of the first vertex of each edge direction
+             */
+            size_t xOffset;
+            size_t yOffset;
+            size_t zOffset;
+        };
+
+        /**
+         * Per-row data of a row of cells
+         */
+        struct CellRow
+        {
+            /**
+             * Index of the first active cell of the row in the active cells of its slab, and number of active cells
+             */
+            size_t firstActiveCell;
+            int numActiveCells;
+
+            /**
+             * Number of triangles produced by the row
+             */
+            size_t numTriangles;
+
+            /**
+             * Index of the first triangle of the row
+             */
+            size_t triangleOffset;
+        };
+
+        /**
+         * Cell of a cell row that the surface passes through
+         */
+        struct ActiveCell
+        {
+            /**
+             * X-index of the cell
+             */
+            int x;
+
+            /**
+             * Case index of the cell
+             */
+            unsigned char caseIndex;
+        };
+
+        /**
+         * @brief Gets the position where the surface intersects an edge
+         * @param[in] value0 Value at the start of the edge
+         * @param[in] value1 Value at the end of the edge
+         * @param[in] start Lattice position of the start of the edge
+         * @param[in] axis Axis of the edge
+         * @param[in] origin Position of the first grid corner
+         * @param[in] cellSize Cell size
+         * @return Intersection position
+         */
+        glm::vec3 GetEdgeIntersection(float value0, float value1, glm::vec3 start, int axis, const glm::vec3& origin, float cellSize)
+        {
+            // Linear interpolation to smoothen the resulting mesh
+            float t = (0.0f - value0) / (value1 - value0);
+            start[axis] += t;
+            return origin + start * cellSize;
+        }
+    }
+
+    /**
+     * @brief Extracts the isosurface from an already sampled lattice
+     * @param[in] lattice Sampled lattice, x varying fastest
+     * @param[in] origin Position of the first grid corner
+     * @param[in] cellSize Cell size
+     * @param[in] numCells Number of cells along each axis
+     * @param[in] numThreads Number of threads to use
+     * @param[out] outputVertices Vector where the vertex positions will be placed
+     * @param[out] outputIndices Vector where the triangle vertex indices will be placed
+     */
+    void FlyingEdges::Polygonize(const std::vector<float>& lattice, const glm::vec3& origin, float cellSize, const glm::ivec3& numCells, int numThreads, std::vector<glm::vec3>& outputVertices, std::vector<uint32_t>& outputIndices)
+    {
+        const MarchingCubes& tables = MarchingCubes::GetInstance();
+
+        const int nx = numCells.x;
+        const int ny = numCells.y;
+        const int nz = numCells.z;
+        const size_t strideY = nx + 1;
+        const size_t strideZ = strideY * (ny + 1);
+
+        std::vector<EdgeRow> edgeRows(static_cast<size_t>(ny + 1) * (nz + 1));
+        std::vector<CellRow> cellRows(static_cast<size_t>(ny) * nz);
+
+        // Edge rows and cell rows are both indexed by y + z * (number of rows along y)
+        auto GetRow = [&](int y, int z) { return &lattice[y * strideY + z * strideZ]; };
+        auto GetEdgeRow = [&](int y, int z) -> EdgeRow& { return edgeRows[y + z * (ny + 1)]; };
+
+        // Passes 1 and 3 split the cell rows into the same z-slabs, so the active cells
+        // listed for a slab in pass 1 are generated by the same thread in pass 3
+        const int numSlabs = std::max(1, std::min(numThreads, nz));
+        std::vector<std::vector<ActiveCell>> slabActiveCells(numSlabs);
+        auto GetSlabBegin = [&](int slab) { return static_cast<int>(static_cast<long long>(nz) * slab / numSlabs); };
+
+        // Pass 1: classify every cell row, list its active cells, and count their triangles and intersected
+        // edges. Every intersected edge touches a cell with a case other than 0 or 255.
+        ParallelFor(0, numSlabs, numSlabs, [&](int slabBegin, int slabEnd)
+        {
+            std::vector<unsigned char> cases(nx);
+            std::vector<int> activeCells(nx);
+            for (int slab = slabBegin; slab < slabEnd; ++slab)
+            {
+                std::vector<ActiveCell>& slabCells = slabActiveCells[slab];
+                for (int rowIndex = GetSlabBegin(slab) * ny; rowIndex < GetSlabBegin(slab + 1) * ny; ++rowIndex)
+                {
+                    const int y = rowIndex % ny;
+                    const int z = rowIndex / ny;
+
+                    // Same order as the corner bits of the case index
+                    const float* rows[4] = { GetRow(y, z), GetRow(y, z + 1), GetRow(y + 1, z), GetRow(y + 1, z + 1) };
+
+                    CellRow& cellRow = cellRows[rowIndex];
+                    cellRow.firstActiveCell = slabCells.size();
+                    cellRow.numActiveCells = ClassifyCellRow(rows, nx, cases.data(), activeCells.data());
+                    cellRow.numTriangles = 0;
+                    if (cellRow.numActiveCells == 0)
+                    {
+                        continue;
+                    }
+
+                    slabCells.resize(cellRow.firstActiveCell + cellRow.numActiveCells);
+                    ActiveCell* rowCells = &slabCells[cellRow.firstActiveCell];
+
+                    // Intersected x-edges [dy][dz] of the cells, and y-edges [dz] and z-edges [dy] at their minimum corner.
+                    // Corner bits of the case index: 1 = x, 2 = z, 4 = y
+                    int numX[2][2] = { { 0, 0 }, { 0, 0 } };
+                    int numY[2] = { 0, 0 };
+                    int numZ[2] = { 0, 0 };
+                    for (int i = 0; i < cellRow.numActiveCells; ++i)
+                    {
+                        const int caseIndex = cases[activeCells[i]];
+                        rowCells[i].x = activeCells[i];
+                        rowCells[i].caseIndex = static_cast<unsigned char>(caseIndex);
+
+                        cellRow.numTriangles += tables.regularCases.cases[caseIndex].numTriangles;
+                        for (int j = 0; j < 2; ++j)
+                        {
+                            numX[j][0] += ((caseIndex >> (j * 4)) ^ (caseIndex >> (j * 4 + 1))) & 1;
+                            numX[j][1] += ((caseIndex >> (j * 4 + 2)) ^ (caseIndex >> (j * 4 + 3))) & 1;
+                            numY[j] += ((caseIndex >> (j * 2)) ^ (caseIndex >> (j * 2 + 4))) & 1;
+                            numZ[j] += ((caseIndex >> (j * 4)) ^ (caseIndex >> (j * 4 + 2))) & 1;
+                        }
+                    }
+
+                    // The y- and z-edges at the end of the lattice rows only touch the last cell
+                    if (activeCells[cellRow.numActiveCells - 1] == nx - 1)
+                    {
+                        const int caseIndex = cases[nx - 1];
+                        for (int j = 0; j < 2; ++j)
+                        {
+                            numY[j] += ((caseIndex >> (j * 2 + 1)) ^ (caseIndex >> (j * 2 + 5))) & 1;
+                            numZ[j] += ((caseIndex >> (j * 4 + 1)) ^ (caseIndex >> (j * 4 + 3))) & 1;
+                        }
+                    }
+
+                    // Edges on the maximum faces of the lattice are owned by the rows there
+                    const bool ownsY1 = (y + 1 == ny);
+                    const bool ownsZ1 = (z + 1 == nz);
+                    GetEdgeRow(y, z).numX = numX[0][0];
+                    GetEdgeRow(y, z).numY = numY[0];
+                    GetEdgeRow(y, z).numZ = numZ[0];
+                    if (ownsZ1)
+                    {
+                        GetEdgeRow(y, z + 1).numX = numX[0][1];
+                        GetEdgeRow(y, z + 1).numY = numY[1];
+                    }
+                    if (ownsY1)
+                    {
+                        GetEdgeRow(y + 1, z).numX = numX[1][0];
+                        GetEdgeRow(y + 1, z).numZ = numZ[1];
+                    }
+                    if (ownsY1 && ownsZ1)
+                    {
+                        GetEdgeRow(y + 1, z + 1).numX = numX[1][1];
+                    }
+                }
+            }
+        });
+
+        // Pass 2: prefix sums, so every row knows where to write its output
+        size_t numVertices = outputVertices.size();
+        for (size_t i = 0; i < edgeRows.size(); ++i)
+        {
+            edgeRows[i].xOffset = numVertices;
+            numVertices += edgeRows[i].numX;
+            edgeRows[i].yOffset = numVertices;
+            numVertices += edgeRows[i].numY;
+            edgeRows[i].zOffset = numVertices;
+            numVertices += edgeRows[i].numZ;
+        }
+
+        size_t numTriangles = 0;
+        for (size_t i = 0; i < cellRows.size(); ++i)
+        {
+            cellRows[i].triangleOffset = numTriangles;
+            numTriangles += cellRows[i].numTriangles;
+        }
+
+        outputVertices.resize(numVertices);
+
+        const size_t firstIndex = outputIndices.size();
+        outputIndices.resize(firstIndex + numTriangles * 3);
+
+        // Pass 3: generate the vertices and triangles of the active cells of every cell row.
+        // The other cells have no intersected edge, so they add no vertex.
+        ParallelFor(0, numSlabs, numSlabs, [&](int slabBegin, int slabEnd)
+        {
+            for (int slab = slabBegin; slab < slabEnd; ++slab)
+            {
+                for (int rowIndex = GetSlabBegin(slab) * ny; rowIndex < GetSlabBegin(slab + 1) * ny; ++rowIndex)
+                {
+                    const CellRow& cellRow = cellRows[rowIndex];
+                    if (cellRow.numActiveCells == 0)
+                    {
+                        continue;
+                    }
+
+                    const int y = rowIndex % ny;
+                    const int z = rowIndex / ny;
+
+                    // Rows indexed by [dy][dz]
+                    const float* rows[2][2] = { { GetRow(y, z), GetRow(y, z + 1) }, { GetRow(y + 1, z), GetRow(y + 1, z + 1) } };
+                    const ActiveCell* activeCells = &slabActiveCells[slab][cellRow.firstActiveCell];
+
+                    // Edges on the maximum faces of the lattice are owned by the last cell rows
+                    const bool ownsY1 = (y + 1 == ny);
+                    const bool ownsZ1 = (z + 1 == nz);
+
+                    // Next vertex index of the x-edges [dy][dz], y-edges [dz], and z-edges [dy]
+                    size_t xIds[2][2];
+                    size_t yIds[2];
+                    size_t zIds[2];
+                    for (int i = 0; i < 2; ++i)
+                    {
+                        for (int j = 0; j < 2; ++j)
+                        {
+                            xIds[i][j] = GetEdgeRow(y + i, z + j).xOffset;
+                        }
+                        yIds[i] = GetEdgeRow(y, z + i).yOffset;
+                        zIds[i] = GetEdgeRow(y + i, z).zOffset;
+                    }
+
+                    uint32_t* indices = &outputIndices[firstIndex + cellRow.triangleOffset * 3];
+                    for (int k = 0; k < cellRow.numActiveCells; ++k)
+                    {
+                        const int x = activeCells[k].x;
+                        const int caseIndex = activeCells[k].caseIndex;
+
+                        // Intersected x-edges [dy][dz], and y-edges [dz] and z-edges [dy] at the start of the cell.
+                        // Corner bits of the case index: 1 = x, 2 = z, 4 = y
+                        bool crossesX[2][2];
+                        bool crossesY[2];
+                        bool crossesZ[2];
+                        for (int i = 0; i < 2; ++i)
+                        {
+                            for (int j = 0; j < 2; ++j)
+                            {
+                                crossesX[i][j] = (((caseIndex >> (i * 4 + j * 2)) ^ (caseIndex >> (i * 4 + j * 2 + 1))) & 1) != 0;
+                            }
+                            crossesY[i] = (((caseIndex >> (i * 2)) ^ (caseIndex >> (i * 2 + 4))) & 1) != 0;
+                            crossesZ[i] = (((caseIndex >> (i * 4)) ^ (caseIndex >> (i * 4 + 2))) & 1) != 0;
+                        }
+
+                        // Vertex index of every edge of the cell, by axis bit and lower corner
+                        uint32_t edgeIds[3][8];
+                        for (int i = 0; i < 2; ++i)
+                        {
+                            for (int j = 0; j < 2; ++j)
+                            {
+                                edgeIds[0][i * 4 + j * 2] = static_cast<uint32_t>(xIds[i][j]);
+                                edgeIds[1][i * 4 + j] = static_cast<uint32_t>(zIds[i] + (j & (crossesZ[i] ? 1 : 0)));
+                                edgeIds[2][i * 2 + j] = static_cast<uint32_t>(yIds[i] + (j & (crossesY[i] ? 1 : 0)));
+                            }
+                        }
+
+                        // Corner bits of the edges owned by the neighboring cells. The edges on the maximum
+                        // faces of the lattice are owned by the last cells.
+                        const int notOwnedBits = (ownsY1 ? 0 : 4) | (ownsZ1 ? 0 : 2) | ((x + 1 == nx) ? 0 : 1);
+
+                        // Every intersected edge of the cell has a vertex in the case, which is
+                        // written by the cell owning the edge
+                        const RegularCase& cellCase = tables.regularCases.cases[caseIndex];
+                        uint32_t vertexIds[12];
+                        for (int i = 0; i < cellCase.numVertices; ++i)
+                        {
+                            const unsigned short vertexData = cellCase.vertexData[i];
+                            const int axisBit = ((vertexData >> 4) ^ vertexData) & 0x0F;
+                            const int corner0 = (vertexData >> 4) & 0x0F & ~axisBit;
+                            const int corner1 = corner0 | axisBit;
+
+                            const uint32_t vertexId = edgeIds[axisBit >> 1][corner0];
+                            vertexIds[i] = vertexId;
+
+                            if ((corner0 & notOwnedBits) == 0)
+                            {
+                                const int dx = corner0 & 1;
+                                const int dz = (corner0 >> 1) & 1;
+                                const int dy = (corner0 >> 2) & 1;
+                                const int axis = (axisBit == 1) ? 0 : ((axisBit == 4) ? 1 : 2);
+                                const float value0 = rows[dy][dz][x + dx];
+                                const float value1 = rows[(corner1 >> 2) & 1][(corner1 >> 1) & 1][x + (corner1 & 1)];
+                                outputVertices[vertexId] = GetEdgeIntersection(value0, value1, glm::vec3(x + dx, y + dy, z + dz), axis, origin, cellSize);
+                            }
+                        }
+                        for (int i = 0; i < cellCase.numTriangles * 3; ++i)
+                        {
+                            *indices++ = vertexIds[cellCase.vertexIndices[i]];
+                        }
+
+                        // Advance to the next cell
+                        for (int i = 0; i < 2; ++i)
+                        {
+                            for (int j = 0; j < 2; ++j)
+                            {
+                                xIds[i][j] += crossesX[i][j] ? 1 : 0;
+                            }
+                            yIds[i] += crossesY[i] ? 1 : 0;
+                            zIds[i] += crossesZ[i] ? 1 : 0;
+                        }
+                    }
+                }
+            }
+        });
+    }
+}
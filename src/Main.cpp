@@ -1,13 +1,50 @@
 #include "Engine/Application.hpp"
 
 #include "MainScene.hpp"
+#include "RawVolumeMesher.hpp"
 
-int main()
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+int main(int argc, char* argv[])
 {
+    // Scanned volumes are meshed offline, without opening a window:
+    // --mesh-volume <volume.raw> <isovalue> <output.stl>
+    if ((argc > 1) && (std::strcmp(argv[1], "--mesh-volume") == 0))
+    {
+        if (argc != 5)
+        {
+            std::cerr << "Usage: " << argv[0] << " --mesh-volume <volume.raw> <isovalue> <output.stl>" << std::endl;
+            return 1;
+        }
+
+        MarchingCubes::RawVolume volume;
+        if (!volume.Open(argv[2]))
+        {
+            std::cerr << "Cannot open raw volume: " << argv[2] << std::endl;
+            return 1;
+        }
+        if (!MarchingCubes::RawVolumeMesher::WriteStl(volume, static_cast<float>(std::atof(argv[3])), argv[4]))
+        {
+            std::cerr << "Cannot write mesh: " << argv[4] << std::endl;
+            return 1;
+        }
+        return 0;
+    }
+
+    // The meshing algorithm can be chosen per deployment by its identifier, e.g. "surface-nets"
+    MarchingCubes::MeshingAlgorithm meshingAlgorithm = MarchingCubes::MeshingAlgorithm::MarchingCubes;
+    if ((argc > 1) && !MarchingCubes::ParseMeshingAlgorithm(argv[1], meshingAlgorithm))
+    {
+        std::cerr << "Unknown meshing algorithm: " << argv[1] << std::endl;
+        return 1;
+    }
+
     {
         Application application;
 
-        MarchingCubes::MainScene* scene = new MarchingCubes::MainScene();
+        MarchingCubes::MainScene* scene = new MarchingCubes::MainScene(meshingAlgorithm);
         application.SetStartingScene(scene);
         application.Run();
 
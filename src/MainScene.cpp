@@ -1,7 +1,11 @@
 #include "MainScene.hpp"
 
+#include "CellClassifier.hpp"
+#include "DensityBounds.hpp"
+#include "Meshers.hpp"
 #include "MarchingCubes.hpp"
-#include "Triangle.hpp"
+#include "MeshDecimator.hpp"
+#include "NoiseBatch.hpp"
 
 #include "Engine/Input.hpp"
 #include "Engine/Graphics/ShaderProgram.hpp"
@@ -11,6 +15,7 @@
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/type_ptr.hpp>
 
+#include <algorithm>
 #include <iomanip>
 #include <iostream>
 #include <sstream>
@@ -19,8 +24,9 @@ namespace MarchingCubes
 {
     /**
      * @brief Constructor
+     * @param[in] meshingAlgorithm Algorithm used to mesh the chunks at startup
      */
-    MainScene::MainScene()
+    MainScene::MainScene(MeshingAlgorithm meshingAlgorithm)
         : SceneBase()
         , m_terrain()
         , m_renderer()
@@ -32,16 +38,32 @@ namespace MarchingCubes
         , m_workerThreads()
         , m_chunkSize(8.0f)
         , m_voxelSize(1.0f)
+        , m_vertexPositionStep(TerrainVertex::GetPositionStep(3.0f * m_chunkSize))
         , m_chunkRenderDistance(8, 8, 8)
+        , m_maxChunkLod(2)
+        , m_chunkLodDistance(2)
+        , m_numChunkCullingDivisions(4)
         , m_isDone(false)
         , m_firstChunkUpdate(true)
         , m_prevChunkIndex(0)
         , m_waterPlaneVertices()
         , m_waterPlaneIndices()
         , m_time(0.0f)
+        , m_numGeneratedChunks(0)
+        , m_chunkThroughputTimer(0.0f)
+        , m_chunkThroughput(0.0f)
+        , m_meshingAlgorithm(meshingAlgorithm)
+        , m_meshers()
+        , m_isDecimationEnabled(true)
+        , m_decimationError(0.05f)
         , m_font(nullptr)
         , m_debugText(nullptr)
     {
+        // Chunks are already spread across the worker threads
+        for (int i = 0; i < static_cast<int>(MeshingAlgorithm::Count); ++i)
+        {
+            m_meshers.push_back(CreateMesher<Terrain, TerrainVertexSink>(static_cast<MeshingAlgorithm>(i), 1));
+        }
     }
 
     /**
@@ -59,10 +81,10 @@ namespace MarchingCubes
         m_camera.SetAspectRatio(800.0f / 600.0f);
         m_camera.SetFieldOfView(90.0f);
 
-        ShaderCreateInfo mainShaderCreateInfo;
-        mainShaderCreateInfo.vertexShaderFilePath = "resources/shaders/main.vsh";
-        mainShaderCreateInfo.fragmentShaderFilePath = "resources/shaders/main.fsh";
-        ResourceManager::CreateShader("main", mainShaderCreateInfo);
+        ShaderCreateInfo terrainShaderCreateInfo;
+        terrainShaderCreateInfo.vertexShaderFilePath = "resources/shaders/terrain.vsh";
+        terrainShaderCreateInfo.fragmentShaderFilePath = "resources/shaders/main.fsh";
+        ResourceManager::CreateShader("terrain", terrainShaderCreateInfo);
 
         ShaderCreateInfo colorShaderCreateInfo;
         colorShaderCreateInfo.vertexShaderFilePath = "resources/shaders/color.vsh";
@@ -94,12 +116,10 @@ namespace MarchingCubes
 
         m_loadedChunks.clear();
 
-        std::function<float(float, float, float)> func = std::bind(&Terrain::DensityFunction, &m_terrain, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3);
-
         const int numWorkerThreads = 4;
         for (int i = 0; i < numWorkerThreads; ++i)
         {
-            m_workerThreads.emplace_back(&MainScene::ThreadJob, this, i, func);
+            m_workerThreads.emplace_back(&MainScene::ThreadJob, this, i);
         }
 
         m_font = new Font();
@@ -171,6 +191,17 @@ namespace MarchingCubes
             m_camera.SetPosition(m_camera.GetPosition() + right * movementDistance);
         }
 
+        // Only affects the chunks generated from now on
+        if (Input::IsPressed(Input::Key::M))
+        {
+            int nextAlgorithm = (static_cast<int>(m_meshingAlgorithm.load()) + 1) % static_cast<int>(MeshingAlgorithm::Count);
+            m_meshingAlgorithm = static_cast<MeshingAlgorithm>(nextAlgorithm);
+        }
+        if (Input::IsPressed(Input::Key::N))
+        {
+            m_isDecimationEnabled = !m_isDecimationEnabled;
+        }
+
         int mouseDeltaX, mouseDeltaY;
         Input::GetMouseDelta(&mouseDeltaX, &mouseDeltaY);
 
@@ -178,6 +209,13 @@ namespace MarchingCubes
         m_camera.SetYaw(m_camera.GetYaw() + mouseDeltaX * sensitivity);
         m_camera.SetPitch(glm::clamp(m_camera.GetPitch() - mouseDeltaY * sensitivity, -89.0f, 89.0f));
 
+        m_chunkThroughputTimer += deltaTime;
+        if (m_chunkThroughputTimer >= 1.0f)
+        {
+            m_chunkThroughput = m_numGeneratedChunks.exchange(0) / m_chunkThroughputTimer;
+            m_chunkThroughputTimer = 0.0f;
+        }
+
         UpdateChunks();
 
         // Update water plane position
@@ -204,28 +242,31 @@ namespace MarchingCubes
         glEnable(GL_DEPTH_TEST);
     	glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
     
-        ShaderProgram* mainShader = ResourceManager::GetShader("main");
+        ShaderProgram* terrainShader = ResourceManager::GetShader("terrain");
 
         glm::mat4 projMatrix = m_camera.GetProjectionMatrix();
         glm::mat4 viewMatrix = m_camera.GetViewMatrix();
         glm::mat4 modelMatrix = glm::mat4(1.0f);
         glm::mat4 mvpMatrix = projMatrix * viewMatrix * modelMatrix;
 
-        mainShader->Use();
+        terrainShader->Use();
 
-        mainShader->SetUniformMatrix4fv("mvpMatrix", false, glm::value_ptr(mvpMatrix));
-        mainShader->SetUniformMatrix4fv("modelMatrix", false, glm::value_ptr(modelMatrix));
+        terrainShader->SetUniformMatrix4fv("mvpMatrix", false, glm::value_ptr(mvpMatrix));
+        terrainShader->SetUniformMatrix4fv("modelMatrix", false, glm::value_ptr(modelMatrix));
+        terrainShader->SetUniform1f("positionStep", m_vertexPositionStep);
 
         glm::vec3 lightDir(0.0f, -1.0f, 1.0f);
         lightDir = glm::normalize(lightDir);
-        mainShader->SetUniform3f("lightDir", lightDir.x, lightDir.y, lightDir.z);
+        terrainShader->SetUniform3f("lightDir", lightDir.x, lightDir.y, lightDir.z);
 
         m_chunkListMutex.lock();
         for (size_t i = 0; i < m_loadedChunks.size(); ++i)
         {
             if (m_loadedChunks[i]->isDone)
             {
-                m_renderer.DrawTriangles(m_loadedChunks[i]->meshVertices);
+                const glm::vec3& meshOrigin = m_loadedChunks[i]->meshOrigin;
+                terrainShader->SetUniform3f("chunkOrigin", meshOrigin.x, meshOrigin.y, meshOrigin.z);
+                m_renderer.DrawTriangles(m_loadedChunks[i]->meshVertices, m_loadedChunks[i]->meshIndices);
             }
         }
         m_chunkListMutex.unlock();
@@ -257,11 +298,11 @@ namespace MarchingCubes
                 for (size_t j = 0; j < m_loadedChunks[i]->meshVertices.size(); ++j)
                 {
                     lines.emplace_back();
-                    lines.back().position = m_loadedChunks[i]->meshVertices[j].position;
+                    lines.back().position = m_loadedChunks[i]->meshVertices[j].GetPosition(m_loadedChunks[i]->meshOrigin, m_vertexPositionStep);
                     lines.back().color = glm::vec4(1.0f, 0.0f, 0.0f, 1.0f);
 
                     lines.emplace_back();
-                    lines.back().position = m_loadedChunks[i]->meshVertices[j].position + m_loadedChunks[i]->meshVertices[j].normal;
+                    lines.back().position = m_loadedChunks[i]->meshVertices[j].GetPosition(m_loadedChunks[i]->meshOrigin, m_vertexPositionStep) + m_loadedChunks[i]->meshVertices[j].GetNormal();
                     lines.back().color = glm::vec4(1.0f, 0.0f, 0.0f, 1.0f);
                 }
                 m_renderer.DrawLines(lines);
@@ -280,10 +321,8 @@ namespace MarchingCubes
     /**
      * @brief Routine to be done by each worker thread.
      * @param[in] threadIndex Thread index
-     * @param[in] signedDistanceFunc Signed distance function
-     * @param[in] voxelSize Voxel size
      */
-    void MainScene::ThreadJob(int threadIndex, std::function<float(float, float, float)> signedDistanceFunc)
+    void MainScene::ThreadJob(int threadIndex)
     {
         std::cout << "Thread " << threadIndex << " created." << std::endl;
 
@@ -302,20 +341,67 @@ namespace MarchingCubes
 
             if (!isEmpty)
             {
-                std::vector<Triangle> triangles;
-                MarchingCubes::GetInstance().GetMesh(signedDistanceFunc, chunk->bounds, m_voxelSize, triangles);
+                float voxelSize = m_voxelSize * static_cast<float>(1 << chunk->lod);
+                const MesherBase<Terrain, TerrainVertexSink>& mesher = *m_meshers[static_cast<int>(m_meshingAlgorithm.load())];
+
+                // The mesher quantizes the vertices straight into the chunk. Vertices lie at most
+                // one voxel, so one chunk size, outside of the chunk bounds.
+                chunk->meshOrigin = chunk->bounds.min - m_chunkSize;
+                TerrainVertexSink vertexSink(chunk->meshVertices, chunk->meshOrigin, m_vertexPositionStep);
+                mesher.GetIndexedMesh(m_terrain, chunk->bounds, voxelSize, chunk->transitionFaces, vertexSink, chunk->meshIndices);
+
+                if (m_isDecimationEnabled)
+                {
+                    // The chunk borders are left as they are, so the neighbors still match
+                    std::vector<glm::vec3> positions(chunk->meshVertices.size());
+                    for (size_t i = 0; i < positions.size(); ++i)
+                    {
+                        positions[i] = chunk->meshVertices[i].GetPosition(chunk->meshOrigin, m_vertexPositionStep);
+                    }
+
+                    std::vector<uint32_t> vertexMap;
+                    MeshDecimator::Decimate(positions, chunk->meshIndices, m_decimationError * voxelSize, 0.0f, &vertexMap);
+
+                    std::vector<TerrainVertex> vertices(positions.size());
+                    for (size_t i = 0; i < vertices.size(); ++i)
+                    {
+                        vertices[i] = chunk->meshVertices[vertexMap[i]];
+                        vertices[i].SetPosition(positions[i], chunk->meshOrigin, m_vertexPositionStep);
+                    }
+                    chunk->meshVertices.swap(vertices);
+                }
 
-                for (size_t i = 0; i < triangles.size(); ++i)
+                if (!mesher.SupportsNormals())
                 {
-                    for (size_t j = 0; j < 3; ++j)
+                    // Vertices are shared between triangles, so accumulate the
+                    // area-weighted face normals and normalize them afterwards
+                    std::vector<glm::vec3> normals(chunk->meshVertices.size(), glm::vec3(0.0f));
+                    for (size_t i = 0; i < chunk->meshIndices.size(); i += 3)
                     {
-                        chunk->meshVertices.emplace_back();
-                        chunk->meshVertices.back().position = triangles[i].vertices[j];
-                        chunk->meshVertices.back().color = glm::vec4(1.0f);
-                        chunk->meshVertices.back().normal = triangles[i].GetNormal();
+                        const GLuint i0 = chunk->meshIndices[i];
+                        const GLuint i1 = chunk->meshIndices[i + 1];
+                        const GLuint i2 = chunk->meshIndices[i + 2];
+                        const glm::vec3 p0 = chunk->meshVertices[i0].GetPosition(chunk->meshOrigin, m_vertexPositionStep);
+                        const glm::vec3 p1 = chunk->meshVertices[i1].GetPosition(chunk->meshOrigin, m_vertexPositionStep);
+                        const glm::vec3 p2 = chunk->meshVertices[i2].GetPosition(chunk->meshOrigin, m_vertexPositionStep);
+
+                        glm::vec3 faceNormal = glm::cross(p2 - p0, p1 - p0);
+                        normals[i0] += faceNormal;
+                        normals[i1] += faceNormal;
+                        normals[i2] += faceNormal;
+                    }
+                    for (size_t i = 0; i < chunk->meshVertices.size(); ++i)
+                    {
+                        float length = glm::length(normals[i]);
+                        if (length > 0.0f)
+                        {
+                            chunk->meshVertices[i].SetNormal(normals[i] / length);
+                        }
                     }
                 }
                 chunk->isDone = true;
+
+                ++m_numGeneratedChunks;
             }
         }
 
@@ -351,6 +437,11 @@ namespace MarchingCubes
         m_chunkListMutex.unlock();
         debugTextStream << "Pending chunks: " << numPendingChunks << std::endl;
         debugTextStream << "Completed chunks: " << numCompletedChunks << std::endl;
+        debugTextStream << "Chunk throughput: " << m_chunkThroughput << " chunks/s" << std::endl;
+        debugTextStream << "Cell classifier: " << GetCellClassifierName() << std::endl;
+        debugTextStream << "Noise batch: " << GetNoiseBatchName() << std::endl;
+        debugTextStream << "Meshing algorithm (M): " << GetMeshingAlgorithmName(m_meshingAlgorithm) << std::endl;
+        debugTextStream << "Decimation (N): " << (m_isDecimationEnabled ? "on" : "off") << std::endl;
         m_debugText->SetString(debugTextStream.str());
 
         // TODO: https://stackoverflow.com/questions/66135217/how-to-subdivide-set-of-overlapping-aabb-into-non-overlapping-set-of-aabbs
@@ -376,7 +467,8 @@ namespace MarchingCubes
             m_chunkListMutex.lock();
             for (int32_t i = m_loadedChunks.size() - 1; i >= 0; --i)
             {
-                if (m_loadedChunks[i]->isDone && !m_loadedChunks[i]->bounds.Intersects(targetBounds))
+                // Chunks waiting for their replacement are removed once it is done
+                if (m_loadedChunks[i]->isDone && (m_loadedChunks[i]->replacement == nullptr) && !m_loadedChunks[i]->bounds.Intersects(targetBounds))
                 {
                     delete m_loadedChunks[i];
                     m_loadedChunks[i] = m_loadedChunks.back();
@@ -406,12 +498,25 @@ namespace MarchingCubes
                             chunk->indices = glm::ivec3(x, y, z);
                             chunk->bounds = chunkBounds;
                             chunk->isDone = false;
+                            chunk->lod = GetChunkLod(chunk->indices, currentChunkIndex);
+                            chunk->transitionFaces = GetChunkTransitionFaces(chunk->indices, currentChunkIndex);
+                            chunk->replacement = nullptr;
+
+                            // Chunks without a surface are done as they are, with an empty mesh
+                            if (IsChunkEmptyOrSolid(*chunk))
+                            {
+                                chunk->meshOrigin = chunk->bounds.min;
+                                chunk->isDone = true;
+                            }
 
                             m_chunkListMutex.lock();
                             m_loadedChunks.push_back(chunk);
                             m_chunkListMutex.unlock();
 
-                            chunksToGenerate.push_back(chunk);
+                            if (!chunk->isDone)
+                            {
+                                chunksToGenerate.push_back(chunk);
+                            }
                         }
                     }
                 }
@@ -425,8 +530,140 @@ namespace MarchingCubes
             m_threadJobQueueMutex.unlock();
         }
 
+        // Remesh the chunks whose level of detail changed. The old mesh
+        // keeps being drawn until the new one is done.
+        std::vector<Chunk*> chunksToRemesh;
+        m_chunkListMutex.lock();
+        for (size_t i = 0; i < m_loadedChunks.size(); ++i)
+        {
+            Chunk* chunk = m_loadedChunks[i];
+            if (chunk->replacement != nullptr)
+            {
+                if (chunk->replacement->isDone)
+                {
+                    m_loadedChunks[i] = chunk->replacement;
+                    delete chunk;
+                }
+                continue;
+            }
+
+            if (!chunk->isDone)
+            {
+                continue;
+            }
+
+            int lod = GetChunkLod(chunk->indices, currentChunkIndex);
+            int transitionFaces = GetChunkTransitionFaces(chunk->indices, currentChunkIndex);
+            if ((lod != chunk->lod) || (transitionFaces != chunk->transitionFaces))
+            {
+                Chunk* replacement = new Chunk();
+                replacement->indices = chunk->indices;
+                replacement->bounds = chunk->bounds;
+                replacement->isDone = false;
+                replacement->lod = lod;
+                replacement->transitionFaces = transitionFaces;
+                replacement->replacement = nullptr;
+
+                if (IsChunkEmptyOrSolid(*replacement))
+                {
+                    replacement->meshOrigin = replacement->bounds.min;
+                    replacement->isDone = true;
+                }
+
+                chunk->replacement = replacement;
+                if (!replacement->isDone)
+                {
+                    chunksToRemesh.push_back(replacement);
+                }
+            }
+        }
+        m_chunkListMutex.unlock();
+
+        m_threadJobQueueMutex.lock();
+        for (size_t i = 0; i < chunksToRemesh.size(); ++i)
+        {
+            m_threadJobQueue.push(chunksToRemesh[i]);
+        }
+        m_threadJobQueueMutex.unlock();
+
         m_firstChunkUpdate = false;
         m_prevChunkIndex = currentChunkIndex;
     }
+
+    /**
+     * @brief Gets the level of detail of a chunk
+     * @param[in] chunkIndex Chunk index
+     * @param[in] centerChunkIndex Index of the chunk the camera is in
+     * @return Level of detail
+     */
+    int MainScene::GetChunkLod(const glm::ivec3& chunkIndex, const glm::ivec3& centerChunkIndex) const
+    {
+        // Different levels of detail can only be stitched with transition cells
+        if (!m_meshers[static_cast<int>(m_meshingAlgorithm.load())]->SupportsTransitionFaces())
+        {
+            return 0;
+        }
+
+        // Rings of chunks around the camera. Neighboring chunks are at most
+        // one level apart, which is what the transition cells can stitch.
+        glm::ivec3 distance = glm::abs(chunkIndex - centerChunkIndex);
+        int ring = std::max(distance.x, std::max(distance.y, distance.z));
+
+        int lod = std::min(ring / m_chunkLodDistance, m_maxChunkLod);
+
+        // Each level doubles the voxel size, which must still divide the chunk size
+        while ((lod > 0) && (m_voxelSize * (1 << lod) > m_chunkSize))
+        {
+            --lod;
+        }
+        return lod;
+    }
+
+    /**
+     * @brief Checks whether the terrain provably has no surface in a chunk
+     * @param[in] chunk Chunk, with its bounds and level of detail set
+     * @return True if the chunk is all air or all solid, false if it may have a surface or is not at full detail
+     */
+    bool MainScene::IsChunkEmptyOrSolid(const Chunk& chunk)
+    {
+        // Coarser chunks are cheap to mesh, and their larger voxels loosen the
+        // bounds, so proving them empty costs more than meshing them
+        if (chunk.lod > 0)
+        {
+            return false;
+        }
+
+        // The meshers sample at most one voxel outside of the chunk bounds, so
+        // the chunk has no triangles if none of these samples changes sign
+        AABB box;
+        box.min = chunk.bounds.min - m_voxelSize;
+        box.max = chunk.bounds.max + m_voxelSize;
+
+        float value;
+        return IsDensitySignConstant(m_terrain, box, m_numChunkCullingDivisions, value);
+    }
+
+    /**
+     * @brief Gets the faces of a chunk that border a chunk with a finer level of detail
+     * @param[in] chunkIndex Chunk index
+     * @param[in] centerChunkIndex Index of the chunk the camera is in
+     * @return Combination of MarchingCubes::TransitionFace flags
+     */
+    int MainScene::GetChunkTransitionFaces(const glm::ivec3& chunkIndex, const glm::ivec3& centerChunkIndex) const
+    {
+        const int lod = GetChunkLod(chunkIndex, centerChunkIndex);
+
+        int transitionFaces = 0;
+        for (int face = 0; face < 6; ++face)
+        {
+            glm::ivec3 neighborIndex = chunkIndex;
+            neighborIndex[face / 2] += ((face & 1) != 0) ? 1 : -1;
+            if (GetChunkLod(neighborIndex, centerChunkIndex) < lod)
+            {
+                transitionFaces |= 1 << face;
+            }
+        }
+        return transitionFaces;
+    }
 }
 
@@ -1,9 +1,32 @@
 #include "MarchingCubes.hpp"
 
+#include "CellSurfaceTracer.hpp"
+
+#include <algorithm>
+#include <cmath>
 #include <functional>
+#include <unordered_map>
+#include <utility>
 
 namespace MarchingCubes
 {
+    const glm::vec3 MarchingCubes::vertexPositionOffsets[8] =
+    {
+        {0.0f, 0.0f, 0.0f},
+        {1.0f, 0.0f, 0.0f},
+        {0.0f, 0.0f, 1.0f},
+        {1.0f, 0.0f, 1.0f},
+        {0.0f, 1.0f, 0.0f},
+        {1.0f, 1.0f, 0.0f},
+        {0.0f, 1.0f, 1.0f},
+        {1.0f, 1.0f, 1.0f}
+    };
+
+    constexpr unsigned char RegularCellTables::regularCellClass[256];
+    constexpr RegularCellData RegularCellTables::regularCellData[16];
+    constexpr unsigned short RegularCellTables::regularVertexData[256][12];
+    constexpr RegularCaseTable MarchingCubes::regularCases;
+
     /**
      * @brief Gets the singleton instance for this class
      * @return Single instance for this class
@@ -30,16 +53,38 @@ namespace MarchingCubes
      */
     void MarchingCubes::GetMesh(std::function<float(float, float, float)> signedDistanceFunc, const AABB& bounds, float cellSize, std::vector<Triangle>& outputTriangles)
     {
-        for (float x = bounds.min[0]; x < bounds.max[0]; x += cellSize)
-        {
-            for (float y = bounds.min[1]; y < bounds.max[1]; y += cellSize)
-            {
-                for (float z = bounds.min[2]; z < bounds.max[2]; z += cellSize) // Right-handed system
-                {
-                    GetCellTriangles(signedDistanceFunc, x, y, z, cellSize, outputTriangles);
-                }
-            }
-        }
+        GetMesh<std::function<float(float, float, float)>&>(signedDistanceFunc, bounds, cellSize, outputTriangles);
+    }
+
+    /**
+     * @brief Gets the resulting indexed mesh upon performing marching cubes.
+     *
+     * Vertices shared by neighboring cells are only created once, using the
+     * vertex reuse data from the Transvoxel tables.
+     * @param[in] signedDistanceFunc Signed distance function
+     * @param[in] bounds Shape bounds
+     * @param[in] cellSize Cell size
+     * @param[out] outputVertices Vector where the vertex positions will be placed
+     * @param[out] outputIndices Vector where the triangle vertex indices will be placed
+     * @return True if successful. False if the vertex count exceeds the range of the index type.
+     */
+    bool MarchingCubes::GetIndexedMesh(std::function<float(float, float, float)> signedDistanceFunc, const AABB& bounds, float cellSize, std::vector<glm::vec3>& outputVertices, std::vector<uint32_t>& outputIndices)
+    {
+        return GetIndexedMesh<std::function<float(float, float, float)>&>(signedDistanceFunc, bounds, cellSize, outputVertices, outputIndices);
+    }
+
+    /**
+     * @brief Gets the resulting indexed mesh upon performing marching cubes, using 16-bit indices.
+     * @param[in] signedDistanceFunc Signed distance function
+     * @param[in] bounds Shape bounds
+     * @param[in] cellSize Cell size
+     * @param[out] outputVertices Vector where the vertex positions will be placed
+     * @param[out] outputIndices Vector where the triangle vertex indices will be placed
+     * @return True if successful. False if the vertex count exceeds the range of the index type.
+     */
+    bool MarchingCubes::GetIndexedMesh(std::function<float(float, float, float)> signedDistanceFunc, const AABB& bounds, float cellSize, std::vector<glm::vec3>& outputVertices, std::vector<uint16_t>& outputIndices)
+    {
+        return GetIndexedMesh<std::function<float(float, float, float)>&>(signedDistanceFunc, bounds, cellSize, outputVertices, outputIndices);
     }
 
     /**
@@ -50,15 +95,17 @@ namespace MarchingCubes
      * @param[in] cellZ Z-position of the cell
      * @param[in] cellSize Cell size
      * @param[out] outputTriangles Vector where the triangles will be placed 
+     * @param[in] isovalue Function value of the surface. Values above it are inside.
      */
-    void MarchingCubes::GetCellTriangles(std::function<float(float, float, float)> signedDistanceFunc, float cellX, float cellY, float cellZ, float cellSize, std::vector<Triangle>& outputTriangles)
+    void MarchingCubes::GetCellTriangles(std::function<float(float, float, float)> signedDistanceFunc, float cellX, float cellY, float cellZ, float cellSize, std::vector<Triangle>& outputTriangles, float isovalue)
     {
+        // Relative to the isovalue, the surface is where the values cross 0
         float values[8];
         for (int i = 0; i < 8; ++i)
         {
             values[i] = signedDistanceFunc(cellX + vertexPositionOffsets[i].x * cellSize,
                                            cellY + vertexPositionOffsets[i].y * cellSize,
-                                           cellZ + vertexPositionOffsets[i].z * cellSize);
+                                           cellZ + vertexPositionOffsets[i].z * cellSize) - isovalue;
         }
 
         int caseIndex = 0;
@@ -70,38 +117,490 @@ namespace MarchingCubes
             }
         }
 
-        unsigned char caseClass = regularCellClass[caseIndex];
+        Triangle triangles[5];
+        int numTriangles = PolygonizeCell(caseIndex, values, glm::vec3(cellX, cellY, cellZ), cellSize, triangles);
+        outputTriangles.insert(outputTriangles.end(), triangles, triangles + numTriangles);
+    }
+
+    /**
+     * @brief Gets the number of cells that fit in the provided bounds along each axis
+     * @param[in] bounds Shape bounds
+     * @param[in] cellSize Cell size
+     * @return Number of cells along each axis
+     */
+    glm::ivec3 MarchingCubes::GetCellCount(const AABB& bounds, float cellSize)
+    {
+        // Small tolerance so that an extent which is an exact multiple of the
+        // cell size does not get an extra cell due to rounding errors.
+        const float tolerance = 1e-4f;
 
-        RegularCellData cellData = regularCellData[caseClass];
-        if (cellData.GetVertexCount() == 0)
+        glm::ivec3 numCells;
+        for (int i = 0; i < 3; ++i)
         {
-            return;
+            numCells[i] = static_cast<int>(std::ceil((bounds.max[i] - bounds.min[i]) / cellSize - tolerance));
         }
+        return numCells;
+    }
 
-        Triangle triangle;
-        for (int i = 0; i < cellData.GetTriangleCount(); ++i)
+    /**
+     * @brief Gets the cell triangles based on the already sampled values at the cell corners
+     * @param[in] caseIndex Case index of the cell
+     * @param[in] values Function values at the 8 cell corners
+     * @param[in] cellPosition Position of the cell's minimum corner
+     * @param[in] cellSize Cell size
+     * @param[out] outputTriangles Array where the triangles will be placed. Must have room for 5 triangles.
+     * @return Number of triangles placed in the array
+     */
+    int MarchingCubes::PolygonizeCell(int caseIndex, const float values[8], const glm::vec3& cellPosition, float cellSize, Triangle* outputTriangles)
+    {
+        const RegularCase& cellCase = regularCases.cases[caseIndex];
+
+        // Interpolate every edge vertex once, rather than once per triangle using it
+        glm::vec3 vertices[12];
+        for (int i = 0; i < cellCase.numVertices; ++i)
+        {
+            vertices[i] = GetEdgeVertex(values, cellPosition, cellSize, cellCase.vertexData[i]);
+        }
+
+        const int numTriangles = cellCase.numTriangles;
+        for (int i = 0; i < numTriangles; ++i)
         {
             for (int j = 0; j < 3; ++j)
             {
-                int index = cellData.vertexIndex[i * 3 + j];
+                outputTriangles[i].vertices[j] = vertices[cellCase.vertexIndices[i * 3 + j]];
+            }
+        }
+        return numTriangles;
+    }
+
+    /**
+     * @brief Finds all the cells in a sampled lattice that the surface passes through
+     * @param[in] lattice Sampled lattice
+     * @param[in] numCells Number of cells along each axis
+     * @param[in] zBegin Z-index of the first cell slab to search
+     * @param[in] zEnd One past the z-index of the last cell slab to search
+     * @param[out] outputActiveCells Vector where the active cells will be placed, in x, y, z order
+     * @return Total number of triangles produced by the active cells
+     */
+    size_t MarchingCubes::GetActiveCells(const std::vector<float>& lattice, const glm::ivec3& numCells, int zBegin, int zEnd, std::vector<ActiveCell>& outputActiveCells)
+    {
+        std::vector<unsigned char> rowCases(numCells.x);
+        std::vector<int> rowActiveCells(numCells.x);
+
+        size_t numTriangles = 0;
+        for (int z = zBegin; z < zEnd; ++z)
+        {
+            for (int y = 0; y < numCells.y; ++y)
+            {
+                const int numRowActiveCells = ClassifyLatticeRow(lattice, numCells, y, z, rowCases.data(), rowActiveCells.data());
+                for (int i = 0; i < numRowActiveCells; ++i)
+                {
+                    ActiveCell cell;
+                    cell.x = rowActiveCells[i];
+                    cell.y = y;
+                    cell.z = z;
+                    cell.caseIndex = rowCases[cell.x];
+                    outputActiveCells.push_back(cell);
+
+                    numTriangles += regularCases.cases[cell.caseIndex].numTriangles;
+                }
+            }
+        }
+        return numTriangles;
+    }
+
+    /**
+     * @brief Triangulates active cells of a sampled lattice
+     * @param[in] lattice Sampled lattice
+     * @param[in] origin Position of the first grid corner
+     * @param[in] cellSize Cell size
+     * @param[in] numCells Number of cells along each axis
+     * @param[in] activeCells Active cells
+     * @param[out] outputTriangles Array where the triangles will be placed. Must have room for all of them.
+     */
+    void MarchingCubes::PolygonizeActiveCells(const std::vector<float>& lattice, const glm::vec3& origin, float cellSize, const glm::ivec3& numCells, const std::vector<ActiveCell>& activeCells, Triangle* outputTriangles)
+    {
+        const int strideY = numCells.x + 1;
+        const int strideZ = strideY * (numCells.y + 1);
+
+        int cornerOffsets[8];
+        GetCornerOffsets(numCells, cornerOffsets);
+
+        float values[8];
+        for (size_t i = 0; i < activeCells.size(); ++i)
+        {
+            const ActiveCell& cell = activeCells[i];
+            const int baseIndex = cell.x + cell.y * strideY + cell.z * strideZ;
+            for (int j = 0; j < 8; ++j)
+            {
+                values[j] = lattice[baseIndex + cornerOffsets[j]];
+            }
+
+            glm::vec3 cellPosition = origin + glm::vec3(cell.x, cell.y, cell.z) * cellSize;
+            outputTriangles += PolygonizeCell(cell.caseIndex, values, cellPosition, cellSize, outputTriangles);
+        }
+    }
+
+    /**
+     * @brief Gets the exact number of vertices GetIndexedMesh creates for the provided active cells
+     * @param[in] activeCells Active cells
+     * @return Number of vertices
+     */
+    size_t MarchingCubes::GetIndexedVertexCount(const std::vector<ActiveCell>& activeCells)
+    {
+        size_t numVertices = 0;
+        for (size_t i = 0; i < activeCells.size(); ++i)
+        {
+            // Vertices owned by a cell outside the lattice cannot be reused
+            const ActiveCell& cell = activeCells[i];
+            const int boundaryMask = ((cell.x == 0) ? 1 : 0) | ((cell.z == 0) ? 2 : 0) | ((cell.y == 0) ? 4 : 0);
+            numVertices += regularCases.cases[cell.caseIndex].numNewVertices[boundaryMask];
+        }
+        return numVertices;
+    }
+
+    /**
+     * @brief Classifies a row of cells in a sampled lattice
+     * @param[in] lattice Sampled lattice
+     * @param[in] numCells Number of cells along each axis
+     * @param[in] y Y-index of the cell row
+     * @param[in] z Z-index of the cell row
+     * @param[out] outputCases Array where the case indices of the row will be placed
+     * @param[out] outputActiveCells Array where the x-indices of the cells intersecting the surface will be placed
+     * @return Number of cells intersecting the surface
+     */
+    int MarchingCubes::ClassifyLatticeRow(const std::vector<float>& lattice, const glm::ivec3& numCells, int y, int z, unsigned char* outputCases, int* outputActiveCells)
+    {
+        const size_t strideY = numCells.x + 1;
+        const size_t strideZ = strideY * (numCells.y + 1);
+        const size_t rowIndex = y * strideY + z * strideZ;
+
+        // Same order as the corner bits of the case index
+        const float* rows[4] =
+        {
+            &lattice[rowIndex],
+            &lattice[rowIndex + strideZ],
+            &lattice[rowIndex + strideY],
+            &lattice[rowIndex + strideY + strideZ]
+        };
+
+        return ClassifyCellRow(rows, numCells.x, outputCases, outputActiveCells);
+    }
+
+    /**
+     * @brief Gets the offsets of the 8 cell corners inside a sampled lattice
+     * @param[in] numCells Number of cells along each axis
+     * @param[out] outputOffsets Array where the corner offsets will be placed
+     */
+    void MarchingCubes::GetCornerOffsets(const glm::ivec3& numCells, int outputOffsets[8]) const
+    {
+        const int strideY = numCells.x + 1;
+        const int strideZ = strideY * (numCells.y + 1);
+
+        for (int i = 0; i < 8; ++i)
+        {
+            outputOffsets[i] = static_cast<int>(vertexPositionOffsets[i].x)
+                             + static_cast<int>(vertexPositionOffsets[i].y) * strideY
+                             + static_cast<int>(vertexPositionOffsets[i].z) * strideZ;
+        }
+    }
+
+    /**
+     * @brief Gets the position of a vertex on a cell edge, interpolated from the corner values
+     * @param[in] values Function values at the 8 cell corners
+     * @param[in] cellPosition Position of the cell's minimum corner
+     * @param[in] cellSize Cell size
+     * @param[in] vertexData Vertex data of the flattened case
+     * @return Vertex position
+     */
+    glm::vec3 MarchingCubes::GetEdgeVertex(const float values[8], const glm::vec3& cellPosition, float cellSize, unsigned short vertexData) const
+    {
+        int ev0 = (vertexData & 0xF0) >> 4;
+        int ev1 = vertexData & 0x0F;
+
+        float val0 = values[ev0];
+        float val1 = values[ev1];
+
+        // Linear interpolation to smoothen the resulting mesh
+        float t = (0.0f - val0) / (val1 - val0);
+
+        glm::vec3 vPos = vertexPositionOffsets[ev0] + t * (vertexPositionOffsets[ev1] - vertexPositionOffsets[ev0]);
+        return cellPosition + vPos * cellSize;
+    }
+
+    /**
+     * @brief Gets the normal of a vertex on a cell edge, interpolated from the gradients at the edge corners
+     * @param[in] apronLattice Lattice sampled with a one-cell apron
+     * @param[in] numCells Number of cells along each axis, excluding the apron
+     * @param[in] cell Indices of the cell
+     * @param[in] values Function values at the 8 cell corners
+     * @param[in] vertexData Vertex data of the flattened case
+     * @return Unit vertex normal, pointing away from the positive side of the function
+     */
+    glm::vec3 MarchingCubes::GetEdgeNormal(const std::vector<float>& apronLattice, const glm::ivec3& numCells, const glm::ivec3& cell, const float values[8], unsigned short vertexData) const
+    {
+        int ev0 = (vertexData & 0xF0) >> 4;
+        int ev1 = vertexData & 0x0F;
+
+        glm::vec3 gradients[2];
+        for (int i = 0; i < 2; ++i)
+        {
+            gradients[i] = GetLatticeGradient(apronLattice, numCells, cell + glm::ivec3(vertexPositionOffsets[i == 0 ? ev0 : ev1]));
+        }
+
+        float t = (0.0f - values[ev0]) / (values[ev1] - values[ev0]);
+        glm::vec3 normal = -(gradients[0] + t * (gradients[1] - gradients[0]));
+
+        float length = glm::length(normal);
+        return (length > 0.0f) ? (normal / length) : glm::vec3(0.0f);
+    }
+
+    /**
+     * @brief Gets the unnormalized gradient at a grid corner, by central differences
+     * @param[in] apronLattice Lattice sampled with a one-cell apron
+     * @param[in] numCells Number of cells along each axis, excluding the apron
+     * @param[in] corner Indices of the grid corner
+     * @return Gradient, scaled by twice the cell size
+     */
+    glm::vec3 MarchingCubes::GetLatticeGradient(const std::vector<float>& apronLattice, const glm::ivec3& numCells, const glm::ivec3& corner)
+    {
+        const int strideY = numCells.x + 3;
+        const int strideZ = strideY * (numCells.y + 3);
+
+        // Grid corner (0, 0, 0) is at (1, 1, 1) in the apron lattice
+        const int index = (corner.x + 1) + (corner.y + 1) * strideY + (corner.z + 1) * strideZ;
+
+        // The cell size is left out, since the result gets normalized anyway
+        return glm::vec3(apronLattice[index + 1] - apronLattice[index - 1],
+                         apronLattice[index + strideY] - apronLattice[index - strideY],
+                         apronLattice[index + strideZ] - apronLattice[index - strideZ]);
+    }
+
+    /**
+     * @brief Copies a box out of a sampled lattice
+     * @param[in] lattice Sampled lattice
+     * @param[in] numSamples Number of samples along each axis of the lattice
+     * @param[in] begin First sample of the box
+     * @param[in] boxNumSamples Number of samples along each axis of the box
+     * @param[out] outputValues Vector where the samples of the box will be placed, x varying fastest
+     */
+    void MarchingCubes::ExtractSubLattice(const std::vector<float>& lattice, const glm::ivec3& numSamples, const glm::ivec3& begin, const glm::ivec3& boxNumSamples, std::vector<float>& outputValues)
+    {
+        const size_t strideY = numSamples.x;
+        const size_t strideZ = strideY * numSamples.y;
+
+        outputValues.resize(static_cast<size_t>(boxNumSamples.x) * boxNumSamples.y * boxNumSamples.z);
+
+        std::vector<float>::iterator outputRow = outputValues.begin();
+        for (int z = 0; z < boxNumSamples.z; ++z)
+        {
+            for (int y = 0; y < boxNumSamples.y; ++y)
+            {
+                std::vector<float>::const_iterator row = lattice.begin() + (begin.x + (begin.y + y) * strideY + (begin.z + z) * strideZ);
+                outputRow = std::copy(row, row + boxNumSamples.x, outputRow);
+            }
+        }
+    }
 
-                int ev0 = (regularVertexData[caseIndex][index] & 0xF0) >> 4;
-                int ev1 = regularVertexData[caseIndex][index] & 0x0F;
+    /**
+     * @brief Gets the block of half-size grid points sampled around a transition face.
+     *
+     * The block is one point thick on each side of the face and one point wider than it,
+     * so central differences are available on the face. Coordinates are in half cells from the origin.
+     * @param[in] numCells Number of cells along each axis
+     * @param[in] face Index of the face, the bit index of its TransitionFace flag
+     * @param[out] outputMin First point of the block
+     * @param[out] outputSize Number of points along each axis
+     */
+    void MarchingCubes::GetTransitionFaceBlock(const glm::ivec3& numCells, int face, glm::ivec3& outputMin, glm::ivec3& outputSize)
+    {
+        const int axis = face / 2;
+        const bool isPositive = (face & 1) != 0;
 
-                float val0 = values[ev0];
-                float val1 = values[ev1];
+        outputMin = glm::ivec3(-1);
+        outputSize = numCells * 2 + 3;
 
-                // Linear interpolation to smoothen the resulting mesh
-                float t = (0.0f - val0) / (val1 - val0);
+        outputMin[axis] = (isPositive ? numCells[axis] * 2 : 0) - 1;
+        outputSize[axis] = 3;
+    }
 
-                //glm::vec3 vPos = ((vertexPositionOffsets[ev0] + vertexPositionOffsets[ev1]) / 2.0f) * cellSize;
-                glm::vec3 vPos = vertexPositionOffsets[ev0] + t * (vertexPositionOffsets[ev1] - vertexPositionOffsets[ev0]);
-                vPos.x += cellX;
-                vPos.y += cellY;
-                vPos.z += cellZ;
-                triangle.vertices[j] = vPos;
+    /**
+     * @brief Triangulates the transition cells along the transition faces.
+     *
+     * A transition cell is a boundary cell whose faces lying on a transition face are split
+     * into 4 quads, using the samples at half the cell size. The edges of those faces gain a
+     * midpoint, which the neighboring cells share. The traces of the surface on the split faces
+     * match the mesh with half the cell size, and the ones on the other faces match the regular
+     * cells (see TraceCellSurface), so no cracks appear on either side.
+     * @param[in] lattice Sampled lattice
+     * @param[in] apronLattice Lattice sampled with a one-cell apron, used for the normals. Can be null.
+     * @param[in] faceSamples Samples at half the cell size around the transition faces, see GetTransitionFaceBlock
+     * @param[in] origin Position of the first grid corner
+     * @param[in] cellSize Cell size
+     * @param[in] numCells Number of cells along each axis
+     * @param[in] transitionFaces Combination of TransitionFace flags
+     * @param[out] outputVertices Vector where the vertex positions will be placed
+     * @param[out] outputNormals Vector where the vertex normals will be placed. Only used if apronLattice is given.
+     * @param[out] outputIndices Vector where the triangle vertex indices will be placed, relative to the first output vertex
+     */
+    void MarchingCubes::PolygonizeTransitionCells(const std::vector<float>& lattice, const std::vector<float>* apronLattice, const std::vector<float>& faceSamples, const glm::vec3& origin, float cellSize, const glm::ivec3& numCells, int transitionFaces, std::vector<glm::vec3>& outputVertices, std::vector<glm::vec3>* outputNormals, std::vector<uint32_t>& outputIndices) const
+    {
+        const size_t firstVertex = outputVertices.size();
+        const float halfCellSize = cellSize * 0.5f;
+        const int strideY = numCells.x + 1;
+        const int strideZ = strideY * (numCells.y + 1);
+
+        // Points are addressed in half cells from the origin
+        glm::ivec3 blockMins[6];
+        glm::ivec3 blockSizes[6];
+        size_t blockOffsets[6];
+        size_t blockOffset = 0;
+        for (int face = 0; face < 6; ++face)
+        {
+            if ((transitionFaces & (1 << face)) != 0)
+            {
+                GetTransitionFaceBlock(numCells, face, blockMins[face], blockSizes[face]);
+                blockOffsets[face] = blockOffset;
+                blockOffset += static_cast<size_t>(blockSizes[face].x) * blockSizes[face].y * blockSizes[face].z;
+            }
+        }
+
+        // Index into faceSamples of a point lying on a transition face
+        auto GetFaceSampleIndex = [&](const glm::ivec3& point, glm::ivec3& outputStrides) -> size_t
+        {
+            for (int face = 0; face < 6; ++face)
+            {
+                if (((transitionFaces & (1 << face)) != 0) && (point[face / 2] == blockMins[face][face / 2] + 1))
+                {
+                    const glm::ivec3 blockPoint = point - blockMins[face];
+                    outputStrides = glm::ivec3(1, blockSizes[face].x, blockSizes[face].x * blockSizes[face].y);
+                    return blockOffsets[face] + blockPoint.x * outputStrides.x + blockPoint.y * outputStrides.y + blockPoint.z * outputStrides.z;
+                }
+            }
+            outputStrides = glm::ivec3(0);
+            return 0;
+        };
+
+        // Grid corners are read from the lattice, the other points from the transition faces
+        auto GetValue = [&](const glm::ivec3& point) -> float
+        {
+            if (((point.x & 1) == 0) && ((point.y & 1) == 0) && ((point.z & 1) == 0))
+            {
+                return lattice[(point.x / 2) + (point.y / 2) * strideY + (point.z / 2) * strideZ];
+            }
+
+            glm::ivec3 strides;
+            return faceSamples[GetFaceSampleIndex(point, strides)];
+        };
+
+        // Every edge intersection is created once and shared by the cells around it
+        std::unordered_map<uint64_t, uint32_t> edgeVertices;
+        auto GetEdgeVertexIndex = [&](glm::ivec3 point0, glm::ivec3 point1) -> uint32_t
+        {
+            if ((point1.x < point0.x) || (point1.y < point0.y) || (point1.z < point0.z))
+            {
+                std::swap(point0, point1);
+            }
+
+            const glm::ivec3 edge = point1 - point0;
+            const uint64_t axis = (edge.y != 0) ? 1 : ((edge.z != 0) ? 2 : 0);
+            const uint64_t length = edge.x + edge.y + edge.z;
+            const uint64_t key = static_cast<uint64_t>(point0.x)
+                               | (static_cast<uint64_t>(point0.y) << 16)
+                               | (static_cast<uint64_t>(point0.z) << 32)
+                               | (axis << 48)
+                               | (length << 50);
+
+            std::unordered_map<uint64_t, uint32_t>::const_iterator it = edgeVertices.find(key);
+            if (it != edgeVertices.end())
+            {
+                return it->second;
+            }
+
+            const float value0 = GetValue(point0);
+            const float value1 = GetValue(point1);
+
+            // Linear interpolation to smoothen the resulting mesh
+            const float t = (0.0f - value0) / (value1 - value0);
+
+            const uint32_t vertexIndex = static_cast<uint32_t>(outputVertices.size() - firstVertex);
+            outputVertices.push_back(origin + (glm::vec3(point0) + t * glm::vec3(edge)) * halfCellSize);
+
+            if (apronLattice != nullptr)
+            {
+                glm::vec3 gradient0, gradient1;
+                if (length == 1)
+                {
+                    // Half-size edges lie on a transition face, so use the same
+                    // gradients as the mesh with half the cell size
+                    // The ends can lie in different face blocks, where an edge meets two transition faces
+                    glm::ivec3 strides0, strides1;
+                    const size_t index0 = GetFaceSampleIndex(point0, strides0);
+                    const size_t index1 = GetFaceSampleIndex(point1, strides1);
+                    gradient0 = glm::vec3(faceSamples[index0 + strides0.x] - faceSamples[index0 - strides0.x],
+                                          faceSamples[index0 + strides0.y] - faceSamples[index0 - strides0.y],
+                                          faceSamples[index0 + strides0.z] - faceSamples[index0 - strides0.z]);
+                    gradient1 = glm::vec3(faceSamples[index1 + strides1.x] - faceSamples[index1 - strides1.x],
+                                          faceSamples[index1 + strides1.y] - faceSamples[index1 - strides1.y],
+                                          faceSamples[index1 + strides1.z] - faceSamples[index1 - strides1.z]);
+                }
+                else
+                {
+                    gradient0 = GetLatticeGradient(*apronLattice, numCells, point0 / 2);
+                    gradient1 = GetLatticeGradient(*apronLattice, numCells, point1 / 2);
+                }
+
+                glm::vec3 normal = -(gradient0 + t * (gradient1 - gradient0));
+                float normalLength = glm::length(normal);
+                outputNormals->push_back((normalLength > 0.0f) ? (normal / normalLength) : glm::vec3(0.0f));
+            }
+
+            edgeVertices[key] = vertexIndex;
+            return vertexIndex;
+        };
+
+        CellSurfaceTracerBuffers tracerBuffers;
+        for (int z = 0; z < numCells.z; ++z)
+        {
+            for (int y = 0; y < numCells.y; ++y)
+            {
+                for (int x = 0; x < numCells.x; ++x)
+                {
+                    const glm::ivec3 cell(x, y, z);
+
+                    // Faces of the cell lying on a transition face
+                    int splitFaces = 0;
+                    for (int face = 0; face < 6; ++face)
+                    {
+                        const int axis = face / 2;
+                        if (((transitionFaces & (1 << face)) != 0) && (cell[axis] == (((face & 1) != 0) ? numCells[axis] - 1 : 0)))
+                        {
+                            splitFaces |= 1 << face;
+                        }
+                    }
+
+                    // Regular cell
+                    if (splitFaces == 0)
+                    {
+                        continue;
+                    }
+
+                    // Edge midpoints are used if the edge lies on a split face
+                    auto IsMidpointUsed = [&](const glm::ivec3& localPoint) -> bool
+                    {
+                        for (int axis = 0; axis < 3; ++axis)
+                        {
+                            if ((localPoint[axis] != 1) && ((splitFaces & (1 << (axis * 2 + localPoint[axis] / 2))) != 0))
+                            {
+                                return true;
+                            }
+                        }
+                        return false;
+                    };
+
+                    TraceCellSurface(cell * 2, 1, splitFaces, IsMidpointUsed, GetValue, GetEdgeVertexIndex, tracerBuffers, outputIndices);
+                }
             }
-            outputTriangles.push_back(triangle);
         }
     }
 }
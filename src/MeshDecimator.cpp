@@ -0,0 +1,486 @@
+#include "MeshDecimator.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <limits>
+#include <queue>
+
+namespace MarchingCubes
+{
+    /**
+     * @brief Adds the plane a * x + b * y + c * z + d = 0
+     * @param[in] plane Plane coefficients, with a unit normal
+     */
+    void MeshDecimator::Quadric::AddPlane(const glm::dvec4& plane)
+    {
+        coefficients[0] += plane.x * plane.x;
+        coefficients[1] += plane.x * plane.y;
+        coefficients[2] += plane.x * plane.z;
+        coefficients[3] += plane.x * plane.w;
+        coefficients[4] += plane.y * plane.y;
+        coefficients[5] += plane.y * plane.z;
+        coefficients[6] += plane.y * plane.w;
+        coefficients[7] += plane.z * plane.z;
+        coefficients[8] += plane.z * plane.w;
+        coefficients[9] += plane.w * plane.w;
+    }
+
+    /**
+     * @brief Adds another quadric
+     * @param[in] other Quadric to add
+     */
+    void MeshDecimator::Quadric::Add(const Quadric& other)
+    {
+        for (int i = 0; i < 10; ++i)
+        {
+            coefficients[i] += other.coefficients[i];
+        }
+    }
+
+    /**
+     * @brief Gets the sum of the squared distances of a point to the planes
+     * @param[in] point Point
+     * @return Error
+     */
+    double MeshDecimator::Quadric::GetError(const glm::dvec3& point) const
+    {
+        const double* q = coefficients;
+        const double error = q[0] * point.x * point.x + 2.0 * q[1] * point.x * point.y + 2.0 * q[2] * point.x * point.z + 2.0 * q[3] * point.x
+                           + q[4] * point.y * point.y + 2.0 * q[5] * point.y * point.z + 2.0 * q[6] * point.y
+                           + q[7] * point.z * point.z + 2.0 * q[8] * point.z
+                           + q[9];
+
+        // Rounding errors can make it slightly negative
+        return std::max(error, 0.0);
+    }
+
+    /**
+     * @brief Finds the point with the smallest error
+     * @param[out] outputPoint Point with the smallest error
+     * @return False if the planes do not determine a single point
+     */
+    bool MeshDecimator::Quadric::GetMinimum(glm::dvec3& outputPoint) const
+    {
+        const double* q = coefficients;
+        const glm::dmat3 a(q[0], q[1], q[2],
+                           q[1], q[4], q[5],
+                           q[2], q[5], q[7]);
+
+        // Planes that are all nearly parallel, or all go through a common line, do not have a single
+        // closest point. Compare the determinant with the scale of the matrix to catch these.
+        const double scale = q[0] + q[4] + q[7];
+        const double determinant = glm::determinant(a);
+        if (std::abs(determinant) <= 1e-6 * scale * scale * scale)
+        {
+            return false;
+        }
+
+        outputPoint = glm::inverse(a) * -glm::dvec3(q[3], q[6], q[8]);
+        return true;
+    }
+
+    /**
+     * @brief Simplifies an indexed mesh
+     * @param[in,out] positions Vertex positions. Only the vertices still used remain, in their original order.
+     * @param[in,out] indices Triangle vertex indices
+     * @param[in] maxError Largest collapse error, as a distance to the planes of the original triangles
+     * @param[in] minTriangleRatio Fraction of the triangles where the simplification stops, even below the largest error
+     * @param[out] outputVertexMap Vector where the original index of every remaining vertex will be placed, to carry other vertex attributes over. Can be null.
+     * @return Number of triangles removed
+     */
+    size_t MeshDecimator::Decimate(std::vector<glm::vec3>& positions, std::vector<uint32_t>& indices, float maxError, float minTriangleRatio, std::vector<uint32_t>* outputVertexMap)
+    {
+        const size_t numVertices = positions.size();
+        const size_t numTriangles = indices.size() / 3;
+
+        State state = {positions, indices, std::vector<Quadric>(numVertices, Quadric()), std::vector<std::vector<uint32_t>>(numVertices),
+                       std::vector<uint32_t>(numVertices, 0), std::vector<bool>(numVertices, false), std::vector<bool>(numVertices, false),
+                       std::vector<bool>(numTriangles, false)};
+
+        // Meshers can emit several vertices at the same position, for instance marching cubes along
+        // the minimum faces. Weld them, otherwise the edges between them look like borders.
+        std::vector<uint32_t> sortedVertices(numVertices);
+        for (size_t i = 0; i < numVertices; ++i)
+        {
+            sortedVertices[i] = static_cast<uint32_t>(i);
+        }
+        std::sort(sortedVertices.begin(), sortedVertices.end(), [&positions](uint32_t vertex0, uint32_t vertex1)
+        {
+            const glm::vec3& position0 = positions[vertex0];
+            const glm::vec3& position1 = positions[vertex1];
+            if (position0.x != position1.x)
+            {
+                return position0.x < position1.x;
+            }
+            if (position0.y != position1.y)
+            {
+                return position0.y < position1.y;
+            }
+            if (position0.z != position1.z)
+            {
+                return position0.z < position1.z;
+            }
+            return vertex0 < vertex1;
+        });
+
+        std::vector<uint32_t> weldedVertices(numVertices);
+        for (size_t i = 0; i < numVertices; ++i)
+        {
+            const uint32_t vertex = sortedVertices[i];
+            weldedVertices[vertex] = ((i > 0) && (positions[sortedVertices[i - 1]] == positions[vertex])) ? weldedVertices[sortedVertices[i - 1]] : vertex;
+        }
+        for (size_t i = 0; i < numTriangles * 3; ++i)
+        {
+            indices[i] = weldedVertices[indices[i]];
+        }
+
+        // Quadrics of the triangle planes, and the triangles around every vertex
+        size_t numLiveTriangles = 0;
+        std::vector<uint64_t> edges;
+        edges.reserve(numTriangles * 3);
+        for (size_t i = 0; i < numTriangles; ++i)
+        {
+            const uint32_t* triangle = &indices[i * 3];
+            if ((triangle[0] == triangle[1]) || (triangle[1] == triangle[2]) || (triangle[2] == triangle[0]))
+            {
+                state.isTriangleRemoved[i] = true;
+                continue;
+            }
+            ++numLiveTriangles;
+
+            const glm::dvec3 p0 = positions[triangle[0]];
+            const glm::dvec3 normal = glm::cross(glm::dvec3(positions[triangle[1]]) - p0, glm::dvec3(positions[triangle[2]]) - p0);
+            const double length = glm::length(normal);
+            for (int j = 0; j < 3; ++j)
+            {
+                // Degenerate triangles have no plane, but still connect their vertices
+                if (length > 0.0)
+                {
+                    const glm::dvec3 unitNormal = normal / length;
+                    state.quadrics[triangle[j]].AddPlane(glm::dvec4(unitNormal, -glm::dot(unitNormal, p0)));
+                }
+                state.vertexTriangles[triangle[j]].push_back(static_cast<uint32_t>(i));
+
+                const uint32_t vertex0 = std::min(triangle[j], triangle[(j + 1) % 3]);
+                const uint32_t vertex1 = std::max(triangle[j], triangle[(j + 1) % 3]);
+                edges.push_back((static_cast<uint64_t>(vertex0) << 32) | vertex1);
+            }
+        }
+
+        // Edges not shared by exactly 2 triangles are on the border of the chunk, or non-manifold.
+        // Their vertices stay where they are.
+        std::sort(edges.begin(), edges.end());
+        std::priority_queue<Collapse> collapses;
+        for (size_t i = 0; i < edges.size();)
+        {
+            size_t j = i + 1;
+            while ((j < edges.size()) && (edges[j] == edges[i]))
+            {
+                ++j;
+            }
+
+            const uint32_t vertex0 = static_cast<uint32_t>(edges[i] >> 32);
+            const uint32_t vertex1 = static_cast<uint32_t>(edges[i]);
+            if (j - i != 2)
+            {
+                state.isLocked[vertex0] = true;
+                state.isLocked[vertex1] = true;
+            }
+            i = j;
+        }
+        for (size_t i = 0; i < edges.size(); ++i)
+        {
+            Collapse collapse;
+            if (((i == 0) || (edges[i] != edges[i - 1]))
+                && EvaluateCollapse(state, static_cast<uint32_t>(edges[i] >> 32), static_cast<uint32_t>(edges[i]), collapse))
+            {
+                collapses.push(collapse);
+            }
+        }
+
+        const double maxSquaredError = static_cast<double>(maxError) * maxError;
+        const size_t minNumTriangles = static_cast<size_t>(std::ceil(minTriangleRatio * numLiveTriangles));
+        std::vector<uint32_t> neighbors, secondNeighbors;
+        while (!collapses.empty() && (numLiveTriangles > minNumTriangles))
+        {
+            const Collapse collapse = collapses.top();
+            collapses.pop();
+
+            // Collapses evaluated before one of their vertices changed are outdated
+            if (state.isVertexRemoved[collapse.keptVertex] || state.isVertexRemoved[collapse.removedVertex]
+                || (collapse.keptVersion != state.versions[collapse.keptVertex]) || (collapse.removedVersion != state.versions[collapse.removedVertex]))
+            {
+                continue;
+            }
+            if (collapse.error > maxSquaredError)
+            {
+                break;
+            }
+            if (!IsCollapseValid(state, collapse))
+            {
+                continue;
+            }
+
+            // Move the triangles of the removed vertex over to the kept one, and remove
+            // the triangles of the collapsed edge
+            positions[collapse.keptVertex] = collapse.position;
+            state.quadrics[collapse.keptVertex].Add(state.quadrics[collapse.removedVertex]);
+            std::vector<uint32_t>& keptTriangles = state.vertexTriangles[collapse.keptVertex];
+            for (uint32_t triangleIndex : state.vertexTriangles[collapse.removedVertex])
+            {
+                if (state.isTriangleRemoved[triangleIndex])
+                {
+                    continue;
+                }
+
+                uint32_t* triangle = &indices[triangleIndex * 3];
+                if ((triangle[0] == collapse.keptVertex) || (triangle[1] == collapse.keptVertex) || (triangle[2] == collapse.keptVertex))
+                {
+                    state.isTriangleRemoved[triangleIndex] = true;
+                    --numLiveTriangles;
+                    continue;
+                }
+
+                for (int j = 0; j < 3; ++j)
+                {
+                    if (triangle[j] == collapse.removedVertex)
+                    {
+                        triangle[j] = collapse.keptVertex;
+                    }
+                }
+                keptTriangles.push_back(triangleIndex);
+            }
+            keptTriangles.erase(std::remove_if(keptTriangles.begin(), keptTriangles.end(), [&state](uint32_t triangleIndex) { return state.isTriangleRemoved[triangleIndex]; }),
+                                keptTriangles.end());
+            std::vector<uint32_t>().swap(state.vertexTriangles[collapse.removedVertex]);
+            state.isVertexRemoved[collapse.removedVertex] = true;
+
+            // The costs of the edges of the kept vertex changed, and so did whether the edges
+            // around its neighbors can be collapsed, so evaluate all of them again
+            GetNeighbors(state, collapse.keptVertex, neighbors);
+            ++state.versions[collapse.keptVertex];
+            for (uint32_t neighbor : neighbors)
+            {
+                ++state.versions[neighbor];
+            }
+            for (uint32_t neighbor : neighbors)
+            {
+                Collapse newCollapse;
+                if (EvaluateCollapse(state, collapse.keptVertex, neighbor, newCollapse))
+                {
+                    collapses.push(newCollapse);
+                }
+
+                GetNeighbors(state, neighbor, secondNeighbors);
+                for (uint32_t secondNeighbor : secondNeighbors)
+                {
+                    // Edges between two neighbors are only evaluated once
+                    if ((secondNeighbor != collapse.keptVertex)
+                        && ((secondNeighbor > neighbor) || !std::binary_search(neighbors.begin(), neighbors.end(), secondNeighbor))
+                        && EvaluateCollapse(state, neighbor, secondNeighbor, newCollapse))
+                    {
+                        collapses.push(newCollapse);
+                    }
+                }
+            }
+        }
+
+        // Compact the vertices still in use, and the live triangles
+        const uint32_t unused = std::numeric_limits<uint32_t>::max();
+        std::vector<uint32_t> newIndices(numVertices, unused);
+        size_t numIndices = 0;
+        for (size_t i = 0; i < numTriangles; ++i)
+        {
+            if (!state.isTriangleRemoved[i])
+            {
+                for (int j = 0; j < 3; ++j)
+                {
+                    newIndices[indices[i * 3 + j]] = 0;
+                    indices[numIndices++] = indices[i * 3 + j];
+                }
+            }
+        }
+        indices.resize(numIndices);
+
+        if (outputVertexMap != nullptr)
+        {
+            outputVertexMap->clear();
+        }
+        uint32_t numNewVertices = 0;
+        for (size_t i = 0; i < numVertices; ++i)
+        {
+            if (newIndices[i] != unused)
+            {
+                newIndices[i] = numNewVertices;
+                positions[numNewVertices++] = positions[i];
+                if (outputVertexMap != nullptr)
+                {
+                    outputVertexMap->push_back(static_cast<uint32_t>(i));
+                }
+            }
+        }
+        positions.resize(numNewVertices);
+
+        for (size_t i = 0; i < indices.size(); ++i)
+        {
+            indices[i] = newIndices[indices[i]];
+        }
+
+        return numTriangles - indices.size() / 3;
+    }
+
+    /**
+     * @brief Evaluates the collapse of an edge
+     * @param[in] state Working state
+     * @param[in] vertex0 First edge vertex
+     * @param[in] vertex1 Second edge vertex
+     * @param[out] outputCollapse Collapse
+     * @return False if the edge cannot be collapsed
+     */
+    bool MeshDecimator::EvaluateCollapse(const State& state, uint32_t vertex0, uint32_t vertex1, Collapse& outputCollapse)
+    {
+        if (state.isLocked[vertex0] && state.isLocked[vertex1])
+        {
+            return false;
+        }
+
+        // A locked vertex stays where it is, so the other one collapses into it
+        if (state.isLocked[vertex1])
+        {
+            std::swap(vertex0, vertex1);
+        }
+
+        Quadric quadric = state.quadrics[vertex0];
+        quadric.Add(state.quadrics[vertex1]);
+
+        const glm::dvec3 position0 = state.positions[vertex0];
+        const glm::dvec3 position1 = state.positions[vertex1];
+        glm::dvec3 position = position0;
+        double error = quadric.GetError(position0);
+        if (!state.isLocked[vertex0])
+        {
+            // Only take the best point if it stays near the edge, otherwise nearly
+            // degenerate quadrics send the vertex far away
+            glm::dvec3 minimum;
+            if (quadric.GetMinimum(minimum) && (glm::distance(minimum, 0.5 * (position0 + position1)) <= glm::distance(position0, position1)))
+            {
+                position = minimum;
+                error = quadric.GetError(minimum);
+            }
+            else
+            {
+                const glm::dvec3 candidates[2] = {position1, 0.5 * (position0 + position1)};
+                for (int i = 0; i < 2; ++i)
+                {
+                    const double candidateError = quadric.GetError(candidates[i]);
+                    if (candidateError < error)
+                    {
+                        position = candidates[i];
+                        error = candidateError;
+                    }
+                }
+            }
+        }
+
+        outputCollapse.error = error;
+        outputCollapse.keptVertex = vertex0;
+        outputCollapse.removedVertex = vertex1;
+        outputCollapse.keptVersion = state.versions[vertex0];
+        outputCollapse.removedVersion = state.versions[vertex1];
+        outputCollapse.position = glm::vec3(position);
+        return true;
+    }
+
+    /**
+     * @brief Checks whether a collapse keeps the mesh manifold and no triangle flips
+     * @param[in] state Working state
+     * @param[in] collapse Collapse
+     * @return True if the collapse can be done
+     */
+    bool MeshDecimator::IsCollapseValid(const State& state, const Collapse& collapse)
+    {
+        // Link condition: the vertices around both edge vertices must be the ones
+        // of the triangles on the edge, otherwise the collapse pinches the surface
+        std::vector<uint32_t> keptNeighbors, removedNeighbors, commonNeighbors;
+        GetNeighbors(state, collapse.keptVertex, keptNeighbors);
+        GetNeighbors(state, collapse.removedVertex, removedNeighbors);
+        std::set_intersection(keptNeighbors.begin(), keptNeighbors.end(), removedNeighbors.begin(), removedNeighbors.end(), std::back_inserter(commonNeighbors));
+
+        size_t numEdgeTriangles = 0;
+        for (uint32_t triangleIndex : state.vertexTriangles[collapse.removedVertex])
+        {
+            const uint32_t* triangle = &state.indices[triangleIndex * 3];
+            if (!state.isTriangleRemoved[triangleIndex]
+                && ((triangle[0] == collapse.keptVertex) || (triangle[1] == collapse.keptVertex) || (triangle[2] == collapse.keptVertex)))
+            {
+                ++numEdgeTriangles;
+            }
+        }
+        if ((numEdgeTriangles == 0) || (commonNeighbors.size() != numEdgeTriangles))
+        {
+            return false;
+        }
+
+        // The remaining triangles around both vertices must not turn by more than 60 degrees,
+        // which also rejects flipped and newly degenerate triangles
+        const uint32_t vertices[2] = {collapse.keptVertex, collapse.removedVertex};
+        for (int i = 0; i < 2; ++i)
+        {
+            for (uint32_t triangleIndex : state.vertexTriangles[vertices[i]])
+            {
+                const uint32_t* triangle = &state.indices[triangleIndex * 3];
+                if (state.isTriangleRemoved[triangleIndex]
+                    || (triangle[0] == vertices[1 - i]) || (triangle[1] == vertices[1 - i]) || (triangle[2] == vertices[1 - i]))
+                {
+                    continue;
+                }
+
+                glm::vec3 before[3], after[3];
+                for (int j = 0; j < 3; ++j)
+                {
+                    before[j] = state.positions[triangle[j]];
+                    after[j] = (triangle[j] == vertices[i]) ? collapse.position : before[j];
+                }
+
+                const glm::vec3 normalBefore = glm::cross(before[1] - before[0], before[2] - before[0]);
+                const glm::vec3 normalAfter = glm::cross(after[1] - after[0], after[2] - after[0]);
+                const float lengthBefore = glm::length(normalBefore);
+                if ((lengthBefore > 0.0f) && (glm::dot(normalBefore, normalAfter) <= 0.5f * lengthBefore * glm::length(normalAfter)))
+                {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief Gathers the vertices sharing a live triangle with a vertex
+     * @param[in] state Working state
+     * @param[in] vertex Vertex
+     * @param[out] outputNeighbors Vector where the sorted neighbors will be placed
+     */
+    void MeshDecimator::GetNeighbors(const State& state, uint32_t vertex, std::vector<uint32_t>& outputNeighbors)
+    {
+        outputNeighbors.clear();
+        for (uint32_t triangleIndex : state.vertexTriangles[vertex])
+        {
+            if (state.isTriangleRemoved[triangleIndex])
+            {
+                continue;
+            }
+
+            const uint32_t* triangle = &state.indices[triangleIndex * 3];
+            for (int j = 0; j < 3; ++j)
+            {
+                if (triangle[j] != vertex)
+                {
+                    outputNeighbors.push_back(triangle[j]);
+                }
+            }
+        }
+        std::sort(outputNeighbors.begin(), outputNeighbors.end());
+        outputNeighbors.erase(std::unique(outputNeighbors.begin(), outputNeighbors.end()), outputNeighbors.end());
+    }
+}
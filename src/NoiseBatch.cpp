@@ -0,0 +1,739 @@
+#include "NoiseBatch.hpp"
+
+#include "FastNoiseLite/FastNoiseLite.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define MARCHING_CUBES_X86_SIMD 1
+#include <immintrin.h>
+#endif
+
+namespace MarchingCubes
+{
+    namespace
+    {
+        /**
+         * Order in which the layers are added when stopping early, and how far from the range of values
+         * whose side must be known they can still take the sum
+         */
+        struct LayerSchedule
+        {
+            /**
+             * Layers by decreasing amplitude
+             */
+            int order[maxBoundedNoiseLayers];
+
+            /**
+             * Center of the range of values
+             */
+            float rangeCenter;
+
+            /**
+             * Half the width of the range, plus the largest magnitude the layers after the k-th one in order can add
+             */
+            float remainingBounds[maxBoundedNoiseLayers];
+        };
+
+        /**
+         * @brief Gets the order and bounds used to stop adding layers early
+         * @param[in] layers Noise layers
+         * @param[in] numLayers Number of noise layers, at most maxBoundedNoiseLayers
+         * @param[in] minValue Lowest value of the range the results must be known to be above or below
+         * @param[in] maxValue Highest value of the range
+         * @param[out] outputSchedule Layer schedule
+         */
+        void GetLayerSchedule(const NoiseLayer* layers, int numLayers, float minValue, float maxValue, LayerSchedule& outputSchedule)
+        {
+            for (int k = 0; k < numLayers; ++k)
+            {
+                outputSchedule.order[k] = k;
+            }
+            std::stable_sort(outputSchedule.order, outputSchedule.order + numLayers, [&](int a, int b)
+            {
+                return std::fabs(layers[a].amplitude) > std::fabs(layers[b].amplitude);
+            });
+
+            outputSchedule.rangeCenter = (minValue + maxValue) * 0.5f;
+
+            float remainingBound = (maxValue - minValue) * 0.5f;
+            for (int k = numLayers - 1; k >= 0; --k)
+            {
+                outputSchedule.remainingBounds[k] = remainingBound;
+                remainingBound += std::fabs(layers[outputSchedule.order[k]].amplitude) * noiseMagnitudeBound;
+            }
+        }
+
+        /**
+         * Signature shared by all noise kernels. Without a schedule, every layer is added to every
+         * point and the flags are not written.
+         */
+        typedef void (*AddNoiseLayersFunc)(const NoiseLayer* layers, int numLayers, const LayerSchedule* schedule, const float* xs, const float* ys, const float* zs, float* values, unsigned char* outputIsSignOnly, size_t n);
+
+        /**
+         * @brief Scalar noise kernel, running the FastNoiseLite generators themselves
+         */
+        void AddNoiseLayersScalar(const NoiseLayer* layers, int numLayers, const LayerSchedule* schedule, const float* xs, const float* ys, const float* zs, float* values, unsigned char* outputIsSignOnly, size_t n)
+        {
+            std::vector<FastNoiseLite> noise(numLayers);
+            for (int layer = 0; layer < numLayers; ++layer)
+            {
+                noise[layer].SetSeed(layers[layer].seed);
+                noise[layer].SetNoiseType(FastNoiseLite::NoiseType_OpenSimplex2S);
+                noise[layer].SetFrequency(layers[layer].frequency);
+            }
+
+            if (schedule == nullptr)
+            {
+                for (int layer = 0; layer < numLayers; ++layer)
+                {
+                    const float scale = layers[layer].scale;
+                    const float amplitude = layers[layer].amplitude;
+                    for (size_t i = 0; i < n; ++i)
+                    {
+                        values[i] += noise[layer].GetNoise(xs[i] * scale, ys[i] * scale, zs[i] * scale) * amplitude;
+                    }
+                }
+                return;
+            }
+
+            for (size_t i = 0; i < n; ++i)
+            {
+                float layerValues[maxBoundedNoiseLayers];
+                float partialSum = values[i];
+                bool isSignOnly = false;
+                for (int k = 0; (k < numLayers) && !isSignOnly; ++k)
+                {
+                    const int layer = schedule->order[k];
+                    const float scale = layers[layer].scale;
+                    layerValues[layer] = noise[layer].GetNoise(xs[i] * scale, ys[i] * scale, zs[i] * scale) * layers[layer].amplitude;
+                    partialSum += layerValues[layer];
+                    isSignOnly = (k + 1 < numLayers) && (std::fabs(partialSum - schedule->rangeCenter) > schedule->remainingBounds[k]);
+                }
+
+                if (isSignOnly)
+                {
+                    values[i] = partialSum;
+                }
+                else
+                {
+                    // Summed in the original order, like without stopping early
+                    for (int layer = 0; layer < numLayers; ++layer)
+                    {
+                        values[i] += layerValues[layer];
+                    }
+                }
+                outputIsSignOnly[i] = isSignOnly ? 1 : 0;
+            }
+        }
+
+#ifdef MARCHING_CUBES_X86_SIMD
+        // Hashing constants of FastNoiseLite
+        const int primeX = 501125321;
+        const int primeY = 1136930381;
+        const int primeZ = 1720413743;
+        const int primeX2 = primeX * 2;
+        const int primeY2 = static_cast<int>(static_cast<unsigned int>(primeY) << 1);
+        const int primeZ2 = static_cast<int>(static_cast<unsigned int>(primeZ) << 1);
+        const int hashMultiplier = 0x27d4eb2d;
+        const int seedOffset = 1293373;
+
+        /**
+         * Signature shared by the vector kernels of a block of points, returning whether the block was stopped early
+         */
+        typedef bool (*AddNoiseLayersBlockFunc)(const NoiseLayer* layers, int numLayers, const LayerSchedule* schedule, const float* xs, const float* ys, const float* zs, float* values);
+
+        /**
+         * @brief Runs a vector kernel over all points, one block at a time
+         */
+        template <size_t blockSize, AddNoiseLayersBlockFunc addNoiseLayersBlock>
+        void AddNoiseLayersInBlocks(const NoiseLayer* layers, int numLayers, const LayerSchedule* schedule, const float* xs, const float* ys, const float* zs, float* values, unsigned char* outputIsSignOnly, size_t n)
+        {
+            size_t i = 0;
+            for (; i + blockSize <= n; i += blockSize)
+            {
+                const bool isSignOnly = addNoiseLayersBlock(layers, numLayers, schedule, xs + i, ys + i, zs + i, values + i);
+                if (schedule != nullptr)
+                {
+                    std::fill(outputIsSignOnly + i, outputIsSignOnly + i + blockSize, isSignOnly ? 1 : 0);
+                }
+            }
+
+            // The last points are padded with copies of the last one
+            if (i < n)
+            {
+                float blockXs[blockSize], blockYs[blockSize], blockZs[blockSize], blockValues[blockSize];
+                for (size_t j = 0; j < blockSize; ++j)
+                {
+                    const size_t point = std::min(i + j, n - 1);
+                    blockXs[j] = xs[point];
+                    blockYs[j] = ys[point];
+                    blockZs[j] = zs[point];
+                    blockValues[j] = values[point];
+                }
+                const bool isSignOnly = addNoiseLayersBlock(layers, numLayers, schedule, blockXs, blockYs, blockZs, blockValues);
+                std::copy(blockValues, blockValues + (n - i), values + i);
+                if (schedule != nullptr)
+                {
+                    std::fill(outputIsSignOnly + i, outputIsSignOnly + n, isSignOnly ? 1 : 0);
+                }
+            }
+        }
+
+        /**
+         * The 64 gradients of FastNoiseLite's Gradients3D table, one per int.
+         * Bits 0-1, 2-3 and 4-5 hold the x, y and z components plus 1.
+         */
+        const int gradientCodes[64] =
+        {
+            0x29, 0x21, 0x09, 0x01, 0x26, 0x24, 0x06, 0x04, 0x1A, 0x18, 0x12, 0x10, 0x29, 0x21, 0x09, 0x01,
+            0x26, 0x24, 0x06, 0x04, 0x1A, 0x18, 0x12, 0x10, 0x29, 0x21, 0x09, 0x01, 0x26, 0x24, 0x06, 0x04,
+            0x1A, 0x18, 0x12, 0x10, 0x29, 0x21, 0x09, 0x01, 0x26, 0x24, 0x06, 0x04, 0x1A, 0x18, 0x12, 0x10,
+            0x29, 0x21, 0x09, 0x01, 0x26, 0x24, 0x06, 0x04, 0x1A, 0x18, 0x12, 0x10, 0x1A, 0x21, 0x18, 0x01
+        };
+
+        /**
+         * @brief Gets the contribution of a lattice point to the noise, 4 points at a time
+         * @param[in] a Falloff of the lattice point, 0.75 minus the squared distance
+         * @param[in] seed Seed of the lattice point
+         * @param[in] xPrimed Hashed x-coordinate of the lattice point
+         * @param[in] yPrimed Hashed y-coordinate of the lattice point
+         * @param[in] zPrimed Hashed z-coordinate of the lattice point
+         * @param[in] dx X-offset from the lattice point
+         * @param[in] dy Y-offset from the lattice point
+         * @param[in] dz Z-offset from the lattice point
+         * @return a^4 times the gradient dot product
+         */
+        __attribute__((target("sse4.1")))
+        inline __m128 GetContributionSSE41(__m128 a, __m128i seed, __m128i xPrimed, __m128i yPrimed, __m128i zPrimed, __m128 dx, __m128 dy, __m128 dz)
+        {
+            __m128i hash = _mm_xor_si128(_mm_xor_si128(seed, xPrimed), _mm_xor_si128(yPrimed, zPrimed));
+            hash = _mm_mullo_epi32(hash, _mm_set1_epi32(hashMultiplier));
+            hash = _mm_xor_si128(hash, _mm_srai_epi32(hash, 15));
+
+            alignas(16) int gradientIndices[4];
+            _mm_store_si128(reinterpret_cast<__m128i*>(gradientIndices), _mm_and_si128(_mm_srli_epi32(hash, 2), _mm_set1_epi32(63)));
+            const __m128i code = _mm_setr_epi32(gradientCodes[gradientIndices[0]], gradientCodes[gradientIndices[1]], gradientCodes[gradientIndices[2]], gradientCodes[gradientIndices[3]]);
+
+            const __m128i one = _mm_set1_epi32(1);
+            const __m128i three = _mm_set1_epi32(3);
+            const __m128 gx = _mm_cvtepi32_ps(_mm_sub_epi32(_mm_and_si128(code, three), one));
+            const __m128 gy = _mm_cvtepi32_ps(_mm_sub_epi32(_mm_and_si128(_mm_srli_epi32(code, 2), three), one));
+            const __m128 gz = _mm_cvtepi32_ps(_mm_sub_epi32(_mm_and_si128(_mm_srli_epi32(code, 4), three), one));
+
+            const __m128 gradient = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, gx), _mm_mul_ps(dy, gy)), _mm_mul_ps(dz, gz));
+            const __m128 aa = _mm_mul_ps(a, a);
+            return _mm_mul_ps(_mm_mul_ps(aa, aa), gradient);
+        }
+
+        /**
+         * @brief Gets the OpenSimplex2S noise at 4 points, following FastNoiseLite's SingleOpenSimplex2S
+         * without branches: every lattice point that may contribute is evaluated, and masked out if it does not.
+         * @param[in] seed Seed of the generator
+         * @param[in] x X-values of the points, already rotated
+         * @param[in] y Y-values of the points, already rotated
+         * @param[in] z Z-values of the points, already rotated
+         * @return Noise values
+         */
+        __attribute__((target("sse4.1")))
+        inline __m128 GetOpenSimplex2SSSE41(int seed, __m128 x, __m128 y, __m128 z)
+        {
+            const __m128 zero = _mm_setzero_ps();
+
+            // FastFloor rounds towards negative infinity, except that negative integers go one lower
+            __m128i i = _mm_add_epi32(_mm_cvttps_epi32(x), _mm_castps_si128(_mm_cmplt_ps(x, zero)));
+            __m128i j = _mm_add_epi32(_mm_cvttps_epi32(y), _mm_castps_si128(_mm_cmplt_ps(y, zero)));
+            __m128i k = _mm_add_epi32(_mm_cvttps_epi32(z), _mm_castps_si128(_mm_cmplt_ps(z, zero)));
+            const __m128 xi = _mm_sub_ps(x, _mm_cvtepi32_ps(i));
+            const __m128 yi = _mm_sub_ps(y, _mm_cvtepi32_ps(j));
+            const __m128 zi = _mm_sub_ps(z, _mm_cvtepi32_ps(k));
+
+            i = _mm_mullo_epi32(i, _mm_set1_epi32(primeX));
+            j = _mm_mullo_epi32(j, _mm_set1_epi32(primeY));
+            k = _mm_mullo_epi32(k, _mm_set1_epi32(primeZ));
+            const __m128i seed1 = _mm_set1_epi32(seed);
+            const __m128i seed2 = _mm_set1_epi32(seed + seedOffset);
+
+            const __m128 minusHalf = _mm_set1_ps(-0.5f);
+            const __m128i xNMask = _mm_cvttps_epi32(_mm_sub_ps(minusHalf, xi));
+            const __m128i yNMask = _mm_cvttps_epi32(_mm_sub_ps(minusHalf, yi));
+            const __m128i zNMask = _mm_cvttps_epi32(_mm_sub_ps(minusHalf, zi));
+
+            // Sign of each axis towards the second lattice point, and the matching hashed offsets
+            const __m128i oneInt = _mm_set1_epi32(1);
+            const __m128 xSign = _mm_cvtepi32_ps(_mm_or_si128(xNMask, oneInt));
+            const __m128 ySign = _mm_cvtepi32_ps(_mm_or_si128(yNMask, oneInt));
+            const __m128 zSign = _mm_cvtepi32_ps(_mm_or_si128(zNMask, oneInt));
+            const __m128i xNPrime = _mm_and_si128(xNMask, _mm_set1_epi32(primeX));
+            const __m128i yNPrime = _mm_and_si128(yNMask, _mm_set1_epi32(primeY));
+            const __m128i zNPrime = _mm_and_si128(zNMask, _mm_set1_epi32(primeZ));
+            const __m128i xPPrime = _mm_andnot_si128(xNMask, _mm_set1_epi32(primeX));
+            const __m128i yPPrime = _mm_andnot_si128(yNMask, _mm_set1_epi32(primeY));
+            const __m128i zPPrime = _mm_andnot_si128(zNMask, _mm_set1_epi32(primeZ));
+            const __m128i xNPrime2 = _mm_and_si128(xNMask, _mm_set1_epi32(primeX2));
+            const __m128i yNPrime2 = _mm_and_si128(yNMask, _mm_set1_epi32(primeY2));
+            const __m128i zNPrime2 = _mm_and_si128(zNMask, _mm_set1_epi32(primeZ2));
+            const __m128i i1 = _mm_add_epi32(i, _mm_set1_epi32(primeX));
+            const __m128i j1 = _mm_add_epi32(j, _mm_set1_epi32(primeY));
+            const __m128i k1 = _mm_add_epi32(k, _mm_set1_epi32(primeZ));
+
+            const __m128 threeQuarters = _mm_set1_ps(0.75f);
+            const __m128 x0 = _mm_add_ps(xi, _mm_cvtepi32_ps(xNMask));
+            const __m128 y0 = _mm_add_ps(yi, _mm_cvtepi32_ps(yNMask));
+            const __m128 z0 = _mm_add_ps(zi, _mm_cvtepi32_ps(zNMask));
+            const __m128 a0 = _mm_sub_ps(_mm_sub_ps(_mm_sub_ps(threeQuarters, _mm_mul_ps(x0, x0)), _mm_mul_ps(y0, y0)), _mm_mul_ps(z0, z0));
+            __m128 value = GetContributionSSE41(a0, seed1, _mm_add_epi32(i, xNPrime), _mm_add_epi32(j, yNPrime), _mm_add_epi32(k, zNPrime), x0, y0, z0);
+
+            const __m128 half = _mm_set1_ps(0.5f);
+            const __m128 x1 = _mm_sub_ps(xi, half);
+            const __m128 y1 = _mm_sub_ps(yi, half);
+            const __m128 z1 = _mm_sub_ps(zi, half);
+            const __m128 a1 = _mm_sub_ps(_mm_sub_ps(_mm_sub_ps(threeQuarters, _mm_mul_ps(x1, x1)), _mm_mul_ps(y1, y1)), _mm_mul_ps(z1, z1));
+            value = _mm_add_ps(value, GetContributionSSE41(a1, seed2, i1, j1, k1, x1, y1, z1));
+
+            const __m128 two = _mm_set1_ps(2.0f);
+            const __m128 one = _mm_set1_ps(1.0f);
+            const __m128 xAFlipMask0 = _mm_mul_ps(_mm_mul_ps(xSign, two), x1);
+            const __m128 yAFlipMask0 = _mm_mul_ps(_mm_mul_ps(ySign, two), y1);
+            const __m128 zAFlipMask0 = _mm_mul_ps(_mm_mul_ps(zSign, two), z1);
+            const __m128 xAFlipMask1 = _mm_sub_ps(_mm_mul_ps(_mm_mul_ps(xSign, _mm_set1_ps(-2.0f)), x1), one);
+            const __m128 yAFlipMask1 = _mm_sub_ps(_mm_mul_ps(_mm_mul_ps(ySign, _mm_set1_ps(-2.0f)), y1), one);
+            const __m128 zAFlipMask1 = _mm_sub_ps(_mm_mul_ps(_mm_mul_ps(zSign, _mm_set1_ps(-2.0f)), z1), one);
+
+            // Same lattice points and order as the branches of SingleOpenSimplex2S
+            const __m128 a2 = _mm_add_ps(xAFlipMask0, a0);
+            const __m128 use2 = _mm_cmpgt_ps(a2, zero);
+            value = _mm_add_ps(value, _mm_and_ps(use2, GetContributionSSE41(a2, seed1, _mm_add_epi32(i, xPPrime), _mm_add_epi32(j, yNPrime), _mm_add_epi32(k, zNPrime), _mm_sub_ps(x0, xSign), y0, z0)));
+
+            const __m128 a3 = _mm_add_ps(_mm_add_ps(yAFlipMask0, zAFlipMask0), a0);
+            const __m128 use3 = _mm_andnot_ps(use2, _mm_cmpgt_ps(a3, zero));
+            value = _mm_add_ps(value, _mm_and_ps(use3, GetContributionSSE41(a3, seed1, _mm_add_epi32(i, xNPrime), _mm_add_epi32(j, yPPrime), _mm_add_epi32(k, zPPrime), x0, _mm_sub_ps(y0, ySign), _mm_sub_ps(z0, zSign))));
+
+            const __m128 a4 = _mm_add_ps(xAFlipMask1, a1);
+            const __m128 use4 = _mm_andnot_ps(use2, _mm_cmpgt_ps(a4, zero));
+            value = _mm_add_ps(value, _mm_and_ps(use4, GetContributionSSE41(a4, seed2, _mm_add_epi32(i, xNPrime2), j1, k1, _mm_add_ps(xSign, x1), y1, z1)));
+
+            const __m128 a6 = _mm_add_ps(yAFlipMask0, a0);
+            const __m128 use6 = _mm_cmpgt_ps(a6, zero);
+            value = _mm_add_ps(value, _mm_and_ps(use6, GetContributionSSE41(a6, seed1, _mm_add_epi32(i, xNPrime), _mm_add_epi32(j, yPPrime), _mm_add_epi32(k, zNPrime), x0, _mm_sub_ps(y0, ySign), z0)));
+
+            const __m128 a7 = _mm_add_ps(_mm_add_ps(xAFlipMask0, zAFlipMask0), a0);
+            const __m128 use7 = _mm_andnot_ps(use6, _mm_cmpgt_ps(a7, zero));
+            value = _mm_add_ps(value, _mm_and_ps(use7, GetContributionSSE41(a7, seed1, _mm_add_epi32(i, xPPrime), _mm_add_epi32(j, yNPrime), _mm_add_epi32(k, zPPrime), _mm_sub_ps(x0, xSign), y0, _mm_sub_ps(z0, zSign))));
+
+            const __m128 a8 = _mm_add_ps(yAFlipMask1, a1);
+            const __m128 use8 = _mm_andnot_ps(use6, _mm_cmpgt_ps(a8, zero));
+            value = _mm_add_ps(value, _mm_and_ps(use8, GetContributionSSE41(a8, seed2, i1, _mm_add_epi32(j, yNPrime2), k1, x1, _mm_add_ps(ySign, y1), z1)));
+
+            const __m128 aA = _mm_add_ps(zAFlipMask0, a0);
+            const __m128 useA = _mm_cmpgt_ps(aA, zero);
+            value = _mm_add_ps(value, _mm_and_ps(useA, GetContributionSSE41(aA, seed1, _mm_add_epi32(i, xNPrime), _mm_add_epi32(j, yNPrime), _mm_add_epi32(k, zPPrime), x0, y0, _mm_sub_ps(z0, zSign))));
+
+            const __m128 aB = _mm_add_ps(_mm_add_ps(xAFlipMask0, yAFlipMask0), a0);
+            const __m128 useB = _mm_andnot_ps(useA, _mm_cmpgt_ps(aB, zero));
+            value = _mm_add_ps(value, _mm_and_ps(useB, GetContributionSSE41(aB, seed1, _mm_add_epi32(i, xPPrime), _mm_add_epi32(j, yPPrime), _mm_add_epi32(k, zNPrime), _mm_sub_ps(x0, xSign), _mm_sub_ps(y0, ySign), z0)));
+
+            const __m128 aC = _mm_add_ps(zAFlipMask1, a1);
+            const __m128 useC = _mm_andnot_ps(useA, _mm_cmpgt_ps(aC, zero));
+            value = _mm_add_ps(value, _mm_and_ps(useC, GetContributionSSE41(aC, seed2, i1, j1, _mm_add_epi32(k, zNPrime2), x1, y1, _mm_add_ps(zSign, z1))));
+
+            const __m128 a5 = _mm_add_ps(_mm_add_ps(yAFlipMask1, zAFlipMask1), a1);
+            const __m128 use5 = _mm_andnot_ps(use4, _mm_cmpgt_ps(a5, zero));
+            value = _mm_add_ps(value, _mm_and_ps(use5, GetContributionSSE41(a5, seed2, i1, _mm_add_epi32(j, yNPrime2), _mm_add_epi32(k, zNPrime2), x1, _mm_add_ps(ySign, y1), _mm_add_ps(zSign, z1))));
+
+            const __m128 a9 = _mm_add_ps(_mm_add_ps(xAFlipMask1, zAFlipMask1), a1);
+            const __m128 use9 = _mm_andnot_ps(use8, _mm_cmpgt_ps(a9, zero));
+            value = _mm_add_ps(value, _mm_and_ps(use9, GetContributionSSE41(a9, seed2, _mm_add_epi32(i, xNPrime2), j1, _mm_add_epi32(k, zNPrime2), _mm_add_ps(xSign, x1), y1, _mm_add_ps(zSign, z1))));
+
+            const __m128 aD = _mm_add_ps(_mm_add_ps(xAFlipMask1, yAFlipMask1), a1);
+            const __m128 useD = _mm_andnot_ps(useC, _mm_cmpgt_ps(aD, zero));
+            value = _mm_add_ps(value, _mm_and_ps(useD, GetContributionSSE41(aD, seed2, _mm_add_epi32(i, xNPrime2), _mm_add_epi32(j, yNPrime2), k1, _mm_add_ps(xSign, x1), _mm_add_ps(ySign, y1), z1)));
+
+            return _mm_mul_ps(value, _mm_set1_ps(9.046026385208288f));
+        }
+
+        /**
+         * @brief Gets a noise layer times its amplitude at 4 points
+         */
+        __attribute__((target("sse4.1")))
+        __m128 GetNoiseLayerSSE41(const NoiseLayer& layer, __m128 x, __m128 y, __m128 z)
+        {
+            // Scaled, then FastNoiseLite's frequency and OpenSimplex2 rotation
+            const __m128 scale = _mm_set1_ps(layer.scale);
+            const __m128 frequency = _mm_set1_ps(layer.frequency);
+            const __m128 xf = _mm_mul_ps(_mm_mul_ps(x, scale), frequency);
+            const __m128 yf = _mm_mul_ps(_mm_mul_ps(y, scale), frequency);
+            const __m128 zf = _mm_mul_ps(_mm_mul_ps(z, scale), frequency);
+            const __m128 r = _mm_mul_ps(_mm_add_ps(_mm_add_ps(xf, yf), zf), _mm_set1_ps(2.0f / 3.0f));
+
+            const __m128 noise = GetOpenSimplex2SSSE41(layer.seed, _mm_sub_ps(r, xf), _mm_sub_ps(r, yf), _mm_sub_ps(r, zf));
+            return _mm_mul_ps(noise, _mm_set1_ps(layer.amplitude));
+        }
+
+        /**
+         * @brief Adds the noise layers to 4 values, stopping early if a schedule is given
+         * and all of them are further from its range than the remaining layers can reach
+         */
+        __attribute__((target("sse4.1")))
+        bool AddNoiseLayersSSE41Block(const NoiseLayer* layers, int numLayers, const LayerSchedule* schedule, const float* xs, const float* ys, const float* zs, float* values)
+        {
+            const __m128 x = _mm_loadu_ps(xs);
+            const __m128 y = _mm_loadu_ps(ys);
+            const __m128 z = _mm_loadu_ps(zs);
+            const __m128 initialValues = _mm_loadu_ps(values);
+            if (schedule == nullptr)
+            {
+                __m128 sum = initialValues;
+                for (int layer = 0; layer < numLayers; ++layer)
+                {
+                    sum = _mm_add_ps(sum, GetNoiseLayerSSE41(layers[layer], x, y, z));
+                }
+                _mm_storeu_ps(values, sum);
+                return false;
+            }
+
+            const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+            const __m128 rangeCenter = _mm_set1_ps(schedule->rangeCenter);
+            __m128 layerValues[maxBoundedNoiseLayers];
+            __m128 partialSum = initialValues;
+            for (int k = 0; k < numLayers; ++k)
+            {
+                const int layer = schedule->order[k];
+                layerValues[layer] = GetNoiseLayerSSE41(layers[layer], x, y, z);
+                partialSum = _mm_add_ps(partialSum, layerValues[layer]);
+                if (k + 1 < numLayers)
+                {
+                    const __m128 threshold = _mm_set1_ps(schedule->remainingBounds[k]);
+                    if (_mm_movemask_ps(_mm_cmpgt_ps(_mm_and_ps(_mm_sub_ps(partialSum, rangeCenter), absMask), threshold)) == 0xF)
+                    {
+                        _mm_storeu_ps(values, partialSum);
+                        return true;
+                    }
+                }
+            }
+
+            // Summed in the original order, like without a schedule
+            __m128 sum = initialValues;
+            for (int layer = 0; layer < numLayers; ++layer)
+            {
+                sum = _mm_add_ps(sum, layerValues[layer]);
+            }
+            _mm_storeu_ps(values, sum);
+            return false;
+        }
+
+        /**
+         * @brief Gets the contribution of a lattice point to the noise, 8 points at a time
+         * @param[in] a Falloff of the lattice point, 0.75 minus the squared distance
+         * @param[in] seed Seed of the lattice point
+         * @param[in] xPrimed Hashed x-coordinate of the lattice point
+         * @param[in] yPrimed Hashed y-coordinate of the lattice point
+         * @param[in] zPrimed Hashed z-coordinate of the lattice point
+         * @param[in] dx X-offset from the lattice point
+         * @param[in] dy Y-offset from the lattice point
+         * @param[in] dz Z-offset from the lattice point
+         * @return a^4 times the gradient dot product
+         */
+        __attribute__((target("avx2")))
+        inline __m256 GetContributionAVX2(__m256 a, __m256i seed, __m256i xPrimed, __m256i yPrimed, __m256i zPrimed, __m256 dx, __m256 dy, __m256 dz)
+        {
+            __m256i hash = _mm256_xor_si256(_mm256_xor_si256(seed, xPrimed), _mm256_xor_si256(yPrimed, zPrimed));
+            hash = _mm256_mullo_epi32(hash, _mm256_set1_epi32(hashMultiplier));
+            hash = _mm256_xor_si256(hash, _mm256_srai_epi32(hash, 15));
+            const __m256i code = _mm256_i32gather_epi32(gradientCodes, _mm256_and_si256(_mm256_srli_epi32(hash, 2), _mm256_set1_epi32(63)), 4);
+
+            const __m256i one = _mm256_set1_epi32(1);
+            const __m256i three = _mm256_set1_epi32(3);
+            const __m256 gx = _mm256_cvtepi32_ps(_mm256_sub_epi32(_mm256_and_si256(code, three), one));
+            const __m256 gy = _mm256_cvtepi32_ps(_mm256_sub_epi32(_mm256_and_si256(_mm256_srli_epi32(code, 2), three), one));
+            const __m256 gz = _mm256_cvtepi32_ps(_mm256_sub_epi32(_mm256_and_si256(_mm256_srli_epi32(code, 4), three), one));
+
+            const __m256 gradient = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(dx, gx), _mm256_mul_ps(dy, gy)), _mm256_mul_ps(dz, gz));
+            const __m256 aa = _mm256_mul_ps(a, a);
+            return _mm256_mul_ps(_mm256_mul_ps(aa, aa), gradient);
+        }
+
+        /**
+         * @brief Gets the OpenSimplex2S noise at 8 points, following FastNoiseLite's SingleOpenSimplex2S
+         * without branches: every lattice point that may contribute is evaluated, and masked out if it does not.
+         * @param[in] seed Seed of the generator
+         * @param[in] x X-values of the points, already rotated
+         * @param[in] y Y-values of the points, already rotated
+         * @param[in] z Z-values of the points, already rotated
+         * @return Noise values
+         */
+        __attribute__((target("avx2")))
+        inline __m256 GetOpenSimplex2SAVX2(int seed, __m256 x, __m256 y, __m256 z)
+        {
+            const __m256 zero = _mm256_setzero_ps();
+
+            // FastFloor rounds towards negative infinity, except that negative integers go one lower
+            __m256i i = _mm256_add_epi32(_mm256_cvttps_epi32(x), _mm256_castps_si256(_mm256_cmp_ps(x, zero, _CMP_LT_OQ)));
+            __m256i j = _mm256_add_epi32(_mm256_cvttps_epi32(y), _mm256_castps_si256(_mm256_cmp_ps(y, zero, _CMP_LT_OQ)));
+            __m256i k = _mm256_add_epi32(_mm256_cvttps_epi32(z), _mm256_castps_si256(_mm256_cmp_ps(z, zero, _CMP_LT_OQ)));
+            const __m256 xi = _mm256_sub_ps(x, _mm256_cvtepi32_ps(i));
+            const __m256 yi = _mm256_sub_ps(y, _mm256_cvtepi32_ps(j));
+            const __m256 zi = _mm256_sub_ps(z, _mm256_cvtepi32_ps(k));
+
+            i = _mm256_mullo_epi32(i, _mm256_set1_epi32(primeX));
+            j = _mm256_mullo_epi32(j, _mm256_set1_epi32(primeY));
+            k = _mm256_mullo_epi32(k, _mm256_set1_epi32(primeZ));
+            const __m256i seed1 = _mm256_set1_epi32(seed);
+            const __m256i seed2 = _mm256_set1_epi32(seed + seedOffset);
+
+            const __m256 minusHalf = _mm256_set1_ps(-0.5f);
+            const __m256i xNMask = _mm256_cvttps_epi32(_mm256_sub_ps(minusHalf, xi));
+            const __m256i yNMask = _mm256_cvttps_epi32(_mm256_sub_ps(minusHalf, yi));
+            const __m256i zNMask = _mm256_cvttps_epi32(_mm256_sub_ps(minusHalf, zi));
+
+            // Sign of each axis towards the second lattice point, and the matching hashed offsets
+            const __m256i oneInt = _mm256_set1_epi32(1);
+            const __m256 xSign = _mm256_cvtepi32_ps(_mm256_or_si256(xNMask, oneInt));
+            const __m256 ySign = _mm256_cvtepi32_ps(_mm256_or_si256(yNMask, oneInt));
+            const __m256 zSign = _mm256_cvtepi32_ps(_mm256_or_si256(zNMask, oneInt));
+            const __m256i xNPrime = _mm256_and_si256(xNMask, _mm256_set1_epi32(primeX));
+            const __m256i yNPrime = _mm256_and_si256(yNMask, _mm256_set1_epi32(primeY));
+            const __m256i zNPrime = _mm256_and_si256(zNMask, _mm256_set1_epi32(primeZ));
+            const __m256i xPPrime = _mm256_andnot_si256(xNMask, _mm256_set1_epi32(primeX));
+            const __m256i yPPrime = _mm256_andnot_si256(yNMask, _mm256_set1_epi32(primeY));
+            const __m256i zPPrime = _mm256_andnot_si256(zNMask, _mm256_set1_epi32(primeZ));
+            const __m256i xNPrime2 = _mm256_and_si256(xNMask, _mm256_set1_epi32(primeX2));
+            const __m256i yNPrime2 = _mm256_and_si256(yNMask, _mm256_set1_epi32(primeY2));
+            const __m256i zNPrime2 = _mm256_and_si256(zNMask, _mm256_set1_epi32(primeZ2));
+            const __m256i i1 = _mm256_add_epi32(i, _mm256_set1_epi32(primeX));
+            const __m256i j1 = _mm256_add_epi32(j, _mm256_set1_epi32(primeY));
+            const __m256i k1 = _mm256_add_epi32(k, _mm256_set1_epi32(primeZ));
+
+            const __m256 threeQuarters = _mm256_set1_ps(0.75f);
+            const __m256 x0 = _mm256_add_ps(xi, _mm256_cvtepi32_ps(xNMask));
+            const __m256 y0 = _mm256_add_ps(yi, _mm256_cvtepi32_ps(yNMask));
+            const __m256 z0 = _mm256_add_ps(zi, _mm256_cvtepi32_ps(zNMask));
+            const __m256 a0 = _mm256_sub_ps(_mm256_sub_ps(_mm256_sub_ps(threeQuarters, _mm256_mul_ps(x0, x0)), _mm256_mul_ps(y0, y0)), _mm256_mul_ps(z0, z0));
+            __m256 value = GetContributionAVX2(a0, seed1, _mm256_add_epi32(i, xNPrime), _mm256_add_epi32(j, yNPrime), _mm256_add_epi32(k, zNPrime), x0, y0, z0);
+
+            const __m256 half = _mm256_set1_ps(0.5f);
+            const __m256 x1 = _mm256_sub_ps(xi, half);
+            const __m256 y1 = _mm256_sub_ps(yi, half);
+            const __m256 z1 = _mm256_sub_ps(zi, half);
+            const __m256 a1 = _mm256_sub_ps(_mm256_sub_ps(_mm256_sub_ps(threeQuarters, _mm256_mul_ps(x1, x1)), _mm256_mul_ps(y1, y1)), _mm256_mul_ps(z1, z1));
+            value = _mm256_add_ps(value, GetContributionAVX2(a1, seed2, i1, j1, k1, x1, y1, z1));
+
+            const __m256 two = _mm256_set1_ps(2.0f);
+            const __m256 one = _mm256_set1_ps(1.0f);
+            const __m256 xAFlipMask0 = _mm256_mul_ps(_mm256_mul_ps(xSign, two), x1);
+            const __m256 yAFlipMask0 = _mm256_mul_ps(_mm256_mul_ps(ySign, two), y1);
+            const __m256 zAFlipMask0 = _mm256_mul_ps(_mm256_mul_ps(zSign, two), z1);
+            const __m256 xAFlipMask1 = _mm256_sub_ps(_mm256_mul_ps(_mm256_mul_ps(xSign, _mm256_set1_ps(-2.0f)), x1), one);
+            const __m256 yAFlipMask1 = _mm256_sub_ps(_mm256_mul_ps(_mm256_mul_ps(ySign, _mm256_set1_ps(-2.0f)), y1), one);
+            const __m256 zAFlipMask1 = _mm256_sub_ps(_mm256_mul_ps(_mm256_mul_ps(zSign, _mm256_set1_ps(-2.0f)), z1), one);
+
+            // Same lattice points and order as the branches of SingleOpenSimplex2S
+            const __m256 a2 = _mm256_add_ps(xAFlipMask0, a0);
+            const __m256 use2 = _mm256_cmp_ps(a2, zero, _CMP_GT_OQ);
+            value = _mm256_add_ps(value, _mm256_and_ps(use2, GetContributionAVX2(a2, seed1, _mm256_add_epi32(i, xPPrime), _mm256_add_epi32(j, yNPrime), _mm256_add_epi32(k, zNPrime), _mm256_sub_ps(x0, xSign), y0, z0)));
+
+            const __m256 a3 = _mm256_add_ps(_mm256_add_ps(yAFlipMask0, zAFlipMask0), a0);
+            const __m256 use3 = _mm256_andnot_ps(use2, _mm256_cmp_ps(a3, zero, _CMP_GT_OQ));
+            value = _mm256_add_ps(value, _mm256_and_ps(use3, GetContributionAVX2(a3, seed1, _mm256_add_epi32(i, xNPrime), _mm256_add_epi32(j, yPPrime), _mm256_add_epi32(k, zPPrime), x0, _mm256_sub_ps(y0, ySign), _mm256_sub_ps(z0, zSign))));
+
+            const __m256 a4 = _mm256_add_ps(xAFlipMask1, a1);
+            const __m256 use4 = _mm256_andnot_ps(use2, _mm256_cmp_ps(a4, zero, _CMP_GT_OQ));
+            value = _mm256_add_ps(value, _mm256_and_ps(use4, GetContributionAVX2(a4, seed2, _mm256_add_epi32(i, xNPrime2), j1, k1, _mm256_add_ps(xSign, x1), y1, z1)));
+
+            const __m256 a6 = _mm256_add_ps(yAFlipMask0, a0);
+            const __m256 use6 = _mm256_cmp_ps(a6, zero, _CMP_GT_OQ);
+            value = _mm256_add_ps(value, _mm256_and_ps(use6, GetContributionAVX2(a6, seed1, _mm256_add_epi32(i, xNPrime), _mm256_add_epi32(j, yPPrime), _mm256_add_epi32(k, zNPrime), x0, _mm256_sub_ps(y0, ySign), z0)));
+
+            const __m256 a7 = _mm256_add_ps(_mm256_add_ps(xAFlipMask0, zAFlipMask0), a0);
+            const __m256 use7 = _mm256_andnot_ps(use6, _mm256_cmp_ps(a7, zero, _CMP_GT_OQ));
+            value = _mm256_add_ps(value, _mm256_and_ps(use7, GetContributionAVX2(a7, seed1, _mm256_add_epi32(i, xPPrime), _mm256_add_epi32(j, yNPrime), _mm256_add_epi32(k, zPPrime), _mm256_sub_ps(x0, xSign), y0, _mm256_sub_ps(z0, zSign))));
+
+            const __m256 a8 = _mm256_add_ps(yAFlipMask1, a1);
+            const __m256 use8 = _mm256_andnot_ps(use6, _mm256_cmp_ps(a8, zero, _CMP_GT_OQ));
+            value = _mm256_add_ps(value, _mm256_and_ps(use8, GetContributionAVX2(a8, seed2, i1, _mm256_add_epi32(j, yNPrime2), k1, x1, _mm256_add_ps(ySign, y1), z1)));
+
+            const __m256 aA = _mm256_add_ps(zAFlipMask0, a0);
+            const __m256 useA = _mm256_cmp_ps(aA, zero, _CMP_GT_OQ);
+            value = _mm256_add_ps(value, _mm256_and_ps(useA, GetContributionAVX2(aA, seed1, _mm256_add_epi32(i, xNPrime), _mm256_add_epi32(j, yNPrime), _mm256_add_epi32(k, zPPrime), x0, y0, _mm256_sub_ps(z0, zSign))));
+
+            const __m256 aB = _mm256_add_ps(_mm256_add_ps(xAFlipMask0, yAFlipMask0), a0);
+            const __m256 useB = _mm256_andnot_ps(useA, _mm256_cmp_ps(aB, zero, _CMP_GT_OQ));
+            value = _mm256_add_ps(value, _mm256_and_ps(useB, GetContributionAVX2(aB, seed1, _mm256_add_epi32(i, xPPrime), _mm256_add_epi32(j, yPPrime), _mm256_add_epi32(k, zNPrime), _mm256_sub_ps(x0, xSign), _mm256_sub_ps(y0, ySign), z0)));
+
+            const __m256 aC = _mm256_add_ps(zAFlipMask1, a1);
+            const __m256 useC = _mm256_andnot_ps(useA, _mm256_cmp_ps(aC, zero, _CMP_GT_OQ));
+            value = _mm256_add_ps(value, _mm256_and_ps(useC, GetContributionAVX2(aC, seed2, i1, j1, _mm256_add_epi32(k, zNPrime2), x1, y1, _mm256_add_ps(zSign, z1))));
+
+            const __m256 a5 = _mm256_add_ps(_mm256_add_ps(yAFlipMask1, zAFlipMask1), a1);
+            const __m256 use5 = _mm256_andnot_ps(use4, _mm256_cmp_ps(a5, zero, _CMP_GT_OQ));
+            value = _mm256_add_ps(value, _mm256_and_ps(use5, GetContributionAVX2(a5, seed2, i1, _mm256_add_epi32(j, yNPrime2), _mm256_add_epi32(k, zNPrime2), x1, _mm256_add_ps(ySign, y1), _mm256_add_ps(zSign, z1))));
+
+            const __m256 a9 = _mm256_add_ps(_mm256_add_ps(xAFlipMask1, zAFlipMask1), a1);
+            const __m256 use9 = _mm256_andnot_ps(use8, _mm256_cmp_ps(a9, zero, _CMP_GT_OQ));
+            value = _mm256_add_ps(value, _mm256_and_ps(use9, GetContributionAVX2(a9, seed2, _mm256_add_epi32(i, xNPrime2), j1, _mm256_add_epi32(k, zNPrime2), _mm256_add_ps(xSign, x1), y1, _mm256_add_ps(zSign, z1))));
+
+            const __m256 aD = _mm256_add_ps(_mm256_add_ps(xAFlipMask1, yAFlipMask1), a1);
+            const __m256 useD = _mm256_andnot_ps(useC, _mm256_cmp_ps(aD, zero, _CMP_GT_OQ));
+            value = _mm256_add_ps(value, _mm256_and_ps(useD, GetContributionAVX2(aD, seed2, _mm256_add_epi32(i, xNPrime2), _mm256_add_epi32(j, yNPrime2), k1, _mm256_add_ps(xSign, x1), _mm256_add_ps(ySign, y1), z1)));
+
+            return _mm256_mul_ps(value, _mm256_set1_ps(9.046026385208288f));
+        }
+
+        /**
+         * @brief Gets a noise layer times its amplitude at 8 points
+         */
+        __attribute__((target("avx2")))
+        __m256 GetNoiseLayerAVX2(const NoiseLayer& layer, __m256 x, __m256 y, __m256 z)
+        {
+            // Scaled, then FastNoiseLite's frequency and OpenSimplex2 rotation
+            const __m256 scale = _mm256_set1_ps(layer.scale);
+            const __m256 frequency = _mm256_set1_ps(layer.frequency);
+            const __m256 xf = _mm256_mul_ps(_mm256_mul_ps(x, scale), frequency);
+            const __m256 yf = _mm256_mul_ps(_mm256_mul_ps(y, scale), frequency);
+            const __m256 zf = _mm256_mul_ps(_mm256_mul_ps(z, scale), frequency);
+            const __m256 r = _mm256_mul_ps(_mm256_add_ps(_mm256_add_ps(xf, yf), zf), _mm256_set1_ps(2.0f / 3.0f));
+
+            const __m256 noise = GetOpenSimplex2SAVX2(layer.seed, _mm256_sub_ps(r, xf), _mm256_sub_ps(r, yf), _mm256_sub_ps(r, zf));
+            return _mm256_mul_ps(noise, _mm256_set1_ps(layer.amplitude));
+        }
+
+        /**
+         * @brief Adds the noise layers to 8 values, stopping early if a schedule is given
+         * and all of them are further from its range than the remaining layers can reach
+         */
+        __attribute__((target("avx2")))
+        bool AddNoiseLayersAVX2Block(const NoiseLayer* layers, int numLayers, const LayerSchedule* schedule, const float* xs, const float* ys, const float* zs, float* values)
+        {
+            const __m256 x = _mm256_loadu_ps(xs);
+            const __m256 y = _mm256_loadu_ps(ys);
+            const __m256 z = _mm256_loadu_ps(zs);
+            const __m256 initialValues = _mm256_loadu_ps(values);
+            if (schedule == nullptr)
+            {
+                __m256 sum = initialValues;
+                for (int layer = 0; layer < numLayers; ++layer)
+                {
+                    sum = _mm256_add_ps(sum, GetNoiseLayerAVX2(layers[layer], x, y, z));
+                }
+                _mm256_storeu_ps(values, sum);
+                return false;
+            }
+
+            const __m256 absMask = _mm256_castsi256_ps(_mm256_set1_epi32(0x7FFFFFFF));
+            const __m256 rangeCenter = _mm256_set1_ps(schedule->rangeCenter);
+            __m256 layerValues[maxBoundedNoiseLayers];
+            __m256 partialSum = initialValues;
+            for (int k = 0; k < numLayers; ++k)
+            {
+                const int layer = schedule->order[k];
+                layerValues[layer] = GetNoiseLayerAVX2(layers[layer], x, y, z);
+                partialSum = _mm256_add_ps(partialSum, layerValues[layer]);
+                if (k + 1 < numLayers)
+                {
+                    const __m256 threshold = _mm256_set1_ps(schedule->remainingBounds[k]);
+                    if (_mm256_movemask_ps(_mm256_cmp_ps(_mm256_and_ps(_mm256_sub_ps(partialSum, rangeCenter), absMask), threshold, _CMP_GT_OQ)) == 0xFF)
+                    {
+                        _mm256_storeu_ps(values, partialSum);
+                        return true;
+                    }
+                }
+            }
+
+            // Summed in the original order, like without a schedule
+            __m256 sum = initialValues;
+            for (int layer = 0; layer < numLayers; ++layer)
+            {
+                sum = _mm256_add_ps(sum, layerValues[layer]);
+            }
+            _mm256_storeu_ps(values, sum);
+            return false;
+        }
+
+#endif
+
+        /**
+         * Noise kernel and its name, selected once based on the CPU features
+         */
+        struct NoiseBatch
+        {
+            AddNoiseLayersFunc func;
+            const char* name;
+
+            NoiseBatch()
+                : func(&AddNoiseLayersScalar)
+                , name("Scalar")
+            {
+#ifdef MARCHING_CUBES_X86_SIMD
+                __builtin_cpu_init();
+                if (__builtin_cpu_supports("avx2"))
+                {
+                    func = &AddNoiseLayersInBlocks<8, &AddNoiseLayersAVX2Block>;
+                    name = "AVX2";
+                }
+                else if (__builtin_cpu_supports("sse4.1"))
+                {
+                    func = &AddNoiseLayersInBlocks<4, &AddNoiseLayersSSE41Block>;
+                    name = "SSE4.1";
+                }
+#endif
+            }
+        };
+
+        /**
+         * @brief Gets the noise kernel selected for this CPU
+         * @return Noise kernel
+         */
+        const NoiseBatch& GetNoiseBatch()
+        {
+            static NoiseBatch noiseBatch;
+            return noiseBatch;
+        }
+    }
+
+    /**
+     * @brief Adds several layers of 3D OpenSimplex2S noise to the values at a batch of points
+     * @param[in] layers Noise layers
+     * @param[in] numLayers Number of noise layers
+     * @param[in] xs X-values of the points
+     * @param[in] ys Y-values of the points
+     * @param[in] zs Z-values of the points
+     * @param[in,out] values Array of n values the noise is added to
+     * @param[in] n Number of points
+     */
+    void AddNoiseLayers(const NoiseLayer* layers, int numLayers, const float* xs, const float* ys, const float* zs, float* values, size_t n)
+    {
+        GetNoiseBatch().func(layers, numLayers, nullptr, xs, ys, zs, values, nullptr, n);
+    }
+
+    /**
+     * @brief Adds noise layers like AddNoiseLayers, but stops early at the points where the sign
+     * of the result is already known
+     * @param[in] layers Noise layers
+     * @param[in] numLayers Number of noise layers, at most maxBoundedNoiseLayers
+     * @param[in] xs X-values of the points
+     * @param[in] ys Y-values of the points
+     * @param[in] zs Z-values of the points
+     * @param[in,out] values Array of n values the noise is added to
+     * @param[out] outputIsSignOnly Array of n flags, set to 1 for the values that only have the right sign, 0 otherwise
+     * @param[in] n Number of points
+     * @param[in] minValue Lowest value the flagged results must be known to be above or below
+     * @param[in] maxValue Highest value the flagged results must be known to be above or below
+     */
+    void AddNoiseLayersBounded(const NoiseLayer* layers, int numLayers, const float* xs, const float* ys, const float* zs, float* values, unsigned char* outputIsSignOnly, size_t n, float minValue, float maxValue)
+    {
+        LayerSchedule schedule;
+        GetLayerSchedule(layers, numLayers, minValue, maxValue, schedule);
+        GetNoiseBatch().func(layers, numLayers, &schedule, xs, ys, zs, values, outputIsSignOnly, n);
+    }
+
+    /**
+     * @brief Gets the name of the instruction set used by AddNoiseLayers on this CPU
+     * @return Instruction set name
+     */
+    const char* GetNoiseBatchName()
+    {
+        return GetNoiseBatch().name;
+    }
+}
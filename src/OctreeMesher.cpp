@@ -0,0 +1,787 @@
+#include "OctreeMesher.hpp"
+
+#include "CellSurfaceTracer.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <unordered_map>
+#include <utility>
+
+namespace MarchingCubes
+{
+    /**
+     * @brief Constructor
+     * @param[in] numCells Number of smallest cells along each axis
+     * @param[in] errorThreshold Largest deviation of the function from the trilinear interpolation inside a leaf crossed by the surface
+     */
+    OctreeMesher::OctreeMesher(const glm::ivec3& numCells, float errorThreshold)
+        : m_numCells(numCells)
+        , m_errorThreshold(errorThreshold)
+        , m_nodes()
+        , m_pendingNodes()
+        , m_isRefined(false)
+        , m_requestedPoints()
+        , m_samples(static_cast<size_t>(numCells.x + 1 + 2 * apronSize) * (numCells.y + 1 + 2 * apronSize) * (numCells.z + 1 + 2 * apronSize))
+        , m_isSampled(m_samples.size(), false)
+        , m_numSamples(0)
+        , m_cellLeaves(static_cast<size_t>(numCells.x) * numCells.y * numCells.z, -1)
+    {
+        // The root is the smallest power of two covering all the cells
+        int rootSize = 1;
+        while ((rootSize < numCells.x) || (rootSize < numCells.y) || (rootSize < numCells.z))
+        {
+            rootSize *= 2;
+        }
+
+        Node root;
+        root.min = glm::ivec3(0);
+        root.size = rootSize;
+        root.firstChild = -1;
+        root.isOutside = false;
+        m_nodes.push_back(root);
+
+        AddNode(0);
+        RequestPoints();
+
+        // The samples on the bounds decide how the faces shared with the neighboring
+        // chunks are split, so they are all taken with the first nodes
+        for (int z = 0; z <= numCells.z; ++z)
+        {
+            for (int y = 0; y <= numCells.y; ++y)
+            {
+                const bool isOnBoundsYZ = (y == 0) || (y == numCells.y) || (z == 0) || (z == numCells.z);
+                for (int x = 0; x <= numCells.x; x += (isOnBoundsYZ ? 1 : numCells.x))
+                {
+                    RequestPoint(glm::ivec3(x, y, z));
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Gets the points where the function needs to be sampled to continue building the octree
+     * @return Points, in smallest cells. Empty once the octree is complete.
+     */
+    const std::vector<glm::ivec3>& OctreeMesher::GetRequestedPoints() const
+    {
+        return m_requestedPoints;
+    }
+
+    /**
+     * @brief Provides the samples at the requested points, and continues building the octree
+     * @param[in] values Samples, in the same order as the requested points
+     */
+    void OctreeMesher::AddSamples(const std::vector<float>& values)
+    {
+        for (size_t i = 0; i < m_requestedPoints.size(); ++i)
+        {
+            m_samples[GetPointIndex(m_requestedPoints[i])] = values[i];
+        }
+        m_requestedPoints.clear();
+
+        if (!m_isRefined)
+        {
+            std::vector<int> nodes;
+            nodes.swap(m_pendingNodes);
+            for (int nodeIndex : nodes)
+            {
+                // Nodes along the edges of the bounds may need samples past them first
+                if (RequestBoundsEdgePoints(m_nodes[nodeIndex]))
+                {
+                    m_pendingNodes.push_back(nodeIndex);
+                }
+                else if (NeedsSubdivision(m_nodes[nodeIndex]))
+                {
+                    Subdivide(nodeIndex);
+                }
+            }
+        }
+
+        RequestPoints();
+    }
+
+    /**
+     * @brief Polygonizes the leaves of the completed octree
+     * @param[in] origin Position of the first grid corner
+     * @param[in] cellSize Size of the smallest cells
+     * @param[out] outputVertices Vector where the vertex positions will be placed
+     * @param[out] outputIndices Vector where the triangle vertex indices will be placed
+     */
+    void OctreeMesher::Polygonize(const glm::vec3& origin, float cellSize, std::vector<glm::vec3>& outputVertices, std::vector<uint32_t>& outputIndices) const
+    {
+        const size_t firstVertex = outputVertices.size();
+        const float halfCellSize = cellSize * 0.5f;
+
+        // Points are addressed in half cells, so that the faces and edges of the
+        // smallest leaves can be split like those of any other leaf
+        auto GetValue = [&](const glm::ivec3& point) -> float
+        {
+            return GetSample(point / 2);
+        };
+
+        // Every edge intersection is created once and shared by the leaves around it
+        std::unordered_map<uint64_t, uint32_t> edgeVertices;
+        auto GetEdgeVertexIndex = [&](glm::ivec3 point0, glm::ivec3 point1) -> uint32_t
+        {
+            if ((point1.x < point0.x) || (point1.y < point0.y) || (point1.z < point0.z))
+            {
+                std::swap(point0, point1);
+            }
+
+            const glm::ivec3 edge = point1 - point0;
+            const uint64_t axis = (edge.y != 0) ? 1 : ((edge.z != 0) ? 2 : 0);
+            const uint64_t length = edge.x + edge.y + edge.z;
+            const uint64_t key = static_cast<uint64_t>(point0.x)
+                               | (static_cast<uint64_t>(point0.y) << 16)
+                               | (static_cast<uint64_t>(point0.z) << 32)
+                               | (axis << 48)
+                               | (length << 50);
+
+            std::unordered_map<uint64_t, uint32_t>::const_iterator it = edgeVertices.find(key);
+            if (it != edgeVertices.end())
+            {
+                return it->second;
+            }
+
+            const float value0 = GetValue(point0);
+            const float value1 = GetValue(point1);
+
+            // Linear interpolation to smoothen the resulting mesh
+            const float t = (0.0f - value0) / (value1 - value0);
+
+            // The corner positions are exact, like the sample positions, so the chunks sharing
+            // a face compute the same value from the same corner and offset along the edge
+            const glm::vec3 corner0 = origin + glm::vec3(point0) * halfCellSize;
+            const uint32_t vertexIndex = static_cast<uint32_t>(outputVertices.size() - firstVertex);
+            outputVertices.push_back(corner0 + (t * glm::vec3(edge)) * halfCellSize);
+
+            edgeVertices[key] = vertexIndex;
+            return vertexIndex;
+        };
+
+        // Is the cell inside a leaf smaller than the given size?
+        auto IsSmallerLeaf = [&](const glm::ivec3& cell, int size) -> bool
+        {
+            const int leafIndex = FindLeaf(cell);
+            return (leafIndex != -1) && (m_nodes[leafIndex].size < size);
+        };
+
+        CellSurfaceTracerBuffers tracerBuffers;
+        for (const Node& leaf : m_nodes)
+        {
+            if ((leaf.firstChild != -1) || leaf.isOutside)
+            {
+                continue;
+            }
+
+            // Skip the leaves not crossed by the surface, looking at every point sampled
+            // on them, which includes the points the polygons could use
+            const int step = std::max(leaf.size / 2, 1);
+            bool hasInside = false;
+            bool hasOutside = false;
+            for (int z = 0; z <= leaf.size; z += step)
+            {
+                for (int y = 0; y <= leaf.size; y += step)
+                {
+                    for (int x = 0; x <= leaf.size; x += step)
+                    {
+                        const size_t index = GetPointIndex(leaf.min + glm::ivec3(x, y, z));
+                        if (m_isSampled[index])
+                        {
+                            hasInside |= m_samples[index] > 0.0f;
+                            hasOutside |= m_samples[index] <= 0.0f;
+                        }
+                    }
+                }
+            }
+            if (!hasInside || !hasOutside)
+            {
+                continue;
+            }
+
+            // Faces are split if the leaves on the other side are smaller
+            int splitFaces = 0;
+            for (int face = 0; face < 6; ++face)
+            {
+                const int axis = face / 2;
+                glm::ivec3 neighborCell = leaf.min;
+                neighborCell[axis] += ((face & 1) != 0) ? leaf.size : -1;
+                if (IsSmallerLeaf(neighborCell, leaf.size))
+                {
+                    splitFaces |= 1 << face;
+                }
+            }
+
+            // Edge midpoints are used if any of the other leaves around the edge is smaller.
+            // With a balanced octree, checking the cells at the start of the edge is enough.
+            auto IsMidpointUsed = [&](const glm::ivec3& localPoint) -> bool
+            {
+                int edgeAxis = 0;
+                while (localPoint[edgeAxis] != 1)
+                {
+                    ++edgeAxis;
+                }
+                const int axisU = (edgeAxis + 1) % 3;
+                const int axisV = (edgeAxis + 2) % 3;
+
+                for (int i = 1; i < 4; ++i)
+                {
+                    glm::ivec3 cell = leaf.min;
+                    cell[axisU] += (localPoint[axisU] == 0) ? (((i & 1) != 0) ? -1 : 0) : (((i & 1) != 0) ? leaf.size : leaf.size - 1);
+                    cell[axisV] += (localPoint[axisV] == 0) ? (((i & 2) != 0) ? -1 : 0) : (((i & 2) != 0) ? leaf.size : leaf.size - 1);
+                    if (IsSmallerLeaf(cell, leaf.size))
+                    {
+                        return true;
+                    }
+                }
+                return false;
+            };
+
+            TraceCellSurface(leaf.min * 2, leaf.size, splitFaces, IsMidpointUsed, GetValue, GetEdgeVertexIndex, tracerBuffers, outputIndices);
+        }
+    }
+
+    /**
+     * @brief Gets the number of function samples taken
+     * @return Number of samples
+     */
+    size_t OctreeMesher::GetSampleCount() const
+    {
+        return m_numSamples;
+    }
+
+    /**
+     * @brief Classifies a new node, and queues it for refinement if needed
+     * @param[in] nodeIndex Node index
+     */
+    void OctreeMesher::AddNode(int nodeIndex)
+    {
+        const Node& node = m_nodes[nodeIndex];
+
+        // Nodes past the bounds are not polygonized
+        if ((node.min.x >= m_numCells.x) || (node.min.y >= m_numCells.y) || (node.min.z >= m_numCells.z))
+        {
+            m_nodes[nodeIndex].isOutside = true;
+            return;
+        }
+
+        // Nodes straddling the bounds are split right away, without sampling them
+        if ((node.min.x + node.size > m_numCells.x) || (node.min.y + node.size > m_numCells.y) || (node.min.z + node.size > m_numCells.z))
+        {
+            Subdivide(nodeIndex);
+            return;
+        }
+
+        // Every new node starts as the leaf of its cells
+        for (int z = node.min.z; z < node.min.z + node.size; ++z)
+        {
+            for (int y = node.min.y; y < node.min.y + node.size; ++y)
+            {
+                int* cellLeaves = &m_cellLeaves[node.min.x + (y + static_cast<size_t>(z) * m_numCells.y) * m_numCells.x];
+                std::fill(cellLeaves, cellLeaves + node.size, nodeIndex);
+            }
+        }
+
+        // The smallest cells are always leaves
+        if ((node.size > 1) && !m_isRefined)
+        {
+            m_pendingNodes.push_back(nodeIndex);
+        }
+    }
+
+    /**
+     * @brief Creates the 8 children of a node
+     * @param[in] nodeIndex Node index
+     */
+    void OctreeMesher::Subdivide(int nodeIndex)
+    {
+        const int firstChild = static_cast<int>(m_nodes.size());
+        const int childSize = m_nodes[nodeIndex].size / 2;
+        const glm::ivec3 min = m_nodes[nodeIndex].min;
+        m_nodes[nodeIndex].firstChild = firstChild;
+
+        for (int i = 0; i < 8; ++i)
+        {
+            Node child;
+            child.min = min + glm::ivec3(i & 1, (i >> 1) & 1, (i >> 2) & 1) * childSize;
+            child.size = childSize;
+            child.firstChild = -1;
+            child.isOutside = false;
+            m_nodes.push_back(child);
+        }
+
+        for (int i = 0; i < 8; ++i)
+        {
+            AddNode(firstChild + i);
+        }
+    }
+
+    /**
+     * @brief Decides whether a node needs to be subdivided, from its 27 samples
+     * @param[in] node Node
+     * @return True if the node needs to be subdivided
+     */
+    bool OctreeMesher::NeedsSubdivision(const Node& node) const
+    {
+        // The faces on the bounds are cut the same way as in the neighboring chunks
+        const BoundsFaceSplit boundsFaceSplit = GetBoundsFaceSplit(node);
+        if (boundsFaceSplit != BoundsFaceSplit::None)
+        {
+            return boundsFaceSplit == BoundsFaceSplit::Split;
+        }
+
+        const int halfSize = node.size / 2;
+
+        float samples[3][3][3];
+        bool hasInside = false;
+        bool hasOutside = false;
+        for (int z = 0; z < 3; ++z)
+        {
+            for (int y = 0; y < 3; ++y)
+            {
+                for (int x = 0; x < 3; ++x)
+                {
+                    const float value = GetSample(node.min + glm::ivec3(x, y, z) * halfSize);
+                    samples[z][y][x] = value;
+                    hasInside |= value > 0.0f;
+                    hasOutside |= value <= 0.0f;
+                }
+            }
+        }
+
+        // Not crossed by the surface, unless the function changes fast enough for
+        // the surface to pass between the samples. Every point of the node lies within
+        // sqrt(3) / 2 sample spacings of a sample, and the largest difference between
+        // neighboring samples is taken as twice the slope over a spacing, to be safe.
+        if (!hasInside || !hasOutside)
+        {
+            float minAbsValue = std::abs(samples[0][0][0]);
+            float maxDifference = 0.0f;
+            for (int z = 0; z < 3; ++z)
+            {
+                for (int y = 0; y < 3; ++y)
+                {
+                    for (int x = 0; x < 3; ++x)
+                    {
+                        minAbsValue = std::min(minAbsValue, std::abs(samples[z][y][x]));
+                        if (x < 2)
+                        {
+                            maxDifference = std::max(maxDifference, std::abs(samples[z][y][x + 1] - samples[z][y][x]));
+                        }
+                        if (y < 2)
+                        {
+                            maxDifference = std::max(maxDifference, std::abs(samples[z][y + 1][x] - samples[z][y][x]));
+                        }
+                        if (z < 2)
+                        {
+                            maxDifference = std::max(maxDifference, std::abs(samples[z + 1][y][x] - samples[z][y][x]));
+                        }
+                    }
+                }
+            }
+            return minAbsValue < 1.7320508f * maxDifference;
+        }
+
+        // Crossed by the surface, but not along the edges of the node
+        bool isCornerSignUniform = true;
+        for (int i = 1; i < 8; ++i)
+        {
+            isCornerSignUniform &= (samples[(i >> 2) * 2][((i >> 1) & 1) * 2][(i & 1) * 2] > 0.0f) == (samples[0][0][0] > 0.0f);
+        }
+        if (isCornerSignUniform)
+        {
+            return true;
+        }
+
+        // Too far from what the leaf would represent
+        for (int z = 0; z < 3; ++z)
+        {
+            for (int y = 0; y < 3; ++y)
+            {
+                for (int x = 0; x < 3; ++x)
+                {
+                    const float tx = x * 0.5f;
+                    const float ty = y * 0.5f;
+                    const float tz = z * 0.5f;
+                    const float c00 = samples[0][0][0] + tx * (samples[0][0][2] - samples[0][0][0]);
+                    const float c10 = samples[0][2][0] + tx * (samples[0][2][2] - samples[0][2][0]);
+                    const float c01 = samples[2][0][0] + tx * (samples[2][0][2] - samples[2][0][0]);
+                    const float c11 = samples[2][2][0] + tx * (samples[2][2][2] - samples[2][2][0]);
+                    const float c0 = c00 + ty * (c10 - c00);
+                    const float c1 = c01 + ty * (c11 - c01);
+                    const float interpolated = c0 + tz * (c1 - c0);
+                    if (std::abs(samples[z][y][x] - interpolated) > m_errorThreshold)
+                    {
+                        return true;
+                    }
+                }
+            }
+        }
+
+        return false;
+    }
+
+    /**
+     * @brief Decides how the faces of a node lying on the bounds split it, from the samples on the bounds alone
+     *
+     * The neighboring chunk takes the same decision for its node sharing the face, so both cut the parts
+     * of the face crossed by the surface the same way. Where a face is not crossed, every point on it has
+     * the same sign, and the leaves on either side can cut it differently without tracing anything on it.
+     * @param[in] node Node
+     * @return Constraint on the subdivision of the node
+     */
+    OctreeMesher::BoundsFaceSplit OctreeMesher::GetBoundsFaceSplit(const Node& node) const
+    {
+        BoundsSquare squares[maxBoundsSquares];
+        const int numSquares = GetBoundsSquares(node, squares);
+
+        bool isCrossed = false;
+        for (int i = 0; i < numSquares; ++i)
+        {
+            if (squares[i].isOnNode)
+            {
+                const BoundsFaceSplit squareSplit = GetBoundsSquareSplit(squares[i].axis, squares[i].min, node.size);
+                if (squareSplit == BoundsFaceSplit::Split)
+                {
+                    return BoundsFaceSplit::Split;
+                }
+                isCrossed |= squareSplit == BoundsFaceSplit::Leaf;
+            }
+        }
+        if (!isCrossed)
+        {
+            return BoundsFaceSplit::None;
+        }
+
+        // A leaf along an edge of the bounds is also shared with the chunks past that edge, which see
+        // other faces. They all decide from every square around the edge, so they agree with each other.
+        for (int i = 0; i < numSquares; ++i)
+        {
+            if (!squares[i].isOnNode && (GetBoundsSquareSplit(squares[i].axis, squares[i].min, node.size) == BoundsFaceSplit::Split))
+            {
+                return BoundsFaceSplit::Split;
+            }
+        }
+        return BoundsFaceSplit::Leaf;
+    }
+
+    /**
+     * @brief Decides how a square on the plane of a face of the bounds is split, from its samples alone
+     * @param[in] axis Axis normal to the plane
+     * @param[in] min Minimum corner of the square
+     * @param[in] size Size of the square
+     * @return Split if the square must be split, Leaf if it must not, None if it is not crossed by the surface
+     */
+    OctreeMesher::BoundsFaceSplit OctreeMesher::GetBoundsSquareSplit(int axis, const glm::ivec3& min, int size) const
+    {
+        const int axisU = (axis + 1) % 3;
+        const int axisV = (axis + 2) % 3;
+
+        glm::ivec3 point = min;
+        bool hasInside = false;
+        bool hasOutside = false;
+        for (int v = 0; v <= size; ++v)
+        {
+            for (int u = 0; u <= size; ++u)
+            {
+                point[axisU] = min[axisU] + u;
+                point[axisV] = min[axisV] + v;
+                const float value = GetSample(point);
+                hasInside |= value > 0.0f;
+                hasOutside |= value <= 0.0f;
+            }
+        }
+        if (!hasInside || !hasOutside)
+        {
+            return BoundsFaceSplit::None;
+        }
+
+        // Crossed squares end up with 2 cells at most. The chunk past the face only has squares of
+        // 2 cells on it if the number of cells along the axis is even.
+        if ((size > 2) || (m_numCells[axis] % 2 != 0))
+        {
+            return BoundsFaceSplit::Split;
+        }
+
+        // Crossed by the surface, but not along the edges of the square, or too far from what the leaf would trace
+        float corners[2][2];
+        for (int i = 0; i < 4; ++i)
+        {
+            point[axisU] = min[axisU] + (i & 1) * size;
+            point[axisV] = min[axisV] + (i >> 1) * size;
+            corners[i >> 1][i & 1] = GetSample(point);
+        }
+        if (((corners[0][0] > 0.0f) == (corners[0][1] > 0.0f)) && ((corners[0][0] > 0.0f) == (corners[1][0] > 0.0f)) && ((corners[0][0] > 0.0f) == (corners[1][1] > 0.0f)))
+        {
+            return BoundsFaceSplit::Split;
+        }
+
+        for (int v = 0; v <= size; ++v)
+        {
+            for (int u = 0; u <= size; ++u)
+            {
+                const float tu = static_cast<float>(u) / size;
+                const float tv = static_cast<float>(v) / size;
+                const float c0 = corners[0][0] + tu * (corners[0][1] - corners[0][0]);
+                const float c1 = corners[1][0] + tu * (corners[1][1] - corners[1][0]);
+                const float interpolated = c0 + tv * (c1 - c0);
+
+                point[axisU] = min[axisU] + u;
+                point[axisV] = min[axisV] + v;
+                if (std::abs(GetSample(point) - interpolated) > m_errorThreshold)
+                {
+                    return BoundsFaceSplit::Split;
+                }
+            }
+        }
+        return BoundsFaceSplit::Leaf;
+    }
+
+    /**
+     * @brief Lists the squares of a node on the faces of the bounds, and the squares next to them past
+     * the edges of the bounds, on the same planes
+     * @param[in] node Node
+     * @param[out] outputSquares Array where the squares will be placed, with room for maxBoundsSquares
+     * @return Number of squares
+     */
+    int OctreeMesher::GetBoundsSquares(const Node& node, BoundsSquare* outputSquares) const
+    {
+        int numSquares = 0;
+        for (int face = 0; face < 6; ++face)
+        {
+            const int axis = face / 2;
+            const int plane = ((face & 1) != 0) ? m_numCells[axis] : 0;
+            if (node.min[axis] + (((face & 1) != 0) ? node.size : 0) != plane)
+            {
+                continue;
+            }
+
+            // Offsets of the squares along the two other axes, past the bounds where the node touches them
+            int offsets[2][3];
+            int numOffsets[2];
+            for (int i = 0; i < 2; ++i)
+            {
+                const int otherAxis = (axis + 1 + i) % 3;
+                numOffsets[i] = 0;
+                offsets[i][numOffsets[i]++] = 0;
+                if (node.min[otherAxis] == 0)
+                {
+                    offsets[i][numOffsets[i]++] = -node.size;
+                }
+                if (node.min[otherAxis] + node.size == m_numCells[otherAxis])
+                {
+                    offsets[i][numOffsets[i]++] = node.size;
+                }
+            }
+
+            for (int v = 0; v < numOffsets[1]; ++v)
+            {
+                for (int u = 0; u < numOffsets[0]; ++u)
+                {
+                    BoundsSquare& square = outputSquares[numSquares++];
+                    square.axis = axis;
+                    square.min = node.min;
+                    square.min[axis] = plane;
+                    square.min[(axis + 1) % 3] += offsets[0][u];
+                    square.min[(axis + 2) % 3] += offsets[1][v];
+                    square.isOnNode = (u == 0) && (v == 0);
+                }
+            }
+        }
+        return numSquares;
+    }
+
+    /**
+     * @brief Requests the samples of the squares past the edges of the bounds that a node needs to decide
+     * how its faces on the bounds are split
+     * @param[in] node Node
+     * @return True if any point was requested
+     */
+    bool OctreeMesher::RequestBoundsEdgePoints(const Node& node)
+    {
+        // Only crossed faces of 2 cells can stay unsplit, and need the squares past the edges
+        if (node.size != 2)
+        {
+            return false;
+        }
+
+        BoundsSquare squares[maxBoundsSquares];
+        const int numSquares = GetBoundsSquares(node, squares);
+
+        bool isCrossed = false;
+        for (int i = 0; i < numSquares; ++i)
+        {
+            isCrossed |= squares[i].isOnNode && (GetBoundsSquareSplit(squares[i].axis, squares[i].min, node.size) == BoundsFaceSplit::Leaf);
+        }
+        if (!isCrossed)
+        {
+            return false;
+        }
+
+        const size_t numRequestedPoints = m_requestedPoints.size();
+        for (int i = 0; i < numSquares; ++i)
+        {
+            if (!squares[i].isOnNode)
+            {
+                const int axisU = (squares[i].axis + 1) % 3;
+                const int axisV = (squares[i].axis + 2) % 3;
+                for (int v = 0; v <= node.size; ++v)
+                {
+                    for (int u = 0; u <= node.size; ++u)
+                    {
+                        glm::ivec3 point = squares[i].min;
+                        point[axisU] += u;
+                        point[axisV] += v;
+                        RequestPoint(point);
+                    }
+                }
+            }
+        }
+        return m_requestedPoints.size() != numRequestedPoints;
+    }
+
+    /**
+     * @brief Requests the points needed by the pending nodes, and advances to the next stage when there are none
+     */
+    void OctreeMesher::RequestPoints()
+    {
+        if (!m_isRefined && m_pendingNodes.empty())
+        {
+            m_isRefined = true;
+            Balance();
+        }
+
+        if (!m_isRefined)
+        {
+            // The corners, edge midpoints, face centers and center of the nodes being refined
+            for (int nodeIndex : m_pendingNodes)
+            {
+                const Node& node = m_nodes[nodeIndex];
+                for (int i = 0; i < 27; ++i)
+                {
+                    RequestPoint(node.min + glm::ivec3(i % 3, (i / 3) % 3, i / 9) * (node.size / 2));
+                }
+            }
+        }
+        else
+        {
+            // The corners of the leaves
+            for (const Node& node : m_nodes)
+            {
+                if ((node.firstChild == -1) && !node.isOutside)
+                {
+                    for (int i = 0; i < 8; ++i)
+                    {
+                        RequestPoint(node.min + glm::ivec3(i & 1, (i >> 1) & 1, (i >> 2) & 1) * node.size);
+                    }
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Requests a point, unless it has already been sampled or requested
+     * @param[in] point Point, in smallest cells
+     */
+    void OctreeMesher::RequestPoint(const glm::ivec3& point)
+    {
+        const size_t index = GetPointIndex(point);
+        if (!m_isSampled[index])
+        {
+            m_isSampled[index] = true;
+            m_requestedPoints.push_back(point);
+            ++m_numSamples;
+        }
+    }
+
+    /**
+     * @brief Subdivides leaves until touching leaves differ by at most one level
+     */
+    void OctreeMesher::Balance()
+    {
+        std::vector<int> leaves;
+        for (int i = 0; i < static_cast<int>(m_nodes.size()); ++i)
+        {
+            if ((m_nodes[i].firstChild == -1) && !m_nodes[i].isOutside)
+            {
+                leaves.push_back(i);
+            }
+        }
+
+        while (!leaves.empty())
+        {
+            const int leafIndex = leaves.back();
+            leaves.pop_back();
+            if (m_nodes[leafIndex].firstChild != -1)
+            {
+                continue;
+            }
+
+            const glm::ivec3 min = m_nodes[leafIndex].min;
+            const int size = m_nodes[leafIndex].size;
+
+            // The cells just past every face, edge and corner of the leaf
+            for (int i = 0; i < 27; ++i)
+            {
+                const glm::ivec3 direction(i % 3 - 1, (i / 3) % 3 - 1, i / 9 - 1);
+                if (direction == glm::ivec3(0))
+                {
+                    continue;
+                }
+
+                glm::ivec3 cell;
+                for (int axis = 0; axis < 3; ++axis)
+                {
+                    cell[axis] = (direction[axis] < 0) ? min[axis] - 1 : ((direction[axis] > 0) ? min[axis] + size : min[axis]);
+                }
+
+                int neighborIndex = FindLeaf(cell);
+                while ((neighborIndex != -1) && (m_nodes[neighborIndex].size > size * 2))
+                {
+                    Subdivide(neighborIndex);
+                    for (int j = 0; j < 8; ++j)
+                    {
+                        leaves.push_back(m_nodes[neighborIndex].firstChild + j);
+                    }
+                    neighborIndex = FindLeaf(cell);
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Finds the leaf containing a smallest cell
+     * @param[in] cell Smallest cell
+     * @return Leaf index, or -1 if the cell is outside of the bounds
+     */
+    int OctreeMesher::FindLeaf(const glm::ivec3& cell) const
+    {
+        if ((cell.x < 0) || (cell.y < 0) || (cell.z < 0) || (cell.x >= m_numCells.x) || (cell.y >= m_numCells.y) || (cell.z >= m_numCells.z))
+        {
+            return -1;
+        }
+        return m_cellLeaves[cell.x + (cell.y + static_cast<size_t>(cell.z) * m_numCells.y) * m_numCells.x];
+    }
+
+    /**
+     * @brief Gets the sample at a point
+     * @param[in] point Point, in smallest cells
+     * @return Sample
+     */
+    float OctreeMesher::GetSample(const glm::ivec3& point) const
+    {
+        return m_samples[GetPointIndex(point)];
+    }
+
+    /**
+     * @brief Gets the index of a point in the sample lattice
+     * @param[in] point Point, in smallest cells
+     * @return Index
+     */
+    size_t OctreeMesher::GetPointIndex(const glm::ivec3& point) const
+    {
+        const size_t strideY = static_cast<size_t>(m_numCells.x) + 1 + 2 * apronSize;
+        const size_t strideZ = strideY * (m_numCells.y + 1 + 2 * apronSize);
+        return (point.x + apronSize) + (point.y + apronSize) * strideY + (point.z + apronSize) * strideZ;
+    }
+}
@@ -0,0 +1,216 @@
+#include "RawVolume.hpp"
+
+#include <cstring>
+#include <limits>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace MarchingCubes
+{
+    /**
+     * @brief Constructor
+     */
+    RawVolume::RawVolume()
+        : m_data(nullptr)
+        , m_size(0)
+        , m_releasedSize(0)
+        , m_header()
+    {
+    }
+
+    /**
+     * @brief Destructor
+     */
+    RawVolume::~RawVolume()
+    {
+        Close();
+    }
+
+    /**
+     * @brief Maps a raw volume file, and checks its header
+     * @param[in] path File path
+     * @return False if the file cannot be mapped, or is not a valid raw volume
+     */
+    bool RawVolume::Open(const std::string& path)
+    {
+        Close();
+
+        int file = open(path.c_str(), O_RDONLY);
+        if (file < 0)
+        {
+            return false;
+        }
+
+        struct stat fileStatus;
+        if ((fstat(file, &fileStatus) != 0) || (fileStatus.st_size < static_cast<off_t>(sizeof(RawVolumeHeader))))
+        {
+            close(file);
+            return false;
+        }
+
+        // The mapping stays valid once the file is closed
+        void* data = mmap(nullptr, static_cast<size_t>(fileStatus.st_size), PROT_READ, MAP_PRIVATE, file, 0);
+        close(file);
+        if (data == MAP_FAILED)
+        {
+            return false;
+        }
+
+        m_data = static_cast<unsigned char*>(data);
+        m_size = static_cast<size_t>(fileStatus.st_size);
+        m_releasedSize = 0;
+        std::memcpy(&m_header, m_data, sizeof(RawVolumeHeader));
+
+        // The dimensions are handed out as ints, and the size of the samples must not wrap around
+        const size_t sampleSize = GetSampleSize(GetSampleType());
+        size_t dataSize = sampleSize;
+        bool isSizeValid = (sampleSize != 0);
+        for (int i = 0; i < 3; ++i)
+        {
+            const size_t numSamples = m_header.numSamples[i];
+            if ((numSamples > static_cast<size_t>(std::numeric_limits<int>::max())) ||
+                ((numSamples != 0) && (dataSize > std::numeric_limits<size_t>::max() / numSamples)))
+            {
+                isSizeValid = false;
+                break;
+            }
+            dataSize *= numSamples;
+        }
+
+        if ((std::memcmp(m_header.magic, "RAWV", 4) != 0) || !isSizeValid || (m_size - sizeof(RawVolumeHeader) < dataSize))
+        {
+            Close();
+            return false;
+        }
+
+        // Slices are read front to back, so the system can read ahead
+        madvise(m_data, m_size, MADV_SEQUENTIAL);
+        return true;
+    }
+
+    /**
+     * @brief Unmaps the file
+     */
+    void RawVolume::Close()
+    {
+        if (m_data != nullptr)
+        {
+            munmap(m_data, m_size);
+            m_data = nullptr;
+            m_size = 0;
+        }
+    }
+
+    /**
+     * @brief Gets the number of samples along each axis
+     * @return Number of samples
+     */
+    glm::ivec3 RawVolume::GetNumSamples() const
+    {
+        return glm::ivec3(m_header.numSamples[0], m_header.numSamples[1], m_header.numSamples[2]);
+    }
+
+    /**
+     * @brief Gets the distance between two samples along each axis
+     * @return Sample spacing
+     */
+    glm::vec3 RawVolume::GetSpacing() const
+    {
+        return glm::vec3(m_header.spacing[0], m_header.spacing[1], m_header.spacing[2]);
+    }
+
+    /**
+     * @brief Gets the type of the samples
+     * @return Sample type
+     */
+    RawSampleType RawVolume::GetSampleType() const
+    {
+        return static_cast<RawSampleType>(m_header.sampleType);
+    }
+
+    /**
+     * @brief Reads a z-slice of samples, as a density function whose surface is at the isovalue
+     * @param[in] z Z-index of the slice
+     * @param[in] isovalue Sample value of the surface. Samples above it are inside.
+     * @param[out] outputValues Array where the numSamples.x * numSamples.y values will be placed, x varying fastest
+     */
+    void RawVolume::ReadSlice(int z, float isovalue, float* outputValues) const
+    {
+        const size_t sliceSize = static_cast<size_t>(m_header.numSamples[0]) * m_header.numSamples[1];
+        const size_t sampleSize = GetSampleSize(GetSampleType());
+        const unsigned char* slice = m_data + sizeof(RawVolumeHeader) + static_cast<size_t>(z) * sliceSize * sampleSize;
+
+        // memcpy compiles to plain loads, and keeps clear of the aliasing rules
+        switch (GetSampleType())
+        {
+            case RawSampleType::UInt8:
+                for (size_t i = 0; i < sliceSize; ++i)
+                {
+                    outputValues[i] = static_cast<float>(slice[i]) - isovalue;
+                }
+                break;
+
+            case RawSampleType::UInt16:
+                for (size_t i = 0; i < sliceSize; ++i)
+                {
+                    uint16_t value;
+                    std::memcpy(&value, slice + i * sizeof(uint16_t), sizeof(uint16_t));
+                    outputValues[i] = static_cast<float>(value) - isovalue;
+                }
+                break;
+
+            case RawSampleType::Float32:
+                for (size_t i = 0; i < sliceSize; ++i)
+                {
+                    float value;
+                    std::memcpy(&value, slice + i * sizeof(float), sizeof(float));
+                    outputValues[i] = value - isovalue;
+                }
+                break;
+        }
+    }
+
+    /**
+     * @brief Lets the system drop the pages of the slices before a z-slice from memory
+     * @param[in] z Z-index of the first slice still needed
+     */
+    void RawVolume::ReleaseSlicesBefore(int z)
+    {
+        const size_t sliceSize = static_cast<size_t>(m_header.numSamples[0]) * m_header.numSamples[1] * GetSampleSize(GetSampleType());
+        const size_t pageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+
+        // Only whole pages can be released, the one shared with the next slice stays
+        const size_t releasedSize = (sizeof(RawVolumeHeader) + static_cast<size_t>(z) * sliceSize) / pageSize * pageSize;
+        if (releasedSize > m_releasedSize)
+        {
+            madvise(m_data + m_releasedSize, releasedSize - m_releasedSize, MADV_DONTNEED);
+            m_releasedSize = releasedSize;
+        }
+    }
+
+    /**
+     * @brief Gets the size of a sample
+     * @param[in] sampleType Sample type
+     * @return Size in bytes, or 0 for unknown types
+     */
+    size_t RawVolume::GetSampleSize(RawSampleType sampleType)
+    {
+        switch (sampleType)
+        {
+            case RawSampleType::UInt8:
+                return sizeof(uint8_t);
+
+            case RawSampleType::UInt16:
+                return sizeof(uint16_t);
+
+            case RawSampleType::Float32:
+                return sizeof(float);
+
+            default:
+                return 0;
+        }
+    }
+}
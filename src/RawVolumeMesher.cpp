@@ -0,0 +1,141 @@
+#include "RawVolumeMesher.hpp"
+
+#include "CellClassifier.hpp"
+#include "MarchingCubes.hpp"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+namespace MarchingCubes
+{
+    /**
+     * @brief Gets the isosurface of a raw volume, one slab of cells at a time
+     * @param[in] volume Raw volume. The slices are released once meshed.
+     * @param[in] isovalue Sample value of the surface. Samples above it are inside.
+     * @param[in] writeTriangles Function receiving the triangles of every slab, in units of the sample spacing from the first sample
+     * @return Total number of triangles
+     */
+    size_t RawVolumeMesher::GetMesh(RawVolume& volume, float isovalue, const std::function<void(const std::vector<Triangle>&)>& writeTriangles)
+    {
+        const glm::ivec3 numSamples = volume.GetNumSamples();
+        if ((numSamples.x < 2) || (numSamples.y < 2) || (numSamples.z < 2))
+        {
+            return 0;
+        }
+
+        const glm::vec3 spacing = volume.GetSpacing();
+        const size_t sliceSize = static_cast<size_t>(numSamples.x) * numSamples.y;
+        const int numCellsX = numSamples.x - 1;
+
+        // Slices at the front and back of the current slab
+        std::vector<float> slices[2] = {std::vector<float>(sliceSize), std::vector<float>(sliceSize)};
+        volume.ReadSlice(0, isovalue, slices[0].data());
+
+        MarchingCubes& marchingCubes = MarchingCubes::GetInstance();
+        std::vector<unsigned char> rowCases(numCellsX);
+        std::vector<int> rowActiveCells(numCellsX);
+        std::vector<Triangle> triangles;
+        size_t numTriangles = 0;
+        for (int z = 0; z < numSamples.z - 1; ++z)
+        {
+            // Both slices are copies, so the file is not needed up to the back slice anymore
+            volume.ReadSlice(z + 1, isovalue, slices[1].data());
+            volume.ReleaseSlicesBefore(z + 2);
+
+            triangles.clear();
+            for (int y = 0; y < numSamples.y - 1; ++y)
+            {
+                // Same order as the corner bits of the case index. The offsets can exceed an int on large slices.
+                const size_t rowOffset = static_cast<size_t>(y) * numSamples.x;
+                const float* rows[4] =
+                {
+                    &slices[0][rowOffset],
+                    &slices[1][rowOffset],
+                    &slices[0][rowOffset + numSamples.x],
+                    &slices[1][rowOffset + numSamples.x]
+                };
+
+                const int numRowActiveCells = ClassifyCellRow(rows, numCellsX, rowCases.data(), rowActiveCells.data());
+                for (int i = 0; i < numRowActiveCells; ++i)
+                {
+                    const int x = rowActiveCells[i];
+
+                    // Corner bits: 1 = x, 2 = z, 4 = y
+                    float values[8];
+                    for (int j = 0; j < 8; ++j)
+                    {
+                        values[j] = rows[(j >> 1) & 3][x + (j & 1)];
+                    }
+
+                    Triangle cellTriangles[5];
+                    const int numCellTriangles = marchingCubes.PolygonizeCell(rowCases[x], values, glm::vec3(x, y, z), 1.0f, cellTriangles);
+                    for (int j = 0; j < numCellTriangles; ++j)
+                    {
+                        for (int k = 0; k < 3; ++k)
+                        {
+                            cellTriangles[j].vertices[k] *= spacing;
+                        }
+                        triangles.push_back(cellTriangles[j]);
+                    }
+                }
+            }
+
+            if (!triangles.empty())
+            {
+                writeTriangles(triangles);
+                numTriangles += triangles.size();
+            }
+            slices[0].swap(slices[1]);
+        }
+
+        return numTriangles;
+    }
+
+    /**
+     * @brief Writes the isosurface of a raw volume to a binary STL file, slab by slab
+     * @param[in] volume Raw volume. The slices are released once meshed.
+     * @param[in] isovalue Sample value of the surface. Samples above it are inside.
+     * @param[in] path Path of the STL file
+     * @return False if the file cannot be written
+     */
+    bool RawVolumeMesher::WriteStl(RawVolume& volume, float isovalue, const std::string& path)
+    {
+        FILE* file = std::fopen(path.c_str(), "wb");
+        if (file == nullptr)
+        {
+            return false;
+        }
+
+        // 80-byte header, then the triangle count, which is only known at the end
+        char header[80] = "Binary STL";
+        uint32_t numTriangles = 0;
+        bool isGood = (std::fwrite(header, sizeof(header), 1, file) == 1) && (std::fwrite(&numTriangles, sizeof(numTriangles), 1, file) == 1);
+
+        std::vector<unsigned char> records;
+        GetMesh(volume, isovalue, [&](const std::vector<Triangle>& triangles)
+        {
+            // 50-byte records: normal, 3 vertices, and an unused attribute. STL triangles are
+            // counter-clockwise seen from the outside, the opposite of the meshers.
+            const size_t recordSize = 50;
+            records.resize(triangles.size() * recordSize);
+            for (size_t i = 0; i < triangles.size(); ++i)
+            {
+                const glm::vec3* vertices = triangles[i].vertices;
+                const glm::vec3 normal = glm::cross(vertices[2] - vertices[0], vertices[1] - vertices[0]);
+                const float length = glm::length(normal);
+                const glm::vec3 values[4] = {(length > 0.0f) ? (normal / length) : glm::vec3(0.0f), vertices[0], vertices[2], vertices[1]};
+
+                unsigned char* record = &records[i * recordSize];
+                std::memcpy(record, values, sizeof(values));
+                std::memset(record + sizeof(values), 0, recordSize - sizeof(values));
+            }
+
+            isGood = isGood && (std::fwrite(records.data(), records.size(), 1, file) == 1);
+            numTriangles += static_cast<uint32_t>(triangles.size());
+        });
+
+        isGood = isGood && (std::fseek(file, sizeof(header), SEEK_SET) == 0) && (std::fwrite(&numTriangles, sizeof(numTriangles), 1, file) == 1);
+        return (std::fclose(file) == 0) && isGood;
+    }
+}
@@ -0,0 +1,161 @@
+#include "SurfaceNets.hpp"
+
+#include <utility>
+
+namespace MarchingCubes
+{
+    /**
+     * @brief Extracts the isosurface from an already sampled lattice
+     * @param[in] lattice Sampled lattice of numCells + 1 cells, starting one cell before the bounds, x varying fastest
+     * @param[in] origin Position of the first grid corner of the lattice
+     * @param[in] cellSize Cell size
+     * @param[in] numCells Number of cells of the bounds along each axis
+     * @param[out] outputVertices Vector where the vertex positions will be placed
+     * @param[out] outputIndices Vector where the triangle vertex indices will be placed
+     */
+    void SurfaceNets::Polygonize(const std::vector<float>& lattice, const glm::vec3& origin, float cellSize, const glm::ivec3& numCells, std::vector<glm::vec3>& outputVertices, std::vector<uint32_t>& outputIndices)
+    {
+        // Corners of the 12 cell edges, with corner bits 1 = x, 2 = y, 4 = z
+        static const int edgeCorners[12][2] =
+        {
+            { 0, 1 }, { 2, 3 }, { 4, 5 }, { 6, 7 },
+            { 0, 2 }, { 1, 3 }, { 4, 6 }, { 5, 7 },
+            { 0, 4 }, { 1, 5 }, { 2, 6 }, { 3, 7 }
+        };
+
+        const glm::ivec3 numLatticeCells = numCells + 1;
+        const size_t strideY = numLatticeCells.x + 1;
+        const size_t strideZ = strideY * (numLatticeCells.y + 1);
+        const size_t cornerOffsets[8] = { 0, 1, strideY, strideY + 1, strideZ, strideZ + 1, strideZ + strideY, strideZ + strideY + 1 };
+
+        const size_t firstVertex = outputVertices.size();
+
+        // Vertex of every lattice cell crossed by the surface
+        std::vector<uint32_t> cellVertices(static_cast<size_t>(numLatticeCells.x) * numLatticeCells.y * numLatticeCells.z);
+        for (int z = 0; z < numLatticeCells.z; ++z)
+        {
+            for (int y = 0; y < numLatticeCells.y; ++y)
+            {
+                for (int x = 0; x < numLatticeCells.x; ++x)
+                {
+                    const float* corner = &lattice[x + y * strideY + z * strideZ];
+                    float values[8];
+                    int caseIndex = 0;
+                    for (int i = 0; i < 8; ++i)
+                    {
+                        values[i] = corner[cornerOffsets[i]];
+                        caseIndex |= (values[i] > 0.0f ? 1 : 0) << i;
+                    }
+
+                    if ((caseIndex == 0) || (caseIndex == 255))
+                    {
+                        continue;
+                    }
+
+                    // Average of the edge intersections
+                    glm::vec3 vertex(0.0f);
+                    int numIntersections = 0;
+                    for (int i = 0; i < 12; ++i)
+                    {
+                        const int corner0 = edgeCorners[i][0];
+                        const int corner1 = edgeCorners[i][1];
+                        if (((caseIndex >> corner0) & 1) == ((caseIndex >> corner1) & 1))
+                        {
+                            continue;
+                        }
+
+                        // Linear interpolation to smoothen the resulting mesh
+                        const float t = (0.0f - values[corner0]) / (values[corner1] - values[corner0]);
+                        const glm::vec3 position0(corner0 & 1, (corner0 >> 1) & 1, (corner0 >> 2) & 1);
+                        const glm::vec3 position1(corner1 & 1, (corner1 >> 1) & 1, (corner1 >> 2) & 1);
+                        vertex += position0 + t * (position1 - position0);
+                        ++numIntersections;
+                    }
+
+                    cellVertices[x + (y + static_cast<size_t>(z) * numLatticeCells.y) * numLatticeCells.x] = static_cast<uint32_t>(outputVertices.size() - firstVertex);
+                    outputVertices.push_back(origin + (glm::vec3(x, y, z) + vertex / static_cast<float>(numIntersections)) * cellSize);
+                }
+            }
+        }
+
+        AddQuads(lattice, numCells, cellVertices, outputVertices, firstVertex, outputIndices);
+    }
+
+    /**
+     * @brief Connects the vertices of the cells around every intersected edge starting at a grid corner inside the bounds
+     * @param[in] lattice Sampled lattice of numCells + 1 cells, starting one cell before the bounds, x varying fastest
+     * @param[in] numCells Number of cells of the bounds along each axis
+     * @param[in] cellVertices Vertex index of every lattice cell crossed by the surface, relative to firstVertex, x varying fastest
+     * @param[in] vertices Vertex positions
+     * @param[in] firstVertex Index in vertices of the first vertex of the mesh
+     * @param[out] outputIndices Vector where the triangle vertex indices will be placed
+     */
+    void SurfaceNets::AddQuads(const std::vector<float>& lattice, const glm::ivec3& numCells, const std::vector<uint32_t>& cellVertices, const std::vector<glm::vec3>& vertices, size_t firstVertex, std::vector<uint32_t>& outputIndices)
+    {
+        const glm::ivec3 numLatticeCells = numCells + 1;
+        const size_t strideY = numLatticeCells.x + 1;
+        const size_t strideZ = strideY * (numLatticeCells.y + 1);
+
+        auto GetCellVertex = [&](const glm::ivec3& cell) -> uint32_t
+        {
+            return cellVertices[cell.x + (cell.y + static_cast<size_t>(cell.z) * numLatticeCells.y) * numLatticeCells.x];
+        };
+
+        // One quad for every intersected edge starting at a grid corner inside the bounds.
+        // Lattice points are offset by one from the grid corners, so the cells around
+        // the edges always exist.
+        for (int z = 1; z <= numCells.z; ++z)
+        {
+            for (int y = 1; y <= numCells.y; ++y)
+            {
+                for (int x = 1; x <= numCells.x; ++x)
+                {
+                    const glm::ivec3 point(x, y, z);
+                    const size_t pointIndex = x + y * strideY + z * strideZ;
+                    const bool isInside = lattice[pointIndex] > 0.0f;
+                    const size_t axisStrides[3] = { 1, strideY, strideZ };
+
+                    for (int axis = 0; axis < 3; ++axis)
+                    {
+                        if ((lattice[pointIndex + axisStrides[axis]] > 0.0f) == isInside)
+                        {
+                            continue;
+                        }
+
+                        glm::ivec3 axisU(0), axisV(0);
+                        axisU[(axis + 1) % 3] = 1;
+                        axisV[(axis + 2) % 3] = 1;
+
+                        // Cells around the edge, counterclockwise seen from the positive end of the axis
+                        uint32_t quad[4] =
+                        {
+                            GetCellVertex(point - axisU - axisV),
+                            GetCellVertex(point - axisV),
+                            GetCellVertex(point),
+                            GetCellVertex(point - axisU)
+                        };
+
+                        // Triangles are wound clockwise seen from outside, which is
+                        // towards the positive end of the edge if its start is inside
+                        if (isInside)
+                        {
+                            std::swap(quad[1], quad[3]);
+                        }
+
+                        // Split along the shorter diagonal to avoid slivers
+                        const glm::vec3 diagonal0 = vertices[firstVertex + quad[2]] - vertices[firstVertex + quad[0]];
+                        const glm::vec3 diagonal1 = vertices[firstVertex + quad[3]] - vertices[firstVertex + quad[1]];
+                        const int first = (glm::dot(diagonal0, diagonal0) <= glm::dot(diagonal1, diagonal1)) ? 0 : 1;
+
+                        outputIndices.push_back(quad[first]);
+                        outputIndices.push_back(quad[first + 1]);
+                        outputIndices.push_back(quad[first + 2]);
+                        outputIndices.push_back(quad[first]);
+                        outputIndices.push_back(quad[first + 2]);
+                        outputIndices.push_back(quad[(first + 3) % 4]);
+                    }
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,104 @@
+#include "MarchingCubes.hpp"
+#include "Terrain.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+/**
+ * The terrain without its sign-only evaluation and density bounds, so every grid corner is sampled exactly
+ */
+struct ExactTerrain
+{
+    Terrain& terrain;
+
+    float operator()(float x, float y, float z)
+    {
+        return terrain(x, y, z);
+    }
+
+    void GetLatticePart(const glm::vec3& origin, float cellSize, const glm::ivec3& numSamples, std::vector<float>& outputValues)
+    {
+        terrain.GetLatticePart(origin, cellSize, numSamples, outputValues);
+    }
+
+    void EvaluateBatch(const float* xs, const float* ys, const float* zs, float* out, size_t n)
+    {
+        terrain.EvaluateBatch(xs, ys, zs, out, n);
+    }
+
+    void EvaluateBatch(const float* xs, const float* ys, const float* zs, const float* latticePart, float* out, size_t n)
+    {
+        terrain.EvaluateBatch(xs, ys, zs, latticePart, out, n);
+    }
+};
+
+/**
+ * @brief Checks whether two float vectors hold the same bits
+ * @param[in] a First vector
+ * @param[in] b Second vector
+ * @return True if they are identical
+ */
+static bool IsSame(const std::vector<glm::vec3>& a, const std::vector<glm::vec3>& b)
+{
+    return (a.size() == b.size()) && (a.empty() || (std::memcmp(a.data(), b.data(), a.size() * sizeof(glm::vec3)) == 0));
+}
+
+/**
+ * Meshes terrain chunks with transition faces from sign-only samples and from exact samples,
+ * and fails unless both meshes are identical. Transition cells read grid corners that are
+ * not at the end of any crossed edge, so those must be sampled exactly too.
+ */
+int main()
+{
+    Terrain terrain;
+    ExactTerrain exactTerrain{terrain};
+    MarchingCubes::MarchingCubes& marchingCubes = MarchingCubes::MarchingCubes::GetInstance();
+
+    const int chunkNumCells = 16;
+    const float cellSizes[] = {4.0f, 8.0f};
+    int numFailures = 0;
+    for (float cellSize : cellSizes)
+    {
+        for (int z = 0; z < 6; ++z)
+        {
+            for (int y = -3; y < 3; ++y)
+            {
+                for (int x = 0; x < 6; ++x)
+                {
+                    AABB bounds;
+                    bounds.min = glm::vec3(x, y, z) * (chunkNumCells * cellSize) - glm::vec3(400.0f, 0.0f, 400.0f);
+                    bounds.max = bounds.min + glm::vec3(chunkNumCells * cellSize);
+                    const int transitionFaces = 1 + (x + 6 * z + 36 * (y + 3)) % 63;
+
+                    for (int hasNormals = 0; hasNormals < 2; ++hasNormals)
+                    {
+                        std::vector<glm::vec3> signOnlyVertices, signOnlyNormals, exactVertices, exactNormals;
+                        std::vector<uint32_t> signOnlyIndices, exactIndices;
+                        if (hasNormals != 0)
+                        {
+                            marchingCubes.GetIndexedMesh(terrain, bounds, cellSize, signOnlyVertices, signOnlyNormals, signOnlyIndices, transitionFaces);
+                            marchingCubes.GetIndexedMesh(exactTerrain, bounds, cellSize, exactVertices, exactNormals, exactIndices, transitionFaces);
+                        }
+                        else
+                        {
+                            marchingCubes.GetIndexedMesh(terrain, bounds, cellSize, signOnlyVertices, signOnlyIndices, transitionFaces);
+                            marchingCubes.GetIndexedMesh(exactTerrain, bounds, cellSize, exactVertices, exactIndices, transitionFaces);
+                        }
+
+                        if (!IsSame(signOnlyVertices, exactVertices) || !IsSame(signOnlyNormals, exactNormals) || (signOnlyIndices != exactIndices))
+                        {
+                            std::printf("Mismatch at chunk (%d, %d, %d), cell size %g, transition faces %d, %s normals\n",
+                                        x, y, z, cellSize, transitionFaces, (hasNormals != 0) ? "with" : "without");
+                            ++numFailures;
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    std::printf("%d mismatching meshes\n", numFailures);
+    return (numFailures == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}